@@ -1360,6 +1360,18 @@ CREATE TABLE `tw_houses_decorations` (
 
 -- --------------------------------------------------------
 
+--
+-- Table structure for table `tw_id_sequences`
+--
+
+CREATE TABLE `tw_id_sequences` (
+  `TableName` varchar(64) NOT NULL,
+  `NextID` int(11) NOT NULL DEFAULT 1,
+  PRIMARY KEY (`TableName`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_general_ci;
+
+-- --------------------------------------------------------
+
 --
 -- Table structure for table `tw_items_list`
 --
@@ -0,0 +1,49 @@
+#ifndef BENCHMARK_BENCHMARK_H
+#define BENCHMARK_BENCHMARK_H
+
+#include <cstdint>
+
+// runs Func Iterations times and prints time and allocations per iteration
+class CBenchmark
+{
+public:
+	using FBenchmark = void (*)();
+
+	CBenchmark(const char *pGroup, const char *pName, FBenchmark pfnRun);
+
+	static int RunAll(const char *pFilter);
+	static int64_t NumAllocations();
+
+	template<typename F>
+	static void Measure(const char *pCase, int Iterations, F &&Func)
+	{
+		const int64_t StartAllocations = NumAllocations();
+		const int64_t Start = Now();
+		for(int i = 0; i < Iterations; i++)
+			Func(i);
+		Report(pCase, Iterations, Now() - Start, NumAllocations() - StartAllocations);
+	}
+
+private:
+	static int64_t Now();
+	static void Report(const char *pCase, int Iterations, int64_t Nanoseconds, int64_t Allocations);
+
+	const char *m_pGroup;
+	const char *m_pName;
+	FBenchmark m_pfnRun;
+	CBenchmark *m_pNext;
+};
+
+#define BENCHMARK(Group, Name) \
+	static void Benchmark##Group##Name(); \
+	static CBenchmark gs_Benchmark##Group##Name(#Group, #Name, Benchmark##Group##Name); \
+	static void Benchmark##Group##Name()
+
+// keeps the optimizer from dropping benchmarked results
+template<typename T>
+inline void DoNotOptimize(const T &Value)
+{
+	asm volatile("" : : "r,m"(Value) : "memory");
+}
+
+#endif // BENCHMARK_BENCHMARK_H
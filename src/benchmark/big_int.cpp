@@ -0,0 +1,60 @@
+#include "benchmark.h"
+
+#include <base/big_int.h>
+#include <base/format.h>
+
+#include <vector>
+
+namespace
+{
+	constexpr int NUM_VALUES = 256;
+
+	// gold and experience sized values, from a few digits up to 30
+	std::vector<BigInt> Values()
+	{
+		std::vector<BigInt> vValues;
+		BigInt Value(7);
+		for(int i = 0; i < NUM_VALUES; i++)
+		{
+			vValues.push_back(Value);
+			Value = i % 30 == 29 ? BigInt(7 + i) : Value * 13 + i;
+		}
+		return vValues;
+	}
+}
+
+BENCHMARK(BigInt, Arithmetic)
+{
+	const auto vValues = Values();
+	CBenchmark::Measure("a + b", 1 << 16, [&](int i) {
+		DoNotOptimize(vValues[i % NUM_VALUES] + vValues[(i * 7) % NUM_VALUES]);
+	});
+	CBenchmark::Measure("a - b", 1 << 16, [&](int i) {
+		DoNotOptimize(vValues[i % NUM_VALUES] - vValues[(i * 7) % NUM_VALUES]);
+	});
+	CBenchmark::Measure("a * b", 1 << 14, [&](int i) {
+		DoNotOptimize(vValues[i % NUM_VALUES] * vValues[(i * 7) % NUM_VALUES]);
+	});
+	CBenchmark::Measure("a / 1000", 1 << 14, [&](int i) {
+		DoNotOptimize(vValues[i % NUM_VALUES] / 1000);
+	});
+	CBenchmark::Measure("a < b", 1 << 18, [&](int i) {
+		DoNotOptimize(vValues[i % NUM_VALUES] < vValues[(i * 7) % NUM_VALUES]);
+	});
+	CBenchmark::Measure("a += 1 (balance update)", 1 << 16, [&](int i) {
+		BigInt Value = vValues[i % NUM_VALUES];
+		Value += 1;
+		DoNotOptimize(Value);
+	});
+}
+
+BENCHMARK(BigInt, Format)
+{
+	const auto vValues = Values();
+	CBenchmark::Measure("to_string", 1 << 16, [&](int i) {
+		DoNotOptimize(vValues[i % NUM_VALUES].to_string());
+	});
+	CBenchmark::Measure("fmt_big_digit", 1 << 16, [&](int i) {
+		DoNotOptimize(fmt_big_digit(vValues[i % NUM_VALUES].to_string()));
+	});
+}
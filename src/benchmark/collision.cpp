@@ -0,0 +1,74 @@
+#include "benchmark.h"
+#include "synthetic_map.h"
+
+#include <vector>
+
+namespace
+{
+	constexpr int MAP_WIDTH = 500;
+	constexpr int MAP_HEIGHT = 300;
+	constexpr int NUM_RAYS = 4096;
+
+	struct CRay
+	{
+		vec2 m_From;
+		vec2 m_To;
+	};
+
+	std::vector<CRay> RandomRays(const CSyntheticWorld &World, float MaxLength, unsigned Seed)
+	{
+		std::vector<CRay> vRays;
+		vRays.reserve(NUM_RAYS);
+		unsigned State = Seed;
+		while((int)vRays.size() < NUM_RAYS)
+		{
+			const vec2 From = World.RandomFreePos(State);
+			const float Angle = (NextRandom(State) % 3600) * (pi / 1800.0f);
+			const float Length = 32.0f + (NextRandom(State) % 1000) / 1000.0f * (MaxLength - 32.0f);
+			vRays.push_back({From, From + direction(Angle) * Length});
+		}
+		return vRays;
+	}
+
+	void MeasureRays(const char *pCase, CCollision *pCollision, const std::vector<CRay> &vRays)
+	{
+		CBenchmark::Measure(pCase, NUM_RAYS * 64, [&](int i) {
+			const CRay &Ray = vRays[i % NUM_RAYS];
+			vec2 Collision, BeforeCollision;
+			DoNotOptimize(pCollision->IntersectLine(Ray.m_From, Ray.m_To, &Collision, &BeforeCollision));
+		});
+	}
+}
+
+BENCHMARK(Collision, IntersectLine)
+{
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 1);
+	MeasureRays("rays up to 400px, 500x300 map", World.Collision(), RandomRays(World, 400.0f, 2));
+	MeasureRays("rays up to 2000px, 500x300 map", World.Collision(), RandomRays(World, 2000.0f, 3));
+}
+
+BENCHMARK(Collision, SpecialTileSweep)
+{
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 1);
+	CCollision *pCollision = World.Collision();
+	const std::vector<CRay> vRays = RandomRays(World, 64.0f, 4);
+	CBenchmark::Measure("moves up to 64px, 500x300 map", NUM_RAYS * 64, [&](int i) {
+		const CRay &Ray = vRays[i % NUM_RAYS];
+		int Visited = 0;
+		pCollision->ForEachSpecialTile(Ray.m_From, Ray.m_To, [&Visited](int Index) {
+			Visited++;
+			return true;
+		});
+		DoNotOptimize(Visited);
+	});
+}
+
+BENCHMARK(Collision, CheckPoint)
+{
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 1);
+	CCollision *pCollision = World.Collision();
+	CBenchmark::Measure("random points, 500x300 map", 1 << 20, [&](int i) {
+		const unsigned Hash = (unsigned)i * 2654435761u;
+		DoNotOptimize(pCollision->CheckPoint((float)(Hash % (MAP_WIDTH * 32)), (float)((Hash >> 12) % (MAP_HEIGHT * 32))));
+	});
+}
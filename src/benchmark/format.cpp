@@ -0,0 +1,60 @@
+#include "benchmark.h"
+
+#include <base/big_int.h>
+#include <base/format.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+	// stands in for CServer::CallbackLocalize, a lookup per text and per string argument
+	std::unordered_map<std::string, std::string> gs_vTranslations;
+
+	std::string Translate(int ClientID, const char *pText, void *pUser)
+	{
+		const auto It = gs_vTranslations.find(pText);
+		return It != gs_vTranslations.end() ? It->second : pText;
+	}
+
+	void FillTranslations()
+	{
+		if(!gs_vTranslations.empty())
+			return;
+
+		for(int i = 0; i < 2000; i++)
+			gs_vTranslations.emplace("Unused message number " + std::to_string(i), "Translated message " + std::to_string(i));
+		gs_vTranslations.emplace("- {} dealt {} damage ({}%).", "- {} нанес {} урона ({}%).");
+		gs_vTranslations.emplace("You received {} gold, bank balance {$}.", "Вы получили {} золота, на счету {$}.");
+		gs_vTranslations.emplace("Wooden Sword", "Деревянный меч");
+	}
+}
+
+BENCHMARK(Format, Localize)
+{
+	FillTranslations();
+	CFormatter Formatter;
+	Formatter.init(&Translate, nullptr);
+	Formatter.use_flags(FMTFLAG_HANDLE_ARGS);
+
+	const BigInt Balance("1234567890123456789");
+	CBenchmark::Measure("text, name and two ints", 1 << 16, [&](int i) {
+		DoNotOptimize(Formatter("- {} dealt {} damage ({}%).", "Nickname", 1000 + i % 5000, i % 100));
+	});
+	CBenchmark::Measure("ints and big digit", 1 << 16, [&](int i) {
+		DoNotOptimize(Formatter("You received {} gold, bank balance {$}.", 100000 + i, Balance));
+	});
+	CBenchmark::Measure("translated string argument", 1 << 16, [&](int) {
+		DoNotOptimize(Formatter("You received {} gold, bank balance {$}.", "Wooden Sword", Balance));
+	});
+}
+
+BENCHMARK(Format, Default)
+{
+	CBenchmark::Measure("fmt_default, three arguments", 1 << 16, [&](int i) {
+		DoNotOptimize(fmt_default("WHERE WorldID = '{}' AND UserID = '{}' AND Name = '{}'", i % 40, i, "name"));
+	});
+	CBenchmark::Measure("fmt_digit", 1 << 16, [&](int i) {
+		DoNotOptimize(fmt_digit<int>(i * 1013));
+	});
+}
@@ -0,0 +1,70 @@
+#include "benchmark.h"
+
+#include <base/logger.h>
+#include <base/system.h>
+
+#include <atomic>
+
+static std::atomic<int64_t> gs_NumAllocations {0};
+static CBenchmark *gs_pFirstBenchmark = nullptr;
+
+#if defined(__GLIBC__)
+extern "C" void *__libc_malloc(size_t Size);
+
+// counts every heap allocation of the process, operator new ends up here as well
+extern "C" void *malloc(size_t Size)
+{
+	gs_NumAllocations.fetch_add(1, std::memory_order_relaxed);
+	return __libc_malloc(Size);
+}
+#endif
+
+CBenchmark::CBenchmark(const char *pGroup, const char *pName, FBenchmark pfnRun) :
+	m_pGroup(pGroup), m_pName(pName), m_pfnRun(pfnRun), m_pNext(gs_pFirstBenchmark)
+{
+	gs_pFirstBenchmark = this;
+}
+
+int64_t CBenchmark::NumAllocations()
+{
+	return gs_NumAllocations.load(std::memory_order_relaxed);
+}
+
+int64_t CBenchmark::Now()
+{
+	return time_get_nanoseconds().count();
+}
+
+void CBenchmark::Report(const char *pCase, int Iterations, int64_t Nanoseconds, int64_t Allocations)
+{
+	dbg_msg("benchmark", "  %-40s %10d iters %12.1f ns/op %10.3f allocs/op", pCase, Iterations,
+		(double)Nanoseconds / Iterations, (double)Allocations / Iterations);
+}
+
+int CBenchmark::RunAll(const char *pFilter)
+{
+	int Num = 0;
+	for(CBenchmark *pBenchmark = gs_pFirstBenchmark; pBenchmark; pBenchmark = pBenchmark->m_pNext)
+	{
+		char aName[128];
+		str_format(aName, sizeof(aName), "%s.%s", pBenchmark->m_pGroup, pBenchmark->m_pName);
+		if(pFilter && !str_find_nocase(aName, pFilter))
+			continue;
+
+		dbg_msg("benchmark", "%s", aName);
+		pBenchmark->m_pfnRun();
+		Num++;
+	}
+	return Num;
+}
+
+int main(int argc, const char **argv)
+{
+	CCmdlineFix CmdlineFix(&argc, &argv);
+	log_set_global_logger_default();
+
+	// optional substring filter, e.g. "benchmarks Snapshot"
+	const int Num = CBenchmark::RunAll(argc > 1 ? argv[1] : nullptr);
+	dbg_msg("benchmark", "%d benchmarks done", Num);
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include "benchmark.h"
+#include "synthetic_map.h"
+
+#include <engine/server/tick_profiler.h>
+#include <game/server/core/tools/path_finder.h>
+
+#include <vector>
+
+namespace
+{
+	constexpr int NUM_REQUESTS = 256;
+
+	struct CRoute
+	{
+		vec2 m_Start;
+		vec2 m_End;
+	};
+
+	std::vector<CRoute> RandomRoutes(const CSyntheticWorld &World, float MaxDistance, unsigned Seed)
+	{
+		std::vector<CRoute> vRoutes;
+		unsigned State = Seed;
+		while((int)vRoutes.size() < NUM_REQUESTS)
+		{
+			const vec2 Start = World.RandomFreePos(State);
+			const vec2 End = World.RandomFreePos(State);
+			if(distance(Start, End) <= MaxDistance)
+				vRoutes.push_back({Start, End});
+		}
+		return vRoutes;
+	}
+
+	// one request at a time, the time includes the handoff to the worker thread
+	void MeasureSingle(const char *pCase, CPathFinder *pPathFinder, const std::vector<CRoute> &vRoutes)
+	{
+		CBenchmark::Measure(pCase, NUM_REQUESTS, [&](int i) {
+			PathRequestHandle Handle;
+			pPathFinder->RequestPath(Handle, vRoutes[i].m_Start, vRoutes[i].m_End);
+			Handle.Future.wait();
+			DoNotOptimize(Handle.TryGetPath());
+		});
+	}
+}
+
+BENCHMARK(PathFinder, FindPath)
+{
+	CSyntheticWorld World(300, 200, 4);
+	CTickProfiler Profiler;
+	Profiler.AddWorld(0);
+	CPathFinder PathFinder(World.Collision(), &Profiler, 0);
+
+	MeasureSingle("near routes (<= 30 tiles), 300x200 map", &PathFinder, RandomRoutes(World, 30 * 32.0f, 5));
+	MeasureSingle("far routes (<= 150 tiles), 300x200 map", &PathFinder, RandomRoutes(World, 150 * 32.0f, 6));
+
+	// a full queue like many bots asking in the same tick
+	const auto vRoutes = RandomRoutes(World, 150 * 32.0f, 7);
+	std::vector<PathRequestHandle> vHandles(NUM_REQUESTS);
+	CBenchmark::Measure("far routes, 256 queued per batch", 4, [&](int) {
+		for(int i = 0; i < NUM_REQUESTS; i++)
+		{
+			vHandles[i].Reset();
+			PathFinder.RequestPath(vHandles[i], vRoutes[i].m_Start, vRoutes[i].m_End);
+		}
+		for(auto &Handle : vHandles)
+		{
+			Handle.Future.wait();
+			DoNotOptimize(Handle.TryGetPath());
+		}
+	});
+}
+
+BENCHMARK(PathFinder, FlowPath)
+{
+	CSyntheticWorld World(300, 200, 4);
+	CTickProfiler Profiler;
+	Profiler.AddWorld(0);
+	CPathFinder PathFinder(World.Collision(), &Profiler, 0);
+
+	// many players walking toward the same few quest targets
+	unsigned State = 8;
+	std::vector<vec2> vTargets;
+	for(int i = 0; i < 4; i++)
+		vTargets.push_back(World.RandomFreePos(State));
+
+	std::vector<CRoute> vRoutes;
+	for(int i = 0; i < NUM_REQUESTS; i++)
+		vRoutes.push_back({World.RandomFreePos(State), vTargets[i % vTargets.size()]});
+
+	CBenchmark::Measure("any routes to 4 fixed targets, 300x200 map", NUM_REQUESTS, [&](int i) {
+		PathRequestHandle Handle;
+		PathFinder.RequestFlowPath(Handle, vRoutes[i].m_Start, vRoutes[i].m_End);
+		Handle.Future.wait();
+		DoNotOptimize(Handle.TryGetPath());
+	});
+}
@@ -0,0 +1,85 @@
+#include "benchmark.h"
+
+#include <engine/shared/compression.h>
+#include <engine/shared/snapshot.h>
+#include <generated/protocol.h>
+
+namespace
+{
+	constexpr int NUM_CHARACTERS = 64;
+	constexpr int NUM_PROJECTILES = 128;
+	constexpr int NUM_PICKUPS = 256;
+
+	// a busy world, characters move every tick and projectiles come and go
+	int BuildSnapshot(CSnapshotBuilder &Builder, int Tick, void *pData)
+	{
+		Builder.Init();
+		for(int i = 0; i < NUM_CHARACTERS; i++)
+		{
+			auto *pInfo = static_cast<CNetObj_PlayerInfo *>(Builder.NewItem(NETOBJTYPE_PLAYERINFO, i, sizeof(CNetObj_PlayerInfo)));
+			pInfo->m_ClientId = i;
+			pInfo->m_Score = i * 10;
+			pInfo->m_Latency = 20 + i % 30;
+
+			auto *pChar = static_cast<CNetObj_Character *>(Builder.NewItem(NETOBJTYPE_CHARACTER, i, sizeof(CNetObj_Character)));
+			mem_zero(pChar, sizeof(*pChar));
+			pChar->m_Tick = Tick;
+			pChar->m_X = 1000 + i * 64 + Tick % 200;
+			pChar->m_Y = 800 + (i * 37 + Tick) % 100;
+			pChar->m_VelX = (Tick + i) % 256 - 128;
+			pChar->m_Health = 10;
+			pChar->m_Weapon = i % 5;
+		}
+		for(int i = 0; i < NUM_PROJECTILES; i++)
+		{
+			const int ID = NUM_CHARACTERS + (Tick / 5 + i) % (NUM_PROJECTILES * 2);
+			auto *pProj = static_cast<CNetObj_Projectile *>(Builder.NewItem(NETOBJTYPE_PROJECTILE, ID, sizeof(CNetObj_Projectile)));
+			mem_zero(pProj, sizeof(*pProj));
+			pProj->m_X = ID * 16;
+			pProj->m_Y = 500;
+			pProj->m_StartTick = Tick - i % 5;
+		}
+		for(int i = 0; i < NUM_PICKUPS; i++)
+		{
+			auto *pPickup = static_cast<CNetObj_Pickup *>(Builder.NewItem(NETOBJTYPE_PICKUP, 1000 + i, sizeof(CNetObj_Pickup)));
+			mem_zero(pPickup, sizeof(*pPickup));
+			pPickup->m_X = i * 48;
+			pPickup->m_Y = 300;
+		}
+		return Builder.Finish(pData);
+	}
+}
+
+BENCHMARK(Snapshot, CreateDelta)
+{
+	CNetObjHandler NetObjHandler;
+	CSnapshotDelta Delta;
+	for(int i = 0; i < NUM_NETOBJTYPES; i++)
+		Delta.SetStaticsize(i, NetObjHandler.GetObjSize(i));
+
+	static char s_aaData[2][CSnapshot::MAX_SIZE];
+	CSnapshotBuilder Builder;
+	BuildSnapshot(Builder, 100, s_aaData[0]);
+	BuildSnapshot(Builder, 110, s_aaData[1]);
+	const CSnapshot *pFrom = (CSnapshot *)s_aaData[0];
+	CSnapshot *pTo = (CSnapshot *)s_aaData[1];
+
+	static char s_aDeltaData[CSnapshot::MAX_SIZE];
+	CBenchmark::Measure("build 448 items", 4096, [&](int) {
+		DoNotOptimize(BuildSnapshot(Builder, 110, s_aaData[1]));
+	});
+
+	int DeltaSize = 0;
+	CBenchmark::Measure("delta 448 items, 10 ticks apart", 4096, [&](int) {
+		DeltaSize = Delta.CreateDelta(pFrom, pTo, s_aDeltaData);
+		DoNotOptimize(DeltaSize);
+	});
+	CBenchmark::Measure("delta 448 items, from empty", 4096, [&](int) {
+		DoNotOptimize(Delta.CreateDelta(CSnapshot::EmptySnapshot(), pTo, s_aDeltaData));
+	});
+
+	static char s_aCompData[CSnapshot::MAX_SIZE];
+	CBenchmark::Measure("CVariableInt::Compress of the delta", 4096, [&](int) {
+		DoNotOptimize(CVariableInt::Compress(s_aDeltaData, DeltaSize, s_aCompData, sizeof(s_aCompData)));
+	});
+}
@@ -0,0 +1,114 @@
+#include "benchmark.h"
+
+#include <base/system.h>
+#include <engine/shared/snapshot.h>
+
+#include <cstdlib>
+
+namespace
+{
+	constexpr int NUM_CLIENTS = 32;
+	constexpr int NUM_TICKS = 3000;
+	constexpr int HISTORY_TICKS = 150; // SERVER_TICK_SPEED * 3, see CServer::DoSnapshot
+	constexpr int ACK_DELAY = 10;
+
+	// previous storage layout, one malloc'd holder per snapshot in a linked list
+	class CListSnapshotStorage
+	{
+		struct CHolder
+		{
+			CHolder *m_pNext;
+			int64_t m_Tagtime;
+			int m_Tick;
+			int m_SnapSize;
+			CSnapshot *m_pSnap;
+		};
+
+		CHolder *m_pFirst = nullptr;
+		CHolder *m_pLast = nullptr;
+
+	public:
+		~CListSnapshotStorage() { PurgeUntil(0x7fffffff); }
+
+		void PurgeUntil(int Tick)
+		{
+			while(m_pFirst && m_pFirst->m_Tick < Tick)
+			{
+				CHolder *pNext = m_pFirst->m_pNext;
+				free(m_pFirst);
+				m_pFirst = pNext;
+			}
+			if(!m_pFirst)
+				m_pLast = nullptr;
+		}
+
+		void Add(int Tick, int64_t Tagtime, int DataSize, const void *pData)
+		{
+			CHolder *pHolder = (CHolder *)malloc(sizeof(CHolder) + DataSize);
+			pHolder->m_pNext = nullptr;
+			pHolder->m_Tagtime = Tagtime;
+			pHolder->m_Tick = Tick;
+			pHolder->m_SnapSize = DataSize;
+			pHolder->m_pSnap = (CSnapshot *)(pHolder + 1);
+			mem_copy(pHolder->m_pSnap, pData, DataSize);
+			if(m_pLast)
+				m_pLast->m_pNext = pHolder;
+			else
+				m_pFirst = pHolder;
+			m_pLast = pHolder;
+		}
+
+		int Get(int Tick, const CSnapshot **ppData) const
+		{
+			for(CHolder *pHolder = m_pFirst; pHolder; pHolder = pHolder->m_pNext)
+			{
+				if(pHolder->m_Tick == Tick)
+				{
+					*ppData = pHolder->m_pSnap;
+					return pHolder->m_SnapSize;
+				}
+			}
+			return -1;
+		}
+	};
+
+	char gs_aSnapData[CSnapshot::MAX_SIZE];
+
+	int SnapSize(int ClientID, int Tick)
+	{
+		return 1024 + ((ClientID * 131 + Tick * 17) % 3072);
+	}
+
+	// same order of operations as CServer::DoSnapshot for every client
+	template<typename TStorage>
+	void Simulate(const char *pCase, TStorage *pStorages)
+	{
+		CBenchmark::Measure(pCase, NUM_TICKS, [&](int Tick) {
+			for(int i = 0; i < NUM_CLIENTS; i++)
+			{
+				pStorages[i].PurgeUntil(Tick - HISTORY_TICKS);
+				pStorages[i].Add(Tick, Tick, SnapSize(i, Tick), gs_aSnapData, 0, nullptr);
+
+				const CSnapshot *pDeltashot = nullptr;
+				DoNotOptimize(pStorages[i].Get(Tick - ACK_DELAY, nullptr, &pDeltashot, nullptr));
+			}
+		});
+	}
+}
+
+BENCHMARK(SnapshotStorage, DoSnapshotWindow)
+{
+	struct CListAdapter : CListSnapshotStorage
+	{
+		void Add(int Tick, int64_t Tagtime, int DataSize, const void *pData, int, const void *) { CListSnapshotStorage::Add(Tick, Tagtime, DataSize, pData); }
+		int Get(int Tick, int64_t *, const CSnapshot **ppData, const CSnapshot **) const { return CListSnapshotStorage::Get(Tick, ppData); }
+	};
+
+	auto *pList = new CListAdapter[NUM_CLIENTS];
+	Simulate("linked list, 32 clients per tick", pList);
+	delete[] pList;
+
+	auto *pRing = new CSnapshotStorage[NUM_CLIENTS];
+	Simulate("ring buffer, 32 clients per tick", pRing);
+	delete[] pRing;
+}
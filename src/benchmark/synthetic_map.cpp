@@ -0,0 +1,161 @@
+#include "synthetic_map.h"
+
+CSyntheticMap::CSyntheticMap(int Width, int Height, unsigned Seed) :
+	m_Width(Width), m_vTiles((size_t)Width * Height)
+{
+	m_Group.m_Version = CMapItemGroup::CURRENT_VERSION;
+	m_Group.m_StartLayer = 0;
+	m_Group.m_NumLayers = 1;
+
+	m_Layer.m_Layer.m_Type = LAYERTYPE_TILES;
+	m_Layer.m_Version = CMapItemLayerTilemap::CURRENT_VERSION;
+	m_Layer.m_Width = Width;
+	m_Layer.m_Height = Height;
+	m_Layer.m_Flags = TILESLAYERFLAG_GAME;
+	m_Layer.m_Image = -1;
+	m_Layer.m_Data = DATA_TILES;
+	m_Layer.m_Tele = m_Layer.m_Speedup = m_Layer.m_Front = m_Layer.m_Switch = m_Layer.m_Tune = -1;
+
+	m_TeleLayer = m_Layer;
+	m_TeleLayer.m_Flags = TILESLAYERFLAG_TELE;
+	m_TeleLayer.m_Data = DATA_TELE_TILES;
+	m_TeleLayer.m_Tele = DATA_TELE;
+
+	const auto SetSolid = [&](int x, int y) { m_vTiles[(size_t)y * Width + x].m_Index = TILE_SOLID; };
+	for(int x = 0; x < Width; x++)
+	{
+		SetSolid(x, 0);
+		SetSolid(x, Height - 1);
+	}
+	for(int y = 0; y < Height; y++)
+	{
+		SetSolid(0, y);
+		SetSolid(Width - 1, y);
+	}
+
+	// one platform per 40 tiles, 3 to 24 tiles long, some of them are walls
+	unsigned State = Seed;
+	const int NumPlatforms = Width * Height / 40;
+	for(int i = 0; i < NumPlatforms; i++)
+	{
+		const int x = 1 + NextRandom(State) % (Width - 2);
+		const int y = 1 + NextRandom(State) % (Height - 2);
+		const int Length = 3 + NextRandom(State) % 22;
+		const bool Vertical = NextRandom(State) % 4 == 0;
+		for(int l = 0; l < Length; l++)
+		{
+			const int Tx = Vertical ? x : x + l;
+			const int Ty = Vertical ? y + l : y;
+			if(Tx < Width - 1 && Ty < Height - 1)
+				SetSolid(Tx, Ty);
+		}
+	}
+}
+
+void CSyntheticMap::SetTile(int x, int y, int Index)
+{
+	m_vTiles[(size_t)y * m_Width + x].m_Index = Index;
+}
+
+void CSyntheticMap::SetTele(int x, int y, int Type, int Number)
+{
+	if(!HasTele())
+	{
+		m_vTele.resize(m_vTiles.size());
+		m_vTeleTiles.resize(m_vTiles.size());
+		m_Group.m_NumLayers = 2;
+	}
+	m_vTele[(size_t)y * m_Width + x] = {(unsigned char)Number, (unsigned char)Type};
+}
+
+int CSyntheticMap::GetDataSize(int Index) const
+{
+	if(Index == DATA_TILES)
+		return (int)(m_vTiles.size() * sizeof(CTile));
+	if(Index == DATA_TELE)
+		return (int)(m_vTele.size() * sizeof(CTeleTile));
+	if(Index == DATA_TELE_TILES)
+		return (int)(m_vTeleTiles.size() * sizeof(CTile));
+	return 0;
+}
+
+void *CSyntheticMap::GetData(int Index)
+{
+	if(Index == DATA_TILES)
+		return m_vTiles.data();
+	if(Index == DATA_TELE && HasTele())
+		return m_vTele.data();
+	if(Index == DATA_TELE_TILES && HasTele())
+		return m_vTeleTiles.data();
+	return nullptr;
+}
+
+int CSyntheticMap::GetItemSize(int Index)
+{
+	if(Index == 0)
+		return sizeof(m_Group);
+	if(Index == 1)
+		return sizeof(m_Layer);
+	if(Index == 2 && HasTele())
+		return sizeof(m_TeleLayer);
+	return 0;
+}
+
+void *CSyntheticMap::GetItem(int Index, int *pType, int *pID)
+{
+	if(pID)
+		*pID = 0;
+	if(Index == 0)
+	{
+		if(pType)
+			*pType = MAPITEMTYPE_GROUP;
+		return &m_Group;
+	}
+	if(Index == 1)
+	{
+		if(pType)
+			*pType = MAPITEMTYPE_LAYER;
+		return &m_Layer;
+	}
+	if(Index == 2 && HasTele())
+	{
+		if(pType)
+			*pType = MAPITEMTYPE_LAYER;
+		return &m_TeleLayer;
+	}
+	return nullptr;
+}
+
+void CSyntheticMap::GetType(int Type, int *pStart, int *pNum)
+{
+	*pStart = 0;
+	*pNum = 0;
+	if(Type == MAPITEMTYPE_GROUP)
+		*pNum = 1;
+	else if(Type == MAPITEMTYPE_LAYER)
+	{
+		*pStart = 1;
+		*pNum = HasTele() ? 2 : 1;
+	}
+}
+
+CSyntheticWorld::CSyntheticWorld(int Width, int Height, unsigned Seed, const std::function<void(CSyntheticMap &)> &Edit) :
+	m_pKernel(IKernel::Create()), m_Map(Width, Height, Seed)
+{
+	if(Edit)
+		Edit(m_Map);
+	m_pKernel->RegisterInterface(static_cast<IMap *>(&m_Map), false);
+	m_Collision.Init(m_pKernel.get(), 0);
+}
+
+vec2 CSyntheticWorld::RandomFreePos(unsigned &State) const
+{
+	while(true)
+	{
+		const int x = 1 + NextRandom(State) % (m_Collision.GetWidth() - 2);
+		const int y = 1 + NextRandom(State) % (m_Collision.GetHeight() - 2);
+		const vec2 Pos(x * 32.0f + 16.0f, y * 32.0f + 16.0f);
+		if(!m_Collision.CheckPoint(Pos))
+			return Pos;
+	}
+}
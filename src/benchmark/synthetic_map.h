@@ -0,0 +1,81 @@
+#ifndef BENCHMARK_SYNTHETIC_MAP_H
+#define BENCHMARK_SYNTHETIC_MAP_H
+
+#include <engine/kernel.h>
+#include <engine/map.h>
+#include <game/collision.h>
+#include <game/mapitems.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+// in-memory map with one game layer: solid borders and random platforms,
+// a tele layer is added once a tele tile is set
+class CSyntheticMap : public IMap
+{
+	enum
+	{
+		DATA_TILES = 0,
+		DATA_TELE,
+		DATA_TELE_TILES,
+		NUM_DATA,
+	};
+
+	int m_Width;
+	CMapItemGroup m_Group {};
+	CMapItemLayerTilemap m_Layer {};
+	CMapItemLayerTilemap m_TeleLayer {};
+	std::vector<CTile> m_vTiles;
+	std::vector<CTeleTile> m_vTele;
+	std::vector<CTile> m_vTeleTiles;
+
+	bool HasTele() const { return !m_vTele.empty(); }
+
+public:
+	CSyntheticMap(int Width, int Height, unsigned Seed);
+
+	// edits before the collision is initialized
+	void SetTile(int x, int y, int Index);
+	void SetTele(int x, int y, int Type, int Number);
+
+	int GetDataSize(int Index) const override;
+	void *GetData(int Index) override;
+	void *GetDataSwapped(int Index) override { return GetData(Index); }
+	const char *GetDataString(int Index) override { return nullptr; }
+	void UnloadData(int Index) override {}
+	int NumData() const override { return HasTele() ? NUM_DATA : 1; }
+
+	int GetItemSize(int Index) override;
+	void *GetItem(int Index, int *pType = nullptr, int *pID = nullptr) override;
+	void GetType(int Type, int *pStart, int *pNum) override;
+	int FindItemIndex(int Type, int ID) override { return -1; }
+	void *FindItem(int Type, int ID) override { return nullptr; }
+	int NumItems() const override { return HasTele() ? 3 : 2; }
+	bool ClaimTilePreparation() override { return true; }
+};
+
+// collision over a synthetic map, initialized the same way as a world
+class CSyntheticWorld
+{
+	std::unique_ptr<IKernel> m_pKernel;
+	CSyntheticMap m_Map;
+	CCollision m_Collision;
+
+public:
+	CSyntheticWorld(int Width, int Height, unsigned Seed, const std::function<void(CSyntheticMap &)> &Edit = nullptr);
+
+	CCollision *Collision() { return &m_Collision; }
+
+	// random position inside a free tile
+	vec2 RandomFreePos(unsigned &State) const;
+};
+
+// small deterministic generator, results stay comparable between runs and platforms
+inline unsigned NextRandom(unsigned &State)
+{
+	State = State * 1664525u + 1013904223u;
+	return State >> 8;
+}
+
+#endif // BENCHMARK_SYNTHETIC_MAP_H
@@ -28,6 +28,10 @@ public:
 	virtual int FindItemIndex(int Type, int ID) = 0;
 	virtual void *FindItem(int Type, int ID) = 0;
 	virtual int NumItems() const = 0;
+
+	// game code writes derived data into the tile layers (collision flags). A map shared by
+	// several worlds is prepared once, this returns true only for the first call after loading.
+	virtual bool ClaimTilePreparation() = 0;
 };
 
 class IEngineMap : public IMap
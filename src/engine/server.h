@@ -24,6 +24,7 @@ public:
 	virtual class IGameServer* GameServerPlayer(int ClientID) const = 0;
 	virtual class CLocalization* Localization() const = 0;
 	virtual class IInputEvents* Input() const = 0;
+	virtual class CTickProfiler* TickProfiler() = 0;
 
 	struct CClientInfo
 	{
@@ -192,9 +193,12 @@ public:
 	// Bots
 	virtual void InitClientBot(int ClientID) = 0;
 
-	// snapshots
-	virtual int SnapNewID() = 0;
-	virtual void SnapFreeID(int ID) = 0;
+	// snapshots, every world has its own item ids
+	virtual int SnapNewID(int WorldID) = 0;
+	virtual void SnapFreeID(int WorldID, int ID) = 0;
+	// Num consecutive ids starting at the returned one, freed together
+	virtual int SnapNewIDs(int WorldID, int Num) = 0;
+	virtual void SnapFreeIDs(int WorldID, int FirstID, int Num) = 0;
 	virtual void *SnapNewItem(int Type, int ID, int Size) = 0;
 	virtual void SnapSetStaticsize(int ItemType, int Size) = 0;
 
@@ -220,6 +224,7 @@ public:
 	virtual void UpdateAccountBase(int UID, std::string Nickname, int Rating) = 0;
 	virtual const char* GetAccountNickname(int AccountID) = 0;
 	virtual int GetAccountRank(int AccountID) = 0;
+	virtual void RecordClientLogin(int ClientID, int AccountID) = 0;
 
 	virtual void ExpireServerInfo() = 0;
 };
@@ -248,11 +253,14 @@ public:
 	virtual void OnClientDrop(int ClientID, const char *pReason) = 0;
 	virtual void OnClientDirectInput(int ClientID, void *pInput) = 0;
 	virtual void OnClientPredictedInput(int ClientID, void *pInput) = 0;
+	virtual bool IsClientMessageRecordable(int MsgID, CUnpacker *pUnpacker, int ClientID) = 0;
+	virtual void OnClientReplayLogin(int ClientID, int AccountID) = 0;
 
 	virtual void* GetLastInput(int ClientID) const = 0;
 	virtual bool IsClientCharacterExist(int ClientID) const = 0;
 	virtual bool IsClientReady(int ClientID) const = 0;
 	virtual bool IsClientPlayer(int ClientID) const = 0;
+	virtual bool IsHibernated() const = 0;
 	virtual bool PlayerExists(int ClientID) const = 0;
 
 	virtual const char *Version() const = 0;
@@ -0,0 +1,261 @@
+#include "input_record.h"
+
+#include <base/math.h>
+#include <engine/shared/compression.h>
+
+static const char s_aRecordMagic[] = "MRPGREC";
+static constexpr int s_RecordVersion = 1;
+
+void CInputRecorder::WriteInt(int Value)
+{
+	unsigned char aBuf[CVariableInt::MAX_BYTES_PACKED];
+	const unsigned char* pEnd = CVariableInt::Pack(aBuf, Value, sizeof(aBuf));
+	aio_write(m_pAio, aBuf, (unsigned)(pEnd - aBuf));
+}
+
+bool CInputRecorder::Start(IOHANDLE File, unsigned Seed, int TickSpeed)
+{
+	Stop();
+	if(!File)
+		return false;
+
+	m_pAio = aio_new(File);
+	m_LastTick = 0;
+	mem_zero(m_aaLastInput, sizeof(m_aaLastInput));
+
+	aio_write(m_pAio, s_aRecordMagic, sizeof(s_aRecordMagic));
+	WriteInt(s_RecordVersion);
+	WriteInt((int)Seed);
+	WriteInt(TickSpeed);
+	return true;
+}
+
+void CInputRecorder::Stop()
+{
+	if(!m_pAio)
+		return;
+
+	WriteType(InputRecordType::END);
+	aio_close(m_pAio);
+	aio_wait(m_pAio);
+	aio_free(m_pAio);
+	m_pAio = nullptr;
+}
+
+void CInputRecorder::RecordTick(int Tick)
+{
+	if(!m_pAio)
+		return;
+
+	WriteType(InputRecordType::TICK);
+	WriteInt(Tick - m_LastTick);
+	m_LastTick = Tick;
+}
+
+void CInputRecorder::RecordConnect(int ClientID)
+{
+	if(!m_pAio)
+		return;
+
+	// a new client starts from an empty input
+	mem_zero(m_aaLastInput[ClientID], sizeof(m_aaLastInput[ClientID]));
+	WriteType(InputRecordType::CONNECT);
+	WriteInt(ClientID);
+}
+
+void CInputRecorder::RecordReady(int ClientID)
+{
+	if(!m_pAio)
+		return;
+
+	WriteType(InputRecordType::READY);
+	WriteInt(ClientID);
+}
+
+void CInputRecorder::RecordEnter(int ClientID, int WorldID)
+{
+	if(!m_pAio)
+		return;
+
+	WriteType(InputRecordType::ENTER);
+	WriteInt(ClientID);
+	WriteInt(WorldID);
+}
+
+void CInputRecorder::RecordDrop(int ClientID)
+{
+	if(!m_pAio)
+		return;
+
+	WriteType(InputRecordType::DROP);
+	WriteInt(ClientID);
+}
+
+void CInputRecorder::RecordAuth(int ClientID, int AccountID)
+{
+	if(!m_pAio)
+		return;
+
+	WriteType(InputRecordType::AUTH);
+	WriteInt(ClientID);
+	WriteInt(AccountID);
+}
+
+void CInputRecorder::RecordInput(int ClientID, int IntendedTick, const int* pData, int Size)
+{
+	if(!m_pAio)
+		return;
+
+	Size = clamp(Size, 0, (int)MAX_INPUT_SIZE);
+	int* pLast = m_aaLastInput[ClientID];
+	int NumChanged = 0;
+	for(int i = 0; i < Size; i++)
+	{
+		if(pData[i] != pLast[i])
+			NumChanged++;
+	}
+
+	WriteType(InputRecordType::INPUT);
+	WriteInt(ClientID);
+	WriteInt(IntendedTick - m_LastTick);
+	WriteInt(Size);
+	WriteInt(NumChanged);
+	for(int i = 0; i < Size; i++)
+	{
+		if(pData[i] == pLast[i])
+			continue;
+
+		WriteInt(i);
+		WriteInt(pData[i]);
+		pLast[i] = pData[i];
+	}
+}
+
+void CInputRecorder::RecordMessage(int ClientID, const void* pData, int Size)
+{
+	if(!m_pAio || Size <= 0)
+		return;
+
+	WriteType(InputRecordType::MESSAGE);
+	WriteInt(ClientID);
+	WriteInt(Size);
+	aio_write(m_pAio, pData, Size);
+}
+
+int CInputReplay::ReadInt()
+{
+	int Value = 0;
+	const unsigned char* pNext = CVariableInt::Unpack(m_pCurrent, &Value, (int)(m_pEnd - m_pCurrent));
+	if(!pNext)
+	{
+		m_Error = true;
+		m_pCurrent = m_pEnd;
+		return 0;
+	}
+	m_pCurrent = pNext;
+	return Value;
+}
+
+bool CInputReplay::Load(const void* pData, unsigned DataSize)
+{
+	m_Error = false;
+	m_Tick = 0;
+	mem_zero(m_aaLastInput, sizeof(m_aaLastInput));
+	if(DataSize < sizeof(s_aRecordMagic) || mem_comp(pData, s_aRecordMagic, sizeof(s_aRecordMagic)) != 0)
+		return false;
+
+	const unsigned char* pBytes = static_cast<const unsigned char*>(pData);
+	m_vData.assign(pBytes, pBytes + DataSize);
+	m_pCurrent = m_vData.data() + sizeof(s_aRecordMagic);
+	m_pEnd = m_vData.data() + m_vData.size();
+
+	const int Version = ReadInt();
+	m_Seed = (unsigned)ReadInt();
+	m_TickSpeed = ReadInt();
+	return !m_Error && Version == s_RecordVersion && m_TickSpeed > 0;
+}
+
+bool CInputReplay::NextEvent(CEvent* pEvent)
+{
+	if(m_Error || m_pCurrent >= m_pEnd)
+		return false;
+
+	const int Type = ReadInt();
+	if(Type < 0 || Type > (int)InputRecordType::END)
+	{
+		m_Error = true;
+		return false;
+	}
+
+	pEvent->m_Type = (InputRecordType)Type;
+	if(pEvent->m_Type == InputRecordType::END)
+		return false;
+
+	if(pEvent->m_Type == InputRecordType::TICK)
+	{
+		m_Tick += ReadInt();
+		pEvent->m_Tick = m_Tick;
+		return !m_Error;
+	}
+
+	pEvent->m_Tick = m_Tick;
+	pEvent->m_ClientID = ReadInt();
+	if(pEvent->m_ClientID < 0 || pEvent->m_ClientID >= MAX_CLIENTS)
+	{
+		m_Error = true;
+		return false;
+	}
+
+	switch(pEvent->m_Type)
+	{
+		case InputRecordType::CONNECT:
+			mem_zero(m_aaLastInput[pEvent->m_ClientID], sizeof(m_aaLastInput[pEvent->m_ClientID]));
+			break;
+		case InputRecordType::ENTER:
+		case InputRecordType::AUTH:
+			pEvent->m_Value = ReadInt();
+			break;
+		case InputRecordType::INPUT:
+		{
+			pEvent->m_Value = m_Tick + ReadInt();
+			pEvent->m_InputSize = ReadInt();
+			const int NumChanged = ReadInt();
+			if(pEvent->m_InputSize < 0 || pEvent->m_InputSize > MAX_INPUT_SIZE || NumChanged < 0 || NumChanged > pEvent->m_InputSize)
+			{
+				m_Error = true;
+				return false;
+			}
+
+			int* pLast = m_aaLastInput[pEvent->m_ClientID];
+			for(int i = 0; i < NumChanged; i++)
+			{
+				const int Index = ReadInt();
+				const int Value = ReadInt();
+				if(Index < 0 || Index >= pEvent->m_InputSize)
+				{
+					m_Error = true;
+					return false;
+				}
+				pLast[Index] = Value;
+			}
+			mem_copy(pEvent->m_aInput, pLast, sizeof(pEvent->m_aInput));
+			break;
+		}
+		case InputRecordType::MESSAGE:
+		{
+			// points into the loaded stream, valid until the next load
+			pEvent->m_MessageSize = ReadInt();
+			if(pEvent->m_MessageSize <= 0 || pEvent->m_MessageSize > m_pEnd - m_pCurrent)
+			{
+				m_Error = true;
+				return false;
+			}
+			pEvent->m_pMessage = m_pCurrent;
+			m_pCurrent += pEvent->m_MessageSize;
+			break;
+		}
+		default:
+			break;
+	}
+	return !m_Error;
+}
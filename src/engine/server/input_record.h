@@ -0,0 +1,92 @@
+#ifndef ENGINE_SERVER_INPUT_RECORD_H
+#define ENGINE_SERVER_INPUT_RECORD_H
+
+#include <base/system.h>
+#include <engine/shared/protocol.h>
+
+#include <vector>
+
+/*
+ * Compact stream of everything that reaches the game from the network and can't be
+ * reproduced otherwise: client connects, world enters, logins, inputs, game messages
+ * and the RNG seed. All numbers are packed as variable ints, inputs are stored as
+ * the changed fields against the previous input of the same client.
+ */
+enum class InputRecordType
+{
+	TICK = 0, // tick delta
+	CONNECT, // client id
+	READY, // client id
+	ENTER, // client id, world id
+	DROP, // client id
+	AUTH, // client id, account id
+	INPUT, // client id, intended tick delta, size, changed fields (index, value)
+	MESSAGE, // client id, size, raw packet
+	END,
+};
+
+class CInputRecorder
+{
+	ASYNCIO* m_pAio {};
+	int m_LastTick {};
+	int m_aaLastInput[MAX_CLIENTS][MAX_INPUT_SIZE] {};
+
+	void WriteInt(int Value);
+	void WriteType(InputRecordType Type) { WriteInt((int)Type); }
+
+public:
+	~CInputRecorder() { Stop(); }
+
+	bool Start(IOHANDLE File, unsigned Seed, int TickSpeed);
+	void Stop();
+	bool IsRecording() const { return m_pAio != nullptr; }
+
+	void RecordTick(int Tick);
+	void RecordConnect(int ClientID);
+	void RecordReady(int ClientID);
+	void RecordEnter(int ClientID, int WorldID);
+	void RecordDrop(int ClientID);
+	void RecordAuth(int ClientID, int AccountID);
+	void RecordInput(int ClientID, int IntendedTick, const int* pData, int Size);
+	void RecordMessage(int ClientID, const void* pData, int Size);
+};
+
+class CInputReplay
+{
+public:
+	struct CEvent
+	{
+		InputRecordType m_Type {};
+		int m_Tick {};
+		int m_ClientID {};
+		int m_Value {}; // world id, account id or intended tick
+		int m_InputSize {};
+		int m_aInput[MAX_INPUT_SIZE] {};
+		const void* m_pMessage {};
+		int m_MessageSize {};
+	};
+
+private:
+	std::vector<unsigned char> m_vData {};
+	const unsigned char* m_pCurrent {};
+	const unsigned char* m_pEnd {};
+	unsigned m_Seed {};
+	int m_TickSpeed {};
+	int m_Tick {};
+	int m_aaLastInput[MAX_CLIENTS][MAX_INPUT_SIZE] {};
+	bool m_Error {};
+
+	int ReadInt();
+
+public:
+	bool Load(const void* pData, unsigned DataSize);
+
+	unsigned Seed() const { return m_Seed; }
+	int TickSpeed() const { return m_TickSpeed; }
+	bool Error() const { return m_Error; }
+
+	// returns false at the end of the stream or on a broken stream
+	bool NextEvent(CEvent* pEvent);
+};
+
+#endif // ENGINE_SERVER_INPUT_RECORD_H
@@ -1,60 +1,73 @@
 #include "multi_worlds.h"
 
+#include <engine/engine.h>
 #include <engine/map.h>
 #include <engine/server.h>
 #include <engine/storage.h>
 #include <engine/shared/http.h>
+#include <engine/shared/jobs.h>
 
 #include <components/tunes/tune_zone_manager.h>
 
-CMapDetail::~CMapDetail()
+#include <future>
+
+CMapDetail::CData::~CData()
 {
 	Unload();
 	delete m_pMap;
 }
 
+void CMapDetail::CData::Unload()
+{
+	if(m_pMap && m_pMap->IsLoaded())
+	{
+		m_pMap->Unload();
+		m_FileSize = 0;
+		m_Crc = 0;
+		m_Sha256 = {};
+		free(m_pFileData);
+		m_pFileData = nullptr;
+	}
+}
+
 bool CMapDetail::Load(IStorageEngine* pStorage)
 {
-	char aBuf[IO_MAX_PATH_LENGTH];
-	str_format(aBuf, sizeof(aBuf), "maps/%s", m_pWorldDetail->GetPath());
-	const bool PrepareMap = !m_pWorldDetail->GetDetail()->HasFlag(WORLD_FLAG_NO_PREPARE_MAP);
-	const auto NewMapPath = PrepareMap ? CTuneZoneManager::GetInstance().BakePreparedMap(aBuf, pStorage) : std::nullopt;
-	if (NewMapPath.has_value())
-		str_copy(aBuf, NewMapPath->data());
+	// another world with the same map file has loaded it already
+	if(!m_pData->m_pMap->IsLoaded())
+	{
+		char aBuf[IO_MAX_PATH_LENGTH];
+		str_format(aBuf, sizeof(aBuf), "maps/%s", m_pWorldDetail->GetPath());
+		const bool PrepareMap = !m_pWorldDetail->GetDetail()->HasFlag(WORLD_FLAG_NO_PREPARE_MAP);
+		const auto NewMapPath = PrepareMap ? CTuneZoneManager::GetInstance().BakePreparedMap(aBuf, pStorage) : std::nullopt;
+		if (NewMapPath.has_value())
+			str_copy(aBuf, NewMapPath->data());
 
-	if(!m_pMap->Load(aBuf))
-		return false;
+		if(!m_pData->m_pMap->Load(aBuf))
+			return false;
 
-	// load complete map into memory for download
-	{
+		// load complete map into memory for download
 		void* pData;
-		pStorage->ReadFile(aBuf, IStorageEngine::TYPE_ALL, &pData, &m_aSize);
-		m_apData = (unsigned char*)pData;
-		m_aSha256 = m_pMap->Sha256();
-		m_aCrc = m_pMap->Crc();
-
-		char aSha256[SHA256_MAXSTRSIZE];
-		sha256_str(m_aSha256, aSha256, sizeof(aSha256));
-
-		char aEscaped[256];
-		str_format(aBuf, sizeof(aBuf), "%s_%s.map", m_pWorldDetail->GetName(), aSha256);
-		EscapeUrl(aEscaped, aBuf);
-		str_format(m_aMapDownloadUrl, sizeof(m_aMapDownloadUrl), "%s%s", g_Config.m_SvMapsBaseUrl, aEscaped);
+		pStorage->ReadFile(aBuf, IStorageEngine::TYPE_ALL, &pData, &m_pData->m_FileSize);
+		m_pData->m_pFileData = (unsigned char*)pData;
+		m_pData->m_Sha256 = m_pData->m_pMap->Sha256();
+		m_pData->m_Crc = m_pData->m_pMap->Crc();
 	}
 
+	char aSha256[SHA256_MAXSTRSIZE];
+	sha256_str(m_pData->m_Sha256, aSha256, sizeof(aSha256));
+
+	char aBuf[256];
+	char aEscaped[256];
+	str_format(aBuf, sizeof(aBuf), "%s_%s.map", m_pWorldDetail->GetName(), aSha256);
+	EscapeUrl(aEscaped, aBuf);
+	str_format(m_aMapDownloadUrl, sizeof(m_aMapDownloadUrl), "%s%s", g_Config.m_SvMapsBaseUrl, aEscaped);
 	return true;
 }
 
 void CMapDetail::Unload()
 {
-	if(m_pMap && m_pMap->IsLoaded())
-	{
-		m_pMap->Unload();
-		m_aSize = 0;
-		m_aCrc = 0;
-		m_aSha256 = {};
-		free(m_apData);
-	}
+	if(m_pData)
+		m_pData->Unload();
 }
 
 CWorld::~CWorld()
@@ -65,20 +78,29 @@ CWorld::~CWorld()
 
 bool CMultiWorlds::Init(CWorld* pNewWorld, IKernel* pKernel)
 {
+	// worlds built from the same map file share the loaded map, only doors and entities are per world
+	CMapDetail* pMapDetail = pNewWorld->m_pMapDetail;
+	if(auto pData = FindMapData(pNewWorld))
+		pMapDetail->m_pData = std::move(pData);
+	else if(!pMapDetail->m_pData || pMapDetail->IsShared())
+	{
+		pMapDetail->m_pData = std::make_shared<CMapDetail::CData>();
+		pMapDetail->m_pData->m_pMap = CreateEngineMap();
+	}
+
 	pNewWorld->m_pGameServer = CreateGameServer();
 
 	bool RegisterFail = false;
 	if(m_NextIsReloading) // reregister
 	{
-		RegisterFail = RegisterFail || !pKernel->ReregisterInterface(pNewWorld->m_pMapDetail->m_pMap, pNewWorld->m_ID);
-		RegisterFail = RegisterFail || !pKernel->ReregisterInterface(static_cast<IMap*>(pNewWorld->m_pMapDetail->m_pMap), pNewWorld->m_ID);
+		RegisterFail = RegisterFail || !pKernel->ReregisterInterface(pMapDetail->GetMap(), pNewWorld->m_ID);
+		RegisterFail = RegisterFail || !pKernel->ReregisterInterface(static_cast<IMap*>(pMapDetail->GetMap()), pNewWorld->m_ID);
 		RegisterFail = RegisterFail || !pKernel->ReregisterInterface(pNewWorld->m_pGameServer, pNewWorld->m_ID);
 	}
 	else // register
 	{
-		pNewWorld->m_pMapDetail->m_pMap = CreateEngineMap();
-		RegisterFail = RegisterFail || !pKernel->RegisterInterface(pNewWorld->m_pMapDetail->m_pMap, false, pNewWorld->m_ID);
-		RegisterFail = RegisterFail || !pKernel->RegisterInterface(static_cast<IMap*>(pNewWorld->m_pMapDetail->m_pMap), false, pNewWorld->m_ID);
+		RegisterFail = RegisterFail || !pKernel->RegisterInterface(pMapDetail->GetMap(), false, pNewWorld->m_ID);
+		RegisterFail = RegisterFail || !pKernel->RegisterInterface(static_cast<IMap*>(pMapDetail->GetMap()), false, pNewWorld->m_ID);
 		RegisterFail = RegisterFail || !pKernel->RegisterInterface(pNewWorld->m_pGameServer, false, pNewWorld->m_ID);
 	}
 
@@ -86,6 +108,88 @@ bool CMultiWorlds::Init(CWorld* pNewWorld, IKernel* pKernel)
 	return RegisterFail;
 }
 
+std::shared_ptr<CMapDetail::CData> CMultiWorlds::FindMapData(const CWorld* pWorld) const
+{
+	// only worlds already initialized in this pass are considered
+	const bool PrepareMap = !pWorld->m_Detail.HasFlag(WORLD_FLAG_NO_PREPARE_MAP);
+	for(const auto* pOther : m_apWorlds)
+	{
+		if(!pOther || pOther == pWorld || !pOther->m_pGameServer || !pOther->m_pMapDetail->m_pData)
+			continue;
+
+		if(str_comp(pOther->m_aPath, pWorld->m_aPath) == 0 && PrepareMap == !pOther->m_Detail.HasFlag(WORLD_FLAG_NO_PREPARE_MAP))
+			return pOther->m_pMapDetail->m_pData;
+	}
+	return nullptr;
+}
+
+namespace
+{
+	class CLoadMapJob : public IJob
+	{
+		CMapDetail* m_pMapDetail;
+		IStorageEngine* m_pStorage;
+		std::promise<bool> m_Result {};
+
+		void Run() override
+		{
+			m_Result.set_value(m_pMapDetail->Load(m_pStorage));
+		}
+
+	public:
+		CLoadMapJob(CMapDetail* pMapDetail, IStorageEngine* pStorage) : m_pMapDetail(pMapDetail), m_pStorage(pStorage) {}
+		std::future<bool> Result() { return m_Result.get_future(); }
+	};
+}
+
+int CMultiWorlds::LoadMaps(IEngine* pEngine, IStorageEngine* pStorage)
+{
+	// validate before any job is queued, a running job must never outlive a failed start
+	for(int i = 0; i < m_WasInitilized; i++)
+	{
+		if(!m_apWorlds[i] || !m_apWorlds[i]->m_pMapDetail || !m_apWorlds[i]->m_pMapDetail->m_pData)
+			return i;
+	}
+
+	// one job per map file, baking and reading are independent between files,
+	// every future is waited for before returning
+	std::vector<std::pair<int, std::future<bool>>> vJobs;
+	std::vector<std::shared_ptr<CMapDetail::CData>> vScheduled;
+	std::vector<int> vSiblings;
+	for(int i = 0; i < m_WasInitilized; i++)
+	{
+		CMapDetail* pMapDetail = m_apWorlds[i]->m_pMapDetail;
+		const bool Scheduled = std::find(vScheduled.begin(), vScheduled.end(), pMapDetail->m_pData) != vScheduled.end();
+		if(Scheduled || pMapDetail->m_pData->m_pMap->IsLoaded())
+		{
+			vSiblings.push_back(i);
+			continue;
+		}
+
+		auto pJob = std::make_shared<CLoadMapJob>(pMapDetail, pStorage);
+		vJobs.emplace_back(i, pJob->Result());
+		vScheduled.push_back(pMapDetail->m_pData);
+		pEngine->AddJob(std::move(pJob));
+	}
+
+	int Failed = -1;
+	for(auto& [WorldID, Result] : vJobs)
+	{
+		if(!Result.get() && Failed < 0)
+			Failed = WorldID;
+	}
+	if(Failed >= 0)
+		return Failed;
+
+	// the rest only build their download url from the shared data
+	for(int WorldID : vSiblings)
+	{
+		if(!m_apWorlds[WorldID]->m_pMapDetail->Load(pStorage))
+			return WorldID;
+	}
+	return -1;
+}
+
 bool CMultiWorlds::LoadFromDB(IKernel* pKernel, IStorageEngine* pStorage)
 {
 	CTuneZoneManager::GetInstance().LoadSoundsFromDirectory("server_data/sounds", pStorage);
@@ -3,6 +3,8 @@
 #include <base/hash.h>
 #include <engine/shared/world_detail.h>
 
+#include <memory>
+
 class IKernel;
 class IEngineMap;
 class IStorageEngine;
@@ -11,58 +13,67 @@ class CWorld;
 class CMapDetail
 {
 	friend class CMultiWorlds;
-	CWorld* m_pWorldDetail {};
 
-	IEngineMap* m_pMap{};
-	SHA256_DIGEST m_aSha256{};
-	unsigned m_aCrc{};
-	unsigned char* m_apData{};
-	unsigned int m_aSize{};
+	// loaded map file, shared by every world built from the same file
+	struct CData
+	{
+		IEngineMap* m_pMap {};
+		SHA256_DIGEST m_Sha256 {};
+		unsigned m_Crc {};
+		unsigned char* m_pFileData {};
+		unsigned int m_FileSize {};
+
+		~CData();
+		void Unload();
+	};
+
+	CWorld* m_pWorldDetail {};
+	std::shared_ptr<CData> m_pData {};
 	char m_aMapDownloadUrl[256];
 
 public:
 	CMapDetail(CWorld* pWorldDetail)
 	{
 		m_pWorldDetail = pWorldDetail;
-		m_pMap = nullptr;
-		m_aCrc = 0;
-		m_apData = nullptr;
-		m_aSize = 0;
 		m_aMapDownloadUrl[0] = '\0';
 	}
-	~CMapDetail();
 
 	bool Load(IStorageEngine* pStorage);
 	void Unload();
 
 	IEngineMap* GetMap() const
 	{
-		return m_pMap;
+		return m_pData ? m_pData->m_pMap : nullptr;
 	}
 
 	bool IsLoaded() const
 	{
-		return m_pMap != nullptr;
+		return GetMap() != nullptr;
+	}
+
+	bool IsShared() const
+	{
+		return m_pData.use_count() > 1;
 	}
 
 	unsigned GetCrc() const
 	{
-		return m_aCrc;
+		return m_pData->m_Crc;
 	}
 
 	const SHA256_DIGEST& GetSha256() const
 	{
-		return m_aSha256;
+		return m_pData->m_Sha256;
 	}
 
 	unsigned char* GetData() const
 	{
-		return m_apData;
+		return m_pData->m_pFileData;
 	}
 
 	unsigned int GetSize() const
 	{
-		return m_aSize;
+		return m_pData->m_FileSize;
 	}
 
 	const char* GetMapDownloadUrl() const
@@ -139,6 +150,9 @@ public:
 
 	bool LoadFromDB(IKernel* pKernel, IStorageEngine* pStorage);
 
+	// loads every distinct map file on the job pool, returns the first world that failed or -1
+	int LoadMaps(class IEngine* pEngine, IStorageEngine* pStorage);
+
 	CWorld* GetWorld(int WorldID) const
 	{
 		return m_apWorlds[WorldID];
@@ -157,6 +171,7 @@ public:
 
 private:
 	bool Init(CWorld* pNewWorld, IKernel* pKernel);
+	std::shared_ptr<CMapDetail::CData> FindMapData(const CWorld* pWorld) const;
 	void Clear(bool Shutdown = true);
 };
 
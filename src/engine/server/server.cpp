@@ -39,6 +39,7 @@
 #include "multi_worlds.h"
 #include "server_ban.h"
 #include "server_logger.h"
+#include "tick_histogram.h"
 #include "geo_ip.h"
 
 namespace
@@ -455,6 +456,23 @@ void CServer::SendLogLine(const CLogMessage* pMessage)
 	}
 }
 
+void CServer::SendTickProfileEcon()
+{
+	if(!g_Config.m_EcTickProfileInterval)
+		return;
+
+	const int64_t Now = time_get();
+	if(m_LastTickProfileEcon && Now < m_LastTickProfileEcon + time_freq() * g_Config.m_EcTickProfileInterval)
+		return;
+	m_LastTickProfileEcon = Now;
+
+	// only econ clients get these lines, the log stays clean
+	const auto fnSend = [this](const char* pLine) { m_Econ.Send(-1, pLine); };
+	m_TickProfiler.Format(CTickProfiler::WORLD_GLOBAL, fnSend);
+	for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
+		m_TickProfiler.Format(i, fnSend);
+}
+
 void CServer::SetRconCID(int ClientID)
 {
 	m_RconClientID = ClientID;
@@ -691,6 +709,10 @@ int CServer::SendMsg(CMsgPacker* pMsg, int Flags, int ClientID, int64_t Mask, in
 	if(!pMsg)
 		return -1;
 
+	// nobody is listening while replaying
+	if(m_Replaying)
+		return 0;
+
 	if(ClientID != -1 && (ClientID < 0 || ClientID >= MAX_PLAYERS || m_aClients[ClientID].m_State == CClient::STATE_EMPTY || m_aClients[ClientID].m_Quitting))
 		return 0;
 
@@ -779,15 +801,20 @@ void CServer::DoSnapshot(int WorldID)
 			continue;
 
 		{
-			m_SnapshotBuilder.Init();
-
-			GameServer(WorldID)->OnSnap(i);
-
-			// finish snapshot
 			char aData[CSnapshot::MAX_SIZE];
 			CSnapshot* pData = (CSnapshot*)aData; // Fix compiler warning for strict-aliasing
-			int SnapshotSize = m_SnapshotBuilder.Finish(pData);
+			int SnapshotSize;
+			{
+				CTickProfiler::CAccumulateScope Scope(&m_TickProfiler, WorldID, CTickProfiler::PHASE_SNAP_BUILD);
+				m_SnapshotBuilder.Init();
+
+				GameServer(WorldID)->OnSnap(i);
+
+				// finish snapshot
+				SnapshotSize = m_SnapshotBuilder.Finish(pData);
+			}
 			const unsigned Crc = pData->Crc();
+			CTickProfiler::CAccumulateScope SendScope(&m_TickProfiler, WorldID, CTickProfiler::PHASE_SNAP_SEND);
 
 			// remove old snapshots
 			// keep 3 seconds worth of snapshots
@@ -861,6 +888,7 @@ void CServer::DoSnapshot(int WorldID)
 		}
 	}
 	GameServer(WorldID)->OnPostSnap();
+	m_TickProfiler.Flush(WorldID);
 }
 
 
@@ -898,6 +926,7 @@ int CServer::NewClientNoAuthCallback(int ClientID, void* pUser)
 	pThis->m_aClients[ClientID].m_SpectatorID = SPEC_FREEVIEW;
 	pThis->m_aClients[ClientID].Reset();
 
+	pThis->m_InputRecorder.RecordConnect(ClientID);
 	pThis->SendCapabilities(ClientID);
 	pThis->SendMap(ClientID);
 	return 0;
@@ -947,6 +976,9 @@ int CServer::DelClientCallback(int ClientID, const char* pReason, void* pUser)
 	str_format(aBuf, sizeof(aBuf), "client dropped. cid=%d addr=%s reason='%s'", ClientID, aAddrStr, pReason);
 	pThis->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
 
+	if(pThis->m_aClients[ClientID].m_State != CClient::STATE_EMPTY)
+		pThis->m_InputRecorder.RecordDrop(ClientID);
+
 	// notify the mod about the drop
 	if(pThis->m_aClients[ClientID].m_State >= CClient::STATE_READY || pThis->IsClientChangingWorld(ClientID))
 	{
@@ -1214,6 +1246,7 @@ void CServer::ProcessClientPacket(CNetChunk* pPacket)
 				m_aClients[ClientID].m_Version = Unpacker.GetInt();
 				m_aClients[ClientID].m_State = CClient::STATE_CONNECTING;
 				GameServer(INITIALIZER_WORLD_ID)->OnClearClientData(ClientID);
+				m_InputRecorder.RecordConnect(ClientID);
 				SendCapabilities(ClientID);
 				SendMap(ClientID);
 			}
@@ -1245,6 +1278,7 @@ void CServer::ProcessClientPacket(CNetChunk* pPacket)
 		{
 			if((pPacket->m_Flags & NET_CHUNKFLAG_VITAL) != 0 && m_aClients[ClientID].m_State == CClient::STATE_CONNECTING)
 			{
+				m_InputRecorder.RecordReady(ClientID);
 				if(!m_aClients[ClientID].m_ChangeWorld)
 				{
 					char aAddrStr[NETADDR_MAXSTRSIZE];
@@ -1294,6 +1328,7 @@ void CServer::ProcessClientPacket(CNetChunk* pPacket)
 					Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "server", aBuf);
 				}
 
+				m_InputRecorder.RecordEnter(ClientID, WorldID);
 				m_aClients[ClientID].m_State = CClient::STATE_INGAME;
 				GameServer(WorldID)->OnClientEnter(ClientID, !m_aClients[ClientID].m_ChangeWorld);
 
@@ -1352,6 +1387,7 @@ void CServer::ProcessClientPacket(CNetChunk* pPacket)
 			if(Unpacker.Error())
 				return;
 
+			m_InputRecorder.RecordInput(ClientID, IntendedTick, currentInput.m_aData, InputSize);
 			mem_copy(client.m_LatestInput.m_aData, currentInput.m_aData, sizeof(client.m_LatestInput.m_aData));
 
 			client.m_CurrentInput = (client.m_CurrentInput + 1) % 200;
@@ -1503,6 +1539,8 @@ void CServer::ProcessClientPacket(CNetChunk* pPacket)
 		if((pPacket->m_Flags & NET_CHUNKFLAG_VITAL) != 0 && m_aClients[ClientID].m_State >= CClient::STATE_READY)
 		{
 			const int WorldID = m_aClients[ClientID].m_WorldID;
+			if(m_InputRecorder.IsRecording() && GameServer(WorldID)->IsClientMessageRecordable(MsgID, &Unpacker, ClientID))
+				m_InputRecorder.RecordMessage(ClientID, pPacket->m_pData, pPacket->m_DataSize);
 			GameServer(WorldID)->OnMessage(MsgID, &Unpacker, ClientID);
 		}
 	}
@@ -1510,6 +1548,7 @@ void CServer::ProcessClientPacket(CNetChunk* pPacket)
 
 void CServer::PumpNetwork(bool PacketWaiting)
 {
+	CTickProfiler::CScope Scope(&m_TickProfiler, CTickProfiler::WORLD_GLOBAL, CTickProfiler::PHASE_NET_RECV);
 	CNetChunk Packet;
 	SECURITY_TOKEN ResponseToken;
 
@@ -1562,6 +1601,286 @@ void CServer::PumpNetwork(bool PacketWaiting)
 	m_Econ.Update();
 }
 
+void CServer::ApplyClientInputs()
+{
+	for(int c = 0; c < MAX_PLAYERS; c++)
+	{
+		if(m_aClients[c].m_State == CClient::STATE_EMPTY)
+			continue;
+
+		for(auto& m_aInput : m_aClients[c].m_aInputs)
+		{
+			if(m_aInput.m_GameTick == Tick())
+			{
+				if(m_aClients[c].m_State == CClient::STATE_INGAME)
+				{
+					const int WorldID = m_aClients[c].m_WorldID;
+					GameServer(WorldID)->OnClientPredictedInput(c, m_aInput.m_aData);
+				}
+				break;
+			}
+		}
+	}
+}
+
+void CServer::UpdateGameTime()
+{
+	if(Tick() % TickSpeed() != 0)
+		return;
+
+	// update game typeday
+	if(m_GameTypeday != GetCurrentTypeday())
+	{
+		m_GameTypeday = GetCurrentTypeday();
+		for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
+		{
+			IGameServer* pGameServer = MultiWorlds()->GetWorld(i)->GameServer();
+			if(!MultiWorlds()->GetWorld(i)->GetDetail()->HasFlag(WORLD_FLAG_NO_DAYTIME))
+				pGameServer->OnDaytypeChange(m_GameTypeday);
+		}
+	}
+
+	// update game minute
+	m_GameMinuteTime++;
+	if(m_GameMinuteTime >= 60)
+	{
+		// update game hour
+		m_GameHourTime++;
+		if(m_GameHourTime >= 24)
+		{
+			m_GameHourTime = 0;
+			SetOffsetGameTime(0);
+		}
+
+		// reset game minute
+		m_GameMinuteTime = 0;
+	}
+}
+
+void CServer::StartInputRecord()
+{
+	if(g_Config.m_SvInputRecord[0] == '\0')
+		return;
+
+	IOHANDLE File = Storage()->OpenFile(g_Config.m_SvInputRecord, IOFLAG_WRITE, IStorageEngine::TYPE_SAVE);
+	if(!File)
+	{
+		log_error("server", "could not open input record file '%s'", g_Config.m_SvInputRecord);
+		return;
+	}
+
+	// the seed goes into the record, so the replay draws the same random numbers
+	unsigned Seed;
+	secure_random_fill(&Seed, sizeof(Seed));
+	srand(Seed);
+	m_InputRecorder.Start(File, Seed, TickSpeed());
+	log_info("server", "recording inputs to '%s'", g_Config.m_SvInputRecord);
+}
+
+void CServer::RunInputReplay()
+{
+	m_RunServer = STOPPING;
+
+	void* pData;
+	unsigned DataSize;
+	if(!Storage()->ReadFile(g_Config.m_SvInputReplay, IStorageEngine::TYPE_ALL, &pData, &DataSize))
+	{
+		log_error("replay", "could not read input record file '%s'", g_Config.m_SvInputReplay);
+		return;
+	}
+
+	CInputReplay Replay;
+	const bool Loaded = Replay.Load(pData, DataSize);
+	free(pData);
+	if(!Loaded)
+	{
+		log_error("replay", "'%s' is not a valid input record", g_Config.m_SvInputReplay);
+		return;
+	}
+	if(Replay.TickSpeed() != TickSpeed())
+		log_warn("replay", "recorded with tick speed %d, replaying with %d", Replay.TickSpeed(), TickSpeed());
+
+	srand(Replay.Seed());
+	log_info("replay", "replaying '%s'", g_Config.m_SvInputReplay);
+
+	const int NumWorlds = MultiWorlds()->GetSizeInitilized();
+	std::vector<CTickHistogram> vTickTimes(NumWorlds);
+	std::vector<CTickHistogram> vSnapTimes(NumWorlds);
+	CTickHistogram TotalTimes;
+	int NumTicks = 0;
+	int NumEvents = 0;
+	int NumMismatches = 0;
+	const auto StartTime = time_get_nanoseconds();
+
+	CInputReplay::CEvent Event;
+	while(Replay.NextEvent(&Event))
+	{
+		NumEvents++;
+		if(Event.m_Type == InputRecordType::TICK)
+		{
+			const auto TickStart = time_get_nanoseconds();
+			m_CurrentGameTick = Event.m_Tick;
+			ApplyClientInputs();
+			UpdateGameTime();
+
+			MultiWorlds()->GetWorld(INITIALIZER_WORLD_ID)->GameServer()->OnTickGlobal();
+			for(int i = 0; i < NumWorlds; i++)
+			{
+				const auto Start = time_get_nanoseconds();
+				MultiWorlds()->GetWorld(i)->GameServer()->OnTick();
+				vTickTimes[i].Add((time_get_nanoseconds() - Start).count());
+			}
+
+			if(g_Config.m_SvHighBandwidth || (m_CurrentGameTick % 2) == 0)
+			{
+				for(int i = 0; i < NumWorlds; i++)
+				{
+					if(GameServer(i)->IsHibernated())
+						continue;
+
+					const auto Start = time_get_nanoseconds();
+					DoSnapshot(i);
+					vSnapTimes[i].Add((time_get_nanoseconds() - Start).count());
+				}
+			}
+
+			m_pInputKeys->ResetInputKeys();
+			TotalTimes.Add((time_get_nanoseconds() - TickStart).count());
+			NumTicks++;
+			continue;
+		}
+
+		// every event is checked against the state the recording server had at that point
+		const int ClientID = Event.m_ClientID;
+		auto& Client = m_aClients[ClientID];
+		switch(Event.m_Type)
+		{
+			case InputRecordType::CONNECT:
+			{
+				if(Client.m_State != CClient::STATE_EMPTY)
+				{
+					NumMismatches++;
+					break;
+				}
+
+				NewClientCallback(ClientID, this);
+				Client.m_State = CClient::STATE_CONNECTING;
+				GameServer(INITIALIZER_WORLD_ID)->OnClearClientData(ClientID);
+				break;
+			}
+			case InputRecordType::READY:
+			{
+				if(Client.m_State != CClient::STATE_CONNECTING)
+				{
+					NumMismatches++;
+					break;
+				}
+
+				if(!Client.m_ChangeWorld)
+				{
+					for(int i = 0; i < NumWorlds; i++)
+						MultiWorlds()->GetWorld(i)->GameServer()->OnClientPrepareChangeWorld(ClientID);
+					GameServer(Client.m_WorldID)->OnClientConnected(ClientID);
+				}
+				Client.m_State = CClient::STATE_READY;
+				break;
+			}
+			case InputRecordType::ENTER:
+			{
+				const int WorldID = Client.m_WorldID;
+				if(Client.m_State != CClient::STATE_READY || WorldID != Event.m_Value || !GameServer(WorldID)->IsClientReady(ClientID))
+				{
+					NumMismatches++;
+					break;
+				}
+
+				Client.m_State = CClient::STATE_INGAME;
+				GameServer(WorldID)->OnClientEnter(ClientID, !Client.m_ChangeWorld);
+				break;
+			}
+			case InputRecordType::DROP:
+			{
+				if(Client.m_State != CClient::STATE_EMPTY)
+					m_NetServer.Drop(ClientID, "Replay drop");
+				break;
+			}
+			case InputRecordType::AUTH:
+			{
+				if(Client.m_State < CClient::STATE_READY)
+				{
+					NumMismatches++;
+					break;
+				}
+
+				GameServer(Client.m_WorldID)->OnClientReplayLogin(ClientID, Event.m_Value);
+				break;
+			}
+			case InputRecordType::INPUT:
+			{
+				if(Client.m_State == CClient::STATE_EMPTY)
+				{
+					NumMismatches++;
+					break;
+				}
+
+				auto& CurrentInput = Client.m_aInputs[Client.m_CurrentInput];
+				CurrentInput.m_GameTick = Event.m_Value;
+				mem_copy(CurrentInput.m_aData, Event.m_aInput, sizeof(CurrentInput.m_aData));
+				mem_copy(Client.m_LatestInput.m_aData, Event.m_aInput, sizeof(Client.m_LatestInput.m_aData));
+				Client.m_LastInputTick = Event.m_Value;
+				Client.m_CurrentInput = (Client.m_CurrentInput + 1) % 200;
+
+				if(Client.m_State == CClient::STATE_INGAME)
+				{
+					GameServer(Client.m_WorldID)->OnClientDirectInput(ClientID, Client.m_LatestInput.m_aData);
+					m_pInputKeys->ResetClientBlockKeys(ClientID);
+				}
+				break;
+			}
+			case InputRecordType::MESSAGE:
+			{
+				CUnpacker Unpacker;
+				Unpacker.Reset(Event.m_pMessage, Event.m_MessageSize);
+				CMsgPacker Packer(NETMSG_EX, true);
+				int MsgID;
+				bool Sys;
+				CUuid Uuid {};
+				if(Client.m_State < CClient::STATE_READY || UnpackMessageID(&MsgID, &Sys, &Uuid, &Unpacker, &Packer) == UNPACKMESSAGE_ERROR || Sys)
+				{
+					NumMismatches++;
+					break;
+				}
+
+				GameServer(Client.m_WorldID)->OnMessage(MsgID, &Unpacker, ClientID);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	const auto Elapsed = time_get_nanoseconds() - StartTime;
+	if(Replay.Error())
+		log_error("replay", "the record is broken, stopped after %d events", NumEvents);
+
+	char aBuf[256];
+	log_info("replay", "%d ticks, %d events, %d mismatches in %.3f sec", NumTicks, NumEvents, NumMismatches, Elapsed.count() / 1000000000.0);
+	TotalTimes.Format(aBuf, sizeof(aBuf));
+	log_info("replay", "tick: %s", aBuf);
+	for(int i = 0; i < NumWorlds; i++)
+	{
+		vTickTimes[i].Format(aBuf, sizeof(aBuf));
+		log_info("replay", "%s tick: %s", MultiWorlds()->GetWorld(i)->GetName(), aBuf);
+		vSnapTimes[i].Format(aBuf, sizeof(aBuf));
+		log_info("replay", "%s snap: %s", MultiWorlds()->GetWorld(i)->GetName(), aBuf);
+	}
+}
+
+void CServer::RecordClientLogin(int ClientID, int AccountID)
+{
+	m_InputRecorder.RecordAuth(ClientID, AccountID);
+}
+
 static inline int GetCacheIndex(int Type, bool SendClient)
 {
 	if(Type == SERVERINFO_INGAME)
@@ -1944,12 +2263,15 @@ void CServer::SendServerInfoConnless(const NETADDR* pAddr, int Token, int Type)
 	SendServerInfo(pAddr, Token, Type, RateLimitServerInfoConnless());
 }
 
-bool CServer::LoadMap(int ID)
+bool CServer::LoadMaps()
 {
-	if(!MultiWorlds()->GetWorld(ID) || !MultiWorlds()->GetWorld(ID)->MapDetail())
-		return false;
+	const int Failed = MultiWorlds()->LoadMaps(Kernel()->RequestInterface<IEngine>(), m_pStorage);
+	if(Failed < 0)
+		return true;
 
-	return MultiWorlds()->GetWorld(ID)->MapDetail()->Load(m_pStorage);
+	const CWorld* pWorld = MultiWorlds()->GetWorld(Failed);
+	log_error("server", "%s the map is not loaded.", pWorld ? pWorld->GetPath() : "(none)");
+	return false;
 }
 
 int CServer::Run(ILogger* pLogger)
@@ -1974,16 +2296,14 @@ int CServer::Run(ILogger* pLogger)
 
 	// loading maps to memory
 	char aBuf[256];
-	for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
-	{
-		if(!LoadMap(i))
-		{
-			dbg_msg("server", "%s the map is not loaded...", MultiWorlds()->GetWorld(i)->GetPath());
-			return -1;
-		}
-	}
+	if(!LoadMaps())
+		return -1;
+
+	// replaying runs the worlds without network
+	m_Replaying = g_Config.m_SvInputReplay[0] != '\0';
 
 	// start server
+	if(!m_Replaying)
 	{
 		NETADDR BindAddr;
 		if(g_Config.m_Bindaddr[0] == '\0')
@@ -2038,7 +2358,10 @@ int CServer::Run(ILogger* pLogger)
 
 	// initilize game server
 	for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
+	{
+		m_TickProfiler.AddWorld(i);
 		MultiWorlds()->GetWorld(i)->GameServer()->OnInit(i);
+	}
 
 	// initilize nicknames
 	InitBaseAccounts();
@@ -2063,6 +2386,8 @@ int CServer::Run(ILogger* pLogger)
 
 		// process pending commands
 		m_pConsole->StoreCommands(false);
+		if(m_Replaying)
+			str_copy(g_Config.m_SvRegister, "0", sizeof(g_Config.m_SvRegister));
 		m_pRegister->OnConfigChange();
 
 		if(m_GeneratedRconPassword)
@@ -2082,6 +2407,11 @@ int CServer::Run(ILogger* pLogger)
 		m_GameStartTime = time_get();
 
 		UpdateServerInfo();
+		if(m_Replaying)
+			RunInputReplay();
+		else
+			StartInputRecord();
+
 		while(m_RunServer < STOPPING)
 		{
 			if(NonActive)
@@ -2099,63 +2429,22 @@ int CServer::Run(ILogger* pLogger)
 				m_CurrentGameTick++;
 				NewTicks = true;
 
-				// apply new input
-				for(int c = 0; c < MAX_PLAYERS; c++)
-				{
-					if(m_aClients[c].m_State == CClient::STATE_EMPTY)
-						continue;
+				m_InputRecorder.RecordTick(m_CurrentGameTick);
+				ApplyClientInputs();
+				UpdateGameTime();
 
-					for(auto& m_aInput : m_aClients[c].m_aInputs)
-					{
-						if(m_aInput.m_GameTick == Tick())
-						{
-							if(m_aClients[c].m_State == CClient::STATE_INGAME)
-							{
-								const int WorldID = m_aClients[c].m_WorldID;
-								GameServer(WorldID)->OnClientPredictedInput(c, m_aInput.m_aData);
-							}
-							break;
-						}
-					}
-				}
-
-				// update game time
-				if(Tick() % TickSpeed() == 0)
 				{
-					// update game typeday
-					if(m_GameTypeday != GetCurrentTypeday())
-					{
-						m_GameTypeday = GetCurrentTypeday();
-						for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
-						{
-							IGameServer* pGameServer = MultiWorlds()->GetWorld(i)->GameServer();
-							if(!MultiWorlds()->GetWorld(i)->GetDetail()->HasFlag(WORLD_FLAG_NO_DAYTIME))
-								pGameServer->OnDaytypeChange(m_GameTypeday);
-						}
-					}
-
-					// update game minute
-					m_GameMinuteTime++;
-					if(m_GameMinuteTime >= 60)
-					{
-						// update game hour
-						m_GameHourTime++;
-						if(m_GameHourTime >= 24)
-						{
-							m_GameHourTime = 0;
-							SetOffsetGameTime(0);
-						}
-
-						// reset game minute
-						m_GameMinuteTime = 0;
-					}
+					CTickProfiler::CScope Scope(&m_TickProfiler, CTickProfiler::WORLD_GLOBAL, CTickProfiler::PHASE_TICK_GLOBAL);
+					MultiWorlds()->GetWorld(INITIALIZER_WORLD_ID)->GameServer()->OnTickGlobal();
 				}
-
-				MultiWorlds()->GetWorld(INITIALIZER_WORLD_ID)->GameServer()->OnTickGlobal();
 				for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
 				{
 					IGameServer* pGameServer = MultiWorlds()->GetWorld(i)->GameServer();
-					pGameServer->OnTick();
+					{
+						CTickProfiler::CScope Scope(&m_TickProfiler, i, CTickProfiler::PHASE_TICK);
+						pGameServer->OnTick();
+					}
+					m_TickProfiler.Flush(i);
 				}
 			}
 
@@ -2184,16 +2473,9 @@ int CServer::Run(ILogger* pLogger)
 						return -1;
 					}
 
-					// iterate through all initialized worlds
-					for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
-					{
-						// load map data for the current world
-						if(!LoadMap(i))
-						{
-							log_error("server", "%s the map is not loaded.", MultiWorlds()->GetWorld(i)->GetPath());
-							return -1;
-						}
-					}
+					// load map data for all initialized worlds
+					if(!LoadMaps())
+						return -1;
 
 					// check if heavy reload is needed
 					if(m_HeavyReload)
@@ -2228,6 +2510,7 @@ int CServer::Run(ILogger* pLogger)
 					for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
 					{
 						IGameServer* pGameServer = MultiWorlds()->GetWorld(i)->GameServer();
+						m_TickProfiler.AddWorld(i);
 						pGameServer->OnInit(i);
 					}
 
@@ -2242,9 +2525,12 @@ int CServer::Run(ILogger* pLogger)
 					// check if the server has high bandwidth or if the current game tick is even
 					if(g_Config.m_SvHighBandwidth || (m_CurrentGameTick % 2) == 0)
 					{
-						// perform a snapshot
+						// perform a snapshot, hibernated worlds have nobody to send it to
 						for(int i = 0; i < MultiWorlds()->GetSizeInitilized(); i++)
-							DoSnapshot(i);
+						{
+							if(!GameServer(i)->IsHibernated())
+								DoSnapshot(i);
+						}
 					}
 
 					// reset all input client keys
@@ -2252,6 +2538,9 @@ int CServer::Run(ILogger* pLogger)
 
 					// update client RCON commands
 					UpdateClientRconCommands();
+
+					// push tick timings to econ clients
+					SendTickProfileEcon();
 				}
 			}
 
@@ -2300,6 +2589,7 @@ int CServer::Run(ILogger* pLogger)
 			Kick(i, "Server shutdown");
 	}
 
+	m_InputRecorder.Stop();
 	delete m_pInputKeys;
 	m_pInputKeys = nullptr;
 	delete m_pLocalization;
@@ -2379,6 +2669,28 @@ void CServer::ConReload(IConsole::IResult* pResult, void* pUser)
 	((CServer*)pUser)->m_HeavyReload = true;
 }
 
+void CServer::ConTickProfile(IConsole::IResult* pResult, void* pUser)
+{
+	CServer* pServer = (CServer*)pUser;
+	const auto fnPrint = [pServer](const char* pLine) { pServer->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "tick_profile", pLine); };
+
+	if(pResult->NumArguments() > 0)
+	{
+		pServer->m_TickProfiler.Format(pResult->GetInteger(0), fnPrint);
+		return;
+	}
+
+	pServer->m_TickProfiler.Format(CTickProfiler::WORLD_GLOBAL, fnPrint);
+	for(int i = 0; i < pServer->MultiWorlds()->GetSizeInitilized(); i++)
+		pServer->m_TickProfiler.Format(i, fnPrint);
+}
+
+void CServer::ConSqlQueue(IConsole::IResult* pResult, void* pUser)
+{
+	CServer* pServer = (CServer*)pUser;
+	Database->FormatQueueStats([pServer](const char* pLine) { pServer->Console()->Print(IConsole::OUTPUT_LEVEL_STANDARD, "sql_queue", pLine); });
+}
+
 // Logout the Rcon client
 void CServer::ConLogout(IConsole::IResult* pResult, void* pUser)
 {
@@ -2551,6 +2863,8 @@ void CServer::RegisterCommands()
 	Console()->Register("shutdown", "", CFGFLAG_SERVER, ConShutdown, this, "Shut down");
 	Console()->Register("reload", "", CFGFLAG_SERVER, ConReload, this, "Reload maps and synchronize data with the database");
 	Console()->Register("logout", "", CFGFLAG_SERVER, ConLogout, this, "Logout of rcon");
+	Console()->Register("tick_profile", "?i[world]", CFGFLAG_SERVER, ConTickProfile, this, "Show tick phase timings of a world, or of all worlds");
+	Console()->Register("sql_queue", "", CFGFLAG_SERVER, ConSqlQueue, this, "Show depth and wait times of the SQL queue lanes since the last call");
 
 	// Chain console commands
 	Console()->Chain("sv_name", ConchainSpecialInfoupdate, this);
@@ -2581,30 +2895,49 @@ void CServer::InitClientBot(int ClientID)
 	SendConnectionReady(ClientID);
 }
 
-// Function to get a new ID from the ID pool
-int CServer::SnapNewID()
+// Function to get the ID pool of a world, pools are created on first use
+CSnapIDPool* CServer::IDPool(int WorldID)
 {
-	// Return a new ID from the ID pool
-	return m_IDPool.NewID();
+	dbg_assert(WorldID >= 0 && WorldID < ENGINE_MAX_WORLDS, "invalid world for snap ids");
+	if(!m_apIDPools[WorldID])
+		m_apIDPools[WorldID] = std::make_unique<CSnapIDPool>();
+	return m_apIDPools[WorldID].get();
 }
 
-// Function to free an ID in the ID pool
-void CServer::SnapFreeID(int ID)
+// Function to get a new ID from the ID pool of a world
+int CServer::SnapNewID(int WorldID)
 {
-	// Free the specified ID in the ID pool
-	m_IDPool.FreeID(ID);
+	return IDPool(WorldID)->NewID();
+}
+
+// Function to free an ID in the ID pool of a world
+void CServer::SnapFreeID(int WorldID, int ID)
+{
+	IDPool(WorldID)->FreeID(ID);
+}
+
+// Function to get a block of consecutive IDs from the ID pool of a world
+int CServer::SnapNewIDs(int WorldID, int Num)
+{
+	return IDPool(WorldID)->NewIDs(Num);
+}
+
+// Function to free a block of IDs in the ID pool of a world
+void CServer::SnapFreeIDs(int WorldID, int FirstID, int Num)
+{
+	IDPool(WorldID)->FreeIDs(FirstID, Num);
 }
 
 // Function to create a new item in the snapshot builder
 void* CServer::SnapNewItem(int Type, int ID, int Size)
 {
-	// Check if the ID is within the valid range
-	dbg_assert(ID >= 0 && ID <= 0xffff, "incorrect id");
-
-	// If the ID is less than 0, return nullptr
+	// entities that got no id from an exhausted pool are not snapped
 	if(ID < 0)
 		return nullptr;
 
+	// Check if the ID is within the valid range
+	dbg_assert(ID <= 0xffff, "incorrect id");
+
 	// Create a new item in the snapshot builder with the specified type, ID, and size
 	return m_SnapshotBuilder.NewItem(Type, ID, Size);
 }
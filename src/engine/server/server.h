@@ -14,7 +14,9 @@
 #include <engine/shared/uuid_manager.h>
 
 #include "cache.h"
+#include "input_record.h"
 #include "snapshot_ids_pool.h"
+#include "tick_profiler.h"
 
 class CServer : public IServer
 {
@@ -39,6 +41,7 @@ public:
 	class CMultiWorlds* MultiWorlds() const { return m_pMultiWorlds; }
 	class CLocalization* Localization() const override { return m_pLocalization; }
 	class IInputEvents* Input() const override;
+	class CTickProfiler* TickProfiler() override { return &m_TickProfiler; }
 
 	enum
 	{
@@ -128,10 +131,14 @@ public:
 	CLocalization* m_pLocalization;
 	CSnapshotDelta m_SnapshotDelta;
 	CSnapshotBuilder m_SnapshotBuilder;
-	CSnapIDPool m_IDPool;
+	std::unique_ptr<CSnapIDPool> m_apIDPools[ENGINE_MAX_WORLDS];
 	CNetServer m_NetServer;
 	CEcon m_Econ;
 	CHttp m_Http;
+	CTickProfiler m_TickProfiler;
+	int64_t m_LastTickProfileEcon {};
+	CInputRecorder m_InputRecorder;
+	bool m_Replaying {};
 
 	int64_t m_GameStartTime {};
 	int m_RunServer;
@@ -260,16 +267,25 @@ public:
 	void UpdateServerInfo(bool Resend = false);
 
 	void PumpNetwork(bool PacketWaiting);
+	void ApplyClientInputs();
+	void UpdateGameTime();
 
-	bool LoadMap(int ID);
+	void StartInputRecord();
+	void RunInputReplay();
+	void RecordClientLogin(int ClientID, int AccountID) override;
+
+	bool LoadMaps();
 
 	int Run(ILogger* pLogger);
+	void SendTickProfileEcon();
 
 	static void ConKick(IConsole::IResult* pResult, void* pUser);
 	static void ConStatus(IConsole::IResult* pResult, void* pUser);
 	static void ConShutdown(IConsole::IResult* pResult, void* pUser);
 	static void ConReload(IConsole::IResult* pResult, void* pUser);
 	static void ConLogout(IConsole::IResult* pResult, void* pUser);
+	static void ConTickProfile(IConsole::IResult* pResult, void* pUser);
+	static void ConSqlQueue(IConsole::IResult* pResult, void* pUser);
 
 	static void ConchainSpecialInfoupdate(IConsole::IResult* pResult, void* pUserData, IConsole::FCommandCallback pfnCallback, void* pCallbackUserData);
 	static void ConchainMaxclientsperipUpdate(IConsole::IResult* pResult, void* pUserData, IConsole::FCommandCallback pfnCallback, void* pCallbackUserData);
@@ -285,8 +301,11 @@ public:
 	// Bots
 	void InitClientBot(int ClientID) override;
 
-	int SnapNewID() override;
-	void SnapFreeID(int ID) override;
+	int SnapNewID(int WorldID) override;
+	void SnapFreeID(int WorldID, int ID) override;
+	int SnapNewIDs(int WorldID, int Num) override;
+	void SnapFreeIDs(int WorldID, int FirstID, int Num) override;
+	CSnapIDPool* IDPool(int WorldID);
 	void* SnapNewItem(int Type, int ID, int Size) override;
 	void SnapSetStaticsize(int ItemType, int Size) override;
 
@@ -1,5 +1,7 @@
 #include "snapshot_ids_pool.h"
 
+#include <algorithm>
+
 CSnapIDPool::CSnapIDPool()
 {
 	Reset();
@@ -7,81 +9,129 @@ CSnapIDPool::CSnapIDPool()
 
 void CSnapIDPool::Reset()
 {
-	for(int i = 0; i < MAX_IDS; i++)
-	{
-		m_aIDs[i].m_Next = i + 1;
-		m_aIDs[i].m_State = 0;
-	}
-	m_aIDs[MAX_IDS - 1].m_Next = -1;
-	m_FirstFree = 0;
-	m_FirstTimed = -1;
-	m_LastTimed = -1;
-	m_Usage = 0;
+	for(auto& Blocks : m_aFreeBlocks)
+		Blocks.clear();
+	m_vAllocatedClass.assign(MAX_IDS, -1);
+	m_NextUnused = 0;
 	m_InUsage = 0;
 }
 
-void CSnapIDPool::RemoveFirstTimeout()
+int CSnapIDPool::SizeClass(int Num)
 {
-	int NextTimed = m_aIDs[m_FirstTimed].m_Next;
+	int Class = 0;
+	while((1 << Class) < Num)
+		Class++;
+	return Class;
+}
 
-	// add it to the free list
-	m_aIDs[m_FirstTimed].m_Next = m_FirstFree;
-	m_aIDs[m_FirstTimed].m_State = 0;
-	m_FirstFree = m_FirstTimed;
+bool CSnapIDPool::TakeBlock(int Class, int64_t Now, int* pFirst)
+{
+	// a block that has been free long enough
+	auto& Blocks = m_aFreeBlocks[Class];
+	if(!Blocks.empty() && Blocks.front().m_Timeout <= Now)
+	{
+		*pFirst = Blocks.front().m_First;
+		Blocks.pop_front();
+		return true;
+	}
 
-	// remove it from the timed list
-	m_FirstTimed = NextTimed;
-	if(m_FirstTimed == -1)
-		m_LastTimed = -1;
+	// ids that were never used
+	const int Size = 1 << Class;
+	if(m_NextUnused + Size <= MAX_IDS)
+	{
+		*pFirst = m_NextUnused;
+		m_NextUnused += Size;
+		return true;
+	}
 
-	m_Usage--;
+	// split a bigger block, the upper halves are ready for smaller classes
+	if(Class + 1 < NUM_CLASSES && TakeBlock(Class + 1, Now, pFirst))
+	{
+		m_aFreeBlocks[Class].push_front({ *pFirst + Size, 0 });
+		return true;
+	}
+
+	return false;
 }
 
-int CSnapIDPool::NewID()
+bool CSnapIDPool::Coalesce(int64_t Now)
 {
-	int64_t Now = time_get();
-
-	// process timed ids
-	while(m_FirstTimed != -1 && m_aIDs[m_FirstTimed].m_Timeout < Now)
-		RemoveFirstTimeout();
-
-	int ID = m_FirstFree;
-	dbg_assert(ID != -1, "id error");
-	if(ID == -1)
-		return ID;
-	m_FirstFree = m_aIDs[m_FirstFree].m_Next;
-	m_aIDs[ID].m_State = 1;
-	m_Usage++;
-	m_InUsage++;
-	return ID;
+	// reusable blocks are at the front of every class, the deques are ordered by timeout
+	std::vector<std::pair<int, int>> vRanges;
+	for(int Class = 0; Class < NUM_CLASSES; Class++)
+	{
+		auto& Blocks = m_aFreeBlocks[Class];
+		while(!Blocks.empty() && Blocks.front().m_Timeout <= Now)
+		{
+			vRanges.emplace_back(Blocks.front().m_First, Blocks.front().m_First + (1 << Class));
+			Blocks.pop_front();
+		}
+	}
+	if(vRanges.empty())
+		return false;
+
+	std::sort(vRanges.begin(), vRanges.end());
+	std::vector<std::pair<int, int>> vMerged;
+	for(const auto& Range : vRanges)
+	{
+		if(!vMerged.empty() && vMerged.back().second == Range.first)
+			vMerged.back().second = Range.second;
+		else
+			vMerged.push_back(Range);
+	}
+
+	// a run that ends at the unused ids goes back to them
+	if(vMerged.back().second == m_NextUnused)
+	{
+		m_NextUnused = vMerged.back().first;
+		vMerged.pop_back();
+	}
+
+	// split the runs into the biggest blocks that fit
+	for(const auto& [Start, End] : vMerged)
+	{
+		for(int First = Start; First < End;)
+		{
+			int Class = NUM_CLASSES - 1;
+			while((1 << Class) > End - First)
+				Class--;
+			m_aFreeBlocks[Class].push_front({ First, 0 });
+			First += 1 << Class;
+		}
+	}
+	return true;
 }
 
-void CSnapIDPool::TimeoutIDs()
+int CSnapIDPool::NewIDs(int Num, int64_t Now)
 {
-	// process timed ids
-	while(m_FirstTimed != -1)
-		RemoveFirstTimeout();
+	if(Num <= 0 || Num > MAX_BLOCK_IDS)
+	{
+		dbg_msg("snap_ids", "can't allocate a block of %d ids", Num);
+		return -1;
+	}
+
+	const int Class = SizeClass(Num);
+	int First;
+	if(!TakeBlock(Class, Now, &First) && !(Coalesce(Now) && TakeBlock(Class, Now, &First)))
+	{
+		dbg_msg("snap_ids", "out of ids, %d in use", m_InUsage);
+		return -1;
+	}
+
+	m_vAllocatedClass[First] = (int8_t)Class;
+	m_InUsage += Num;
+	return First;
 }
 
-void CSnapIDPool::FreeID(int ID)
+void CSnapIDPool::FreeIDs(int FirstID, int Num, int64_t Now)
 {
-	if(ID < 0)
+	if(FirstID < 0 || FirstID >= MAX_IDS)
 		return;
-	dbg_assert(m_aIDs[ID].m_State == 1, "id is not allocated");
 
-	m_InUsage--;
-	m_aIDs[ID].m_State = 2;
-	m_aIDs[ID].m_Timeout = time_get() + time_freq() * 5;
-	m_aIDs[ID].m_Next = -1;
+	const int Class = m_vAllocatedClass[FirstID];
+	dbg_assert(Class >= 0 && Class == SizeClass(Num), "ids are not allocated as one block");
 
-	if(m_LastTimed != -1)
-	{
-		m_aIDs[m_LastTimed].m_Next = ID;
-		m_LastTimed = ID;
-	}
-	else
-	{
-		m_FirstTimed = ID;
-		m_LastTimed = ID;
-	}
-}
\ No newline at end of file
+	m_vAllocatedClass[FirstID] = -1;
+	m_InUsage -= Num;
+	m_aFreeBlocks[Class].push_back({ FirstID, Now + time_freq() * 5 });
+}
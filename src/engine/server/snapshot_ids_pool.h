@@ -1,38 +1,67 @@
 #ifndef ENGINE_SERVER_SNAPSHOT_IDS_POOL_CONTEXT_H
 #define ENGINE_SERVER_SNAPSHOT_IDS_POOL_CONTEXT_H
 
+#include <base/system.h>
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/*
+ * Snapshot item ids of one world. Ids are handed out in blocks of
+ * consecutive ids rounded up to a power of two, so entities with many
+ * items take and return all of them at once. Freed blocks wait a few
+ * seconds before reuse, clients may still have them in older snapshots.
+ * Free blocks are not merged on free, only when a request can't be served
+ * otherwise, then all reusable blocks are joined with their neighbours.
+ */
 class CSnapIDPool
 {
+public:
 	enum
 	{
-		MAX_IDS = 32 * 1024,
+		MAX_IDS = 64 * 1024, // item ids are 16 bit in the snapshot
+		NUM_CLASSES = 13,
+		MAX_BLOCK_IDS = 1 << (NUM_CLASSES - 1),
 	};
 
-	class CID
+private:
+	struct CBlock
 	{
-	public:
-		short m_Next;
-		short m_State; // 0 = free, 1 = allocated, 2 = timed
-		int m_Timeout;
+		int m_First;
+		int64_t m_Timeout;
 	};
 
-	CID m_aIDs[MAX_IDS];
+	// blocks of every size class, oldest freed first
+	std::deque<CBlock> m_aFreeBlocks[NUM_CLASSES];
 
-	int m_FirstFree;
-	int m_FirstTimed;
-	int m_LastTimed;
-	int m_Usage;
+	// size class of every allocated block by its first id, -1 for other ids
+	std::vector<int8_t> m_vAllocatedClass;
+
+	int m_NextUnused;
 	int m_InUsage;
 
+	static int SizeClass(int Num);
+	bool TakeBlock(int Class, int64_t Now, int* pFirst);
+	bool Coalesce(int64_t Now);
+
 public:
 	CSnapIDPool();
 
 	void Reset();
-	void RemoveFirstTimeout();
-	int NewID();
-	void TimeoutIDs();
-	void FreeID(int ID);
-};
 
+	// returns the first of Num consecutive ids, -1 when the world is out of ids
+	int NewIDs(int Num) { return NewIDs(Num, time_get()); }
+	void FreeIDs(int FirstID, int Num) { FreeIDs(FirstID, Num, time_get()); }
+
+	// with an explicit time, for tests
+	int NewIDs(int Num, int64_t Now);
+	void FreeIDs(int FirstID, int Num, int64_t Now);
+
+	int NewID() { return NewIDs(1); }
+	void FreeID(int ID) { FreeIDs(ID, 1); }
+
+	int InUsage() const { return m_InUsage; }
+};
 
-#endif
\ No newline at end of file
+#endif
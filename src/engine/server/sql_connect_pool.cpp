@@ -1,6 +1,7 @@
 #include <base/system.h>
 #include "sql_connect_pool.h"
 #include "sql_lost_query_logger.h"
+#include "sqlite3/sqlite_handler.h"
 
 // #####################################################
 // THREAD POOL IMPLEMENTATION
@@ -31,6 +32,37 @@ namespace
 		return "UNKNOWN";
 	}
 
+	const char* DbLaneName(DBLane lane)
+	{
+		switch(lane)
+		{
+			case DBLane::INTERACTIVE:
+				return "interactive";
+			case DBLane::WRITE:
+				return "write";
+			case DBLane::BULK:
+				return "bulk";
+			default:
+				break;
+		}
+		return "unknown";
+	}
+
+	DBLane DefaultLaneForType(DB type)
+	{
+		return type == DB::SELECT ? DBLane::INTERACTIVE : DBLane::WRITE;
+	}
+
+	// a lower lane gets the next free worker once its oldest task waited this long
+	constexpr int LANE_STARVATION_MS = 500;
+
+	struct CQueueContext
+	{
+		std::optional<DBLane> m_Lane;
+		uint64_t m_OrderKey {};
+	};
+	thread_local CQueueContext t_QueueContext;
+
 	void LogLostQuery(const char* reason, DB type, const std::string& query)
 	{
 		CSqlLostQueryLogger::Instance().LogLostQuery(reason, DbTypeName(type), query);
@@ -95,6 +127,51 @@ namespace
 		return s_pSyncConnection;
 	}
 
+	sqlitedb::Handler* GetSqliteConnection()
+	{
+		thread_local std::unique_ptr<sqlitedb::Handler> s_pSqliteConnection;
+		if(!s_pSqliteConnection || !s_pSqliteConnection->IsOpen())
+		{
+			s_pSqliteConnection = std::make_unique<sqlitedb::Handler>(g_Config.m_SvSqliteFile);
+		}
+		return s_pSqliteConnection->IsOpen() ? s_pSqliteConnection.get() : nullptr;
+	}
+
+	ResultPtr SqliteSelect(const std::string& Query, const char* pContext)
+	{
+		auto* pConnection = GetSqliteConnection();
+		auto pRows = pConnection ? pConnection->Select(Query) : nullptr;
+		if(!pRows)
+		{
+			dbg_msg("SQL Error", "%s failed: %s. Query: %s", pContext, pConnection ? pConnection->GetError() : "database is not open", Query.c_str());
+			LogLostQuery("sqlite select failed", DB::SELECT, Query);
+			return EmptyResult();
+		}
+
+		return std::make_shared<WrapperResultSet>(std::move(pRows));
+	}
+
+	// a new database file gets the tables and rows of the MySQL dump
+	void PrepareSqliteDatabase()
+	{
+		sqlitedb::Handler Handler(g_Config.m_SvSqliteFile);
+		if(!Handler.IsOpen() || Handler.HasTables())
+			return;
+
+		IOHANDLE File = io_open(g_Config.m_SvSqliteSchema, IOFLAG_READ);
+		if(!File)
+		{
+			dbg_msg("SQL Error", "SQLite schema '%s' can't be opened, the database stays empty.", g_Config.m_SvSqliteSchema);
+			return;
+		}
+
+		char* pDump = io_read_all_str(File);
+		io_close(File);
+		if(!pDump || !Handler.ImportMySqlDump(pDump))
+			dbg_msg("SQL Error", "SQLite schema '%s' failed to import.", g_Config.m_SvSqliteSchema);
+		free(pDump);
+	}
+
 	template<typename TCallback>
 	class CAsyncQueryContext
 	{
@@ -243,6 +320,48 @@ namespace
 			}
 		};
 	}
+
+	std::function<void(Connection*, int)> CreateSqliteSelectTask(const std::shared_ptr<CAsyncSelectContext>& pContext)
+	{
+		return [pContext](Connection* /*pConnection*/, int /*RetryCount*/)
+		{
+			NotifySelect(pContext->Callback(), SqliteSelect(pContext->Query(), "Async SELECT"));
+		};
+	}
+
+	std::function<void(Connection*, int)> CreateSqliteDmlTask(const std::shared_ptr<CAsyncDmlContext>& pContext)
+	{
+		return [pContext](Connection* /*pConnection*/, int /*RetryCount*/)
+		{
+			if(pContext->DelayMilliseconds() > 0)
+				std::this_thread::sleep_for(std::chrono::milliseconds(pContext->DelayMilliseconds()));
+
+			// the busy timeout already waits for other writers, so there is nothing to retry
+			auto* pConnection = GetSqliteConnection();
+			const int Changes = pConnection ? pConnection->Execute(pContext->Query()) : -1;
+			if(Changes < 0)
+			{
+				dbg_msg("SQL Error", "Async DML failed: %s. Query: %s", pConnection ? pConnection->GetError() : "database is not open", pContext->Query().c_str());
+				LogLostQuery("sqlite dml failed", pContext->Type(), pContext->Query());
+			}
+			NotifyDml(pContext->Callback(), Changes > 0);
+		};
+	}
+}
+
+CSqlQueueScope::CSqlQueueScope(std::optional<DBLane> Lane, uint64_t OrderKey)
+	: m_PrevLane(t_QueueContext.m_Lane), m_PrevOrderKey(t_QueueContext.m_OrderKey)
+{
+	if(Lane.has_value())
+		t_QueueContext.m_Lane = Lane;
+	if(OrderKey != 0)
+		t_QueueContext.m_OrderKey = OrderKey;
+}
+
+CSqlQueueScope::~CSqlQueueScope()
+{
+	t_QueueContext.m_Lane = m_PrevLane;
+	t_QueueContext.m_OrderKey = m_PrevOrderKey;
 }
 
 CThreadPool::CThreadPool(size_t numThreads) : m_bStop(false)
@@ -269,17 +388,39 @@ CThreadPool::~CThreadPool()
 	}
 }
 
-void CThreadPool::Enqueue(std::function<void(Connection*, int)> task, DB type, std::string query)
+void CThreadPool::Enqueue(std::function<void(Connection*, int)> task, DB type, std::string query, DBLane defaultLane)
 {
-	EnqueueWithRetry(std::move(task), type, std::move(query), 0);
+	const DBLane lane = t_QueueContext.m_Lane.value_or(defaultLane);
+	CTask newTask{std::move(task), time_get(), type, std::move(query), 0, lane, t_QueueContext.m_OrderKey};
+	EnqueueTask(std::move(newTask));
 }
 
 void CThreadPool::EnqueueWithRetry(std::function<void(Connection*, int)> task, DB type, std::string query, int retryCount)
 {
-	CTask newTask{std::move(task), time_get(), type, std::move(query), retryCount};
+	// retries are enqueued by the running task, so the context is the one of that task
+	const DBLane lane = t_QueueContext.m_Lane.value_or(DefaultLaneForType(type));
+	CTask newTask{std::move(task), time_get(), type, std::move(query), retryCount, lane, t_QueueContext.m_OrderKey};
 	EnqueueTask(std::move(newTask));
 }
 
+CThreadPool::CLaneStats CThreadPool::GetLaneStats(DBLane lane)
+{
+	std::lock_guard<std::mutex> lock(m_mxQueue);
+	auto& rLane = m_aLanes[static_cast<size_t>(lane)];
+
+	CLaneStats stats;
+	stats.m_Depth = rLane.m_Queued;
+	stats.m_Executed = rLane.m_Executed;
+	if(rLane.m_WindowExecuted > 0)
+		stats.m_AvgWaitMs = DurationMs(0, rLane.m_WindowWait) / static_cast<double>(rLane.m_WindowExecuted);
+	stats.m_MaxWaitMs = DurationMs(0, rLane.m_WindowMaxWait);
+
+	rLane.m_WindowExecuted = 0;
+	rLane.m_WindowWait = 0;
+	rLane.m_WindowMaxWait = 0;
+	return stats;
+}
+
 void CThreadPool::EnqueueTask(CTask&& task)
 {
 	size_t queuedSize = 0;
@@ -289,7 +430,8 @@ void CThreadPool::EnqueueTask(CTask&& task)
 	{
 		std::unique_lock<std::mutex> lock(m_mxQueue);
 		bool warned = false;
-		if(maxQueueSize > 0)
+		// retries replace a task that already got in, a keyed retry could wait for its own key otherwise
+		if(maxQueueSize > 0 && task.m_RetryCount == 0)
 		{
 			while(!m_bStop.load() && m_QueueSize.load() >= maxQueueSize)
 			{
@@ -308,8 +450,25 @@ void CThreadPool::EnqueueTask(CTask&& task)
 		if(m_bStop.load())
 			return;
 
-		m_qTasks.emplace(std::move(task));
+		m_aLanes[static_cast<size_t>(task.m_Lane)].m_Queued++;
 		queuedSize = m_QueueSize.fetch_add(1) + 1;
+
+		// the task waits while an earlier task of its key is queued or running,
+		// a retry comes from the running task itself and goes first
+		if(task.m_OrderKey != 0)
+		{
+			const auto [it, inserted] = m_KeyedTasks.try_emplace(task.m_OrderKey);
+			if(!inserted)
+			{
+				if(task.m_RetryCount > 0)
+					it->second.emplace_front(std::move(task));
+				else
+					it->second.emplace_back(std::move(task));
+				return;
+			}
+		}
+
+		m_aLanes[static_cast<size_t>(task.m_Lane)].m_qTasks.emplace_back(std::move(task));
 	}
 
 	if(queuedSize > static_cast<size_t>(g_Config.m_SvSqlQueueWarnSize))
@@ -336,11 +495,72 @@ void CThreadPool::EnqueueRetry(CTask&& task, const char* reason, int maxRetries)
 	EnqueueTask(std::move(task));
 }
 
+bool CThreadPool::HasReadyTask() const
+{
+	return std::ranges::any_of(m_aLanes, [](const CLane& lane) { return !lane.m_qTasks.empty(); });
+}
+
+CThreadPool::CTask CThreadPool::PopTask()
+{
+	// highest lane first, unless a lower lane has waited too long
+	const int64_t now = time_get();
+	size_t laneIndex = m_aLanes.size();
+	for(size_t i = m_aLanes.size() - 1; i > 0; --i)
+	{
+		const auto& qTasks = m_aLanes[i].m_qTasks;
+		if(!qTasks.empty() && DurationMs(qTasks.front().m_EnqueueTime, now) > LANE_STARVATION_MS)
+		{
+			laneIndex = i;
+			break;
+		}
+	}
+	if(laneIndex == m_aLanes.size())
+	{
+		for(laneIndex = 0; m_aLanes[laneIndex].m_qTasks.empty(); ++laneIndex) {}
+	}
+
+	auto& rLane = m_aLanes[laneIndex];
+	CTask task = std::move(rLane.m_qTasks.front());
+	rLane.m_qTasks.pop_front();
+	rLane.m_Queued--;
+	m_QueueSize.fetch_sub(1);
+
+	const int64_t waited = now - task.m_EnqueueTime;
+	rLane.m_Executed++;
+	rLane.m_WindowExecuted++;
+	rLane.m_WindowWait += waited;
+	rLane.m_WindowMaxWait = std::max(rLane.m_WindowMaxWait, waited);
+	return task;
+}
+
+void CThreadPool::ReleaseOrderKey(uint64_t orderKey)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mxQueue);
+		const auto it = m_KeyedTasks.find(orderKey);
+		if(it == m_KeyedTasks.end())
+			return;
+
+		if(it->second.empty())
+		{
+			m_KeyedTasks.erase(it);
+			return;
+		}
+
+		CTask& next = it->second.front();
+		m_aLanes[static_cast<size_t>(next.m_Lane)].m_qTasks.emplace_back(std::move(next));
+		it->second.pop_front();
+	}
+
+	m_cvCondition.notify_one();
+}
+
 void CThreadPool::WorkerThread()
 {
 	// Each worker thread has its own, persistent connection.
-	// It is created once when the thread starts.
-	std::unique_ptr<Connection> pConnection = CConectionPool::CreateConnection();
+	// It is created once when the thread starts, SQLite tasks open their own.
+	const bool Sqlite = CConectionPool::IsSqlite();
+	std::unique_ptr<Connection> pConnection = Sqlite ? nullptr : CConectionPool::CreateConnection();
 
 	// The main loop for the worker thread.
 	while(true)
@@ -355,19 +575,17 @@ void CThreadPool::WorkerThread()
 
 			// Wait until there's a task or the pool is stopping.
 			// The lambda prevents spurious wakeups.
-			if(!m_cvCondition.wait_for(lock, std::chrono::seconds(60), [this]{ return m_bStop || !m_qTasks.empty(); }))
+			if(!m_cvCondition.wait_for(lock, std::chrono::seconds(60), [this]{ return m_bStop || HasReadyTask(); }))
 				timedOut = true;
 
 			// If stopping and no tasks are left, exit the thread's loop.
-			if(m_bStop && m_qTasks.empty())
+			if(m_bStop && !HasReadyTask())
 				return;
 
 			// Get the next task from the queue.
-			if(!m_qTasks.empty())
+			if(HasReadyTask())
 			{
-				task = std::move(m_qTasks.front());
-				m_qTasks.pop();
-				m_QueueSize.fetch_sub(1);
+				task = PopTask();
 				hasTask = true;
 			}
 		}
@@ -378,15 +596,19 @@ void CThreadPool::WorkerThread()
 		// --- Execute the task ---
 		if(hasTask)
 		{
+			// the task is moved away on retries, the key is released after it anyway
+			const uint64_t orderKey = task.m_OrderKey;
+			CSqlQueueScope queueScope(task.m_Lane, orderKey);
+
 			try
 			{
 				// Check if the connection is dead. If so, try to reconnect.
-				if(!pConnection || pConnection->isClosed())
+				if(!Sqlite && (!pConnection || pConnection->isClosed()))
 				{
 					pConnection = CConectionPool::CreateConnection();
 				}
 
-				if(pConnection)
+				if(Sqlite || pConnection)
 				{
 					// Execute the actual task (a lambda containing the query logic).
 					// We pass the raw connection pointer to the task.
@@ -394,7 +616,7 @@ void CThreadPool::WorkerThread()
 					const double waitMs = DurationMs(startWait, time_get());
 					if(waitMs > static_cast<double>(g_Config.m_SvSqlQueueWaitWarnMs))
 					{
-						dbg_msg("SQL Worker", "Task waited %.2fms in queue (type: %s). Query: %s", waitMs, DbTypeName(task.m_Type), task.m_Query.c_str());
+						dbg_msg("SQL Worker", "Task waited %.2fms in queue (type: %s, lane: %s). Query: %s", waitMs, DbTypeName(task.m_Type), DbLaneName(task.m_Lane), task.m_Query.c_str());
 					}
 					task.m_Task(pConnection.get(), task.m_RetryCount);
 				}
@@ -420,6 +642,9 @@ void CThreadPool::WorkerThread()
 			{
 				dbg_msg("Error", "Worker caught std::exception during task: %s", e.what());
 			}
+
+			if(orderKey != 0)
+				ReleaseOrderKey(orderKey);
 		}
 		else if(timedOut)
 		{
@@ -437,6 +662,14 @@ void CThreadPool::WorkerThread()
 // #####################################################
 CConectionPool::CConectionPool()
 {
+	if(IsSqlite())
+	{
+		PrepareSqliteDatabase();
+		m_pDriver = nullptr;
+		m_pThreadPool = std::make_unique<CThreadPool>(std::max(2, g_Config.m_SvMySqlPoolSize));
+		return;
+	}
+
 	try
 	{
 		m_pDriver = mariadb::get_driver_instance();
@@ -456,6 +689,27 @@ CConectionPool::~CConectionPool()
 	// which will cleanly stop and join all worker threads.
 }
 
+bool CConectionPool::IsSqlite()
+{
+	return g_Config.m_SvSqliteFile[0] != '\0';
+}
+
+void CConectionPool::FormatQueueStats(const std::function<void(const char*)>& fnLine) const
+{
+	if(!m_pThreadPool)
+		return;
+
+	char aBuf[256];
+	for(int i = 0; i < static_cast<int>(DBLane::NUM); i++)
+	{
+		const auto lane = static_cast<DBLane>(i);
+		const auto stats = m_pThreadPool->GetLaneStats(lane);
+		str_format(aBuf, sizeof(aBuf), "%-12s depth %4zu  executed %8llu  wait avg %7.2fms  max %7.2fms",
+			DbLaneName(lane), stats.m_Depth, (unsigned long long)stats.m_Executed, stats.m_AvgWaitMs, stats.m_MaxWaitMs);
+		fnLine(aBuf);
+	}
+}
+
 std::unique_ptr<Connection> CConectionPool::CreateConnection()
 {
 	static std::atomic<int64_t> s_LastConnectFailure{0};
@@ -505,6 +759,9 @@ std::unique_ptr<Connection> CConectionPool::CreateConnection()
 // --- SYNCHRONOUS SELECT ---
 [[nodiscard]] ResultPtr CConectionPool::CResultSelect::Execute() const
 {
+	if(IsSqlite())
+		return SqliteSelect(m_Query, "Sync SELECT");
+
 	// Synchronous queries run on the calling thread and reuse a thread-local connection.
 	auto& pConnection = GetSyncConnection();
 	if(!pConnection)
@@ -580,7 +837,11 @@ void CConectionPool::CResultSelect::AtExecute(CallbackResultPtr pCallbackResult)
 		NotifySelect(pContext->Callback(), EmptyResult());
 		return;
 	}
-	pThreadPool->Enqueue(CreateAsyncSelectTask(pContext, pThreadPool), pContext->Type(), pContext->Query());
+
+	if(IsSqlite())
+		pThreadPool->Enqueue(CreateSqliteSelectTask(pContext), pContext->Type(), pContext->Query(), DBLane::INTERACTIVE);
+	else
+		pThreadPool->Enqueue(CreateAsyncSelectTask(pContext, pThreadPool), pContext->Type(), pContext->Query(), DBLane::INTERACTIVE);
 }
 
 
@@ -595,5 +856,11 @@ void CConectionPool::CResultQuery::AtExecute(CallbackUpdatePtr pCallbackResult,
 		NotifyDml(pContext->Callback(), false);
 		return;
 	}
-	pThreadPool->Enqueue(CreateAsyncDmlTask(pContext, pThreadPool), pContext->Type(), pContext->Query());
+
+	// delayed writes are saves nobody waits for
+	const DBLane lane = DelayMilliseconds > 0 ? DBLane::BULK : DBLane::WRITE;
+	if(IsSqlite())
+		pThreadPool->Enqueue(CreateSqliteDmlTask(pContext), pContext->Type(), pContext->Query(), lane);
+	else
+		pThreadPool->Enqueue(CreateAsyncDmlTask(pContext, pThreadPool), pContext->Type(), pContext->Query(), lane);
 }
@@ -9,11 +9,17 @@
 #include <mariadb/conncpp/ResultSet.hpp>
 #include <mariadb/conncpp/Statement.hpp>
 
+#include <engine/server/sqlite3/sqlite_statement.h>
+
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdarg>
+#include <deque>
 #include <memory>
+#include <optional>
 #include <queue>
+#include <unordered_map>
 
 using namespace sql;
 class CConectionPool; // Forward declare
@@ -31,6 +37,38 @@ enum class DB
 	OTHER,
 };
 
+// Queue lanes of the thread pool, a free worker takes the first lane with work.
+enum class DBLane
+{
+	INTERACTIVE = 0, // somebody waits for it, async SELECTs by default
+	WRITE,           // INSERT/UPDATE/DELETE by default
+	BULK,            // delayed writes, history and other background saves
+	NUM,
+};
+
+// Order keys, tasks with the same non-zero key run one after another in enqueue order.
+struct DBOrderKey
+{
+	static uint64_t Account(int AccountID) { return (1ull << 32) | static_cast<uint32_t>(AccountID); }
+	static uint64_t Guild(int GuildID) { return (2ull << 32) | static_cast<uint32_t>(GuildID); }
+};
+
+// Async queries started by this thread while the scope lives go to the given lane
+// (if any) with the given order key. Scopes can be nested, tasks run inside the
+// scope of the task that started them, so callbacks and retries keep both.
+class CSqlQueueScope
+{
+	std::optional<DBLane> m_PrevLane;
+	uint64_t m_PrevOrderKey;
+
+public:
+	CSqlQueueScope(std::optional<DBLane> Lane, uint64_t OrderKey = 0);
+	~CSqlQueueScope();
+
+	CSqlQueueScope(const CSqlQueueScope&) = delete;
+	CSqlQueueScope& operator=(const CSqlQueueScope&) = delete;
+};
+
 // Helper to check for lost connection errors by error code or SQLSTATE.
 // SQLSTATE '08xxx' indicates a connection exception.
 inline bool is_connection_lost(SQLException& e)
@@ -46,6 +84,7 @@ inline bool is_connection_lost(SQLException& e)
 
 // WrapperResultSet is a temporary wrapper that owns the Statement and ResultSet.
 // Its lifetime is confined to the scope of a single query execution.
+// With the SQLite backend it owns the copied rows instead.
 class WrapperResultSet
 {
 public:
@@ -56,33 +95,38 @@ public:
 	{
 	}
 
+	explicit WrapperResultSet(sqlitedb::StatementPtr rows)
+		: m_pRows(std::move(rows))
+	{
+	}
+
 	// Delete copy semantics, allow move
 	WrapperResultSet(const WrapperResultSet&) = delete;
 	WrapperResultSet& operator=(const WrapperResultSet&) = delete;
 	WrapperResultSet(WrapperResultSet&&) = default;
 	WrapperResultSet& operator=(WrapperResultSet&&) = default;
-	explicit operator bool() const { return m_pResult != nullptr; }
+	explicit operator bool() const { return m_pResult != nullptr || m_pRows != nullptr; }
 
 	// --- Full accessor implementations ---
-	bool getBoolean(const SQLString& column) const { return m_pResult ? m_pResult->getBoolean(column) : false; }
-	int getInt(const SQLString& column) const { return m_pResult ? m_pResult->getInt(column) : 0; }
-	unsigned int getUInt(const SQLString& column) const { return m_pResult ? m_pResult->getUInt(column) : 0; }
-	int64_t getInt64(const SQLString& column) const { return m_pResult ? m_pResult->getInt64(column) : 0; }
-	uint64_t getUInt64(const SQLString& column) const { return m_pResult ? m_pResult->getUInt64(column) : 0; }
-	double getDouble(const SQLString& column) const { return m_pResult ? m_pResult->getDouble(column) : 0.0; }
-	float getFloat(const SQLString& column) const { return m_pResult ? static_cast<float>(m_pResult->getDouble(column)) : 0.0f; }
-	std::string getString(const SQLString& column) const { return m_pResult ? std::string(m_pResult->getString(column).c_str()) : ""; }
-	std::string getDateTime(const SQLString& column) const { return m_pResult ? std::string(m_pResult->getString(column).c_str()) : ""; }
-	bool next() const { return m_pResult && m_pResult->next(); }
-	size_t rowsCount() const { return m_pResult ? m_pResult->rowsCount() : 0; }
-	size_t getRow() const { return m_pResult ? m_pResult->getRow() : 0; }
+	bool getBoolean(const SQLString& column) const { return m_pRows ? m_pRows->getBoolean(column.c_str()) : m_pResult ? m_pResult->getBoolean(column) : false; }
+	int getInt(const SQLString& column) const { return m_pRows ? m_pRows->getInt(column.c_str()) : m_pResult ? m_pResult->getInt(column) : 0; }
+	unsigned int getUInt(const SQLString& column) const { return m_pRows ? m_pRows->getUInt(column.c_str()) : m_pResult ? m_pResult->getUInt(column) : 0; }
+	int64_t getInt64(const SQLString& column) const { return m_pRows ? m_pRows->getInt64(column.c_str()) : m_pResult ? m_pResult->getInt64(column) : 0; }
+	uint64_t getUInt64(const SQLString& column) const { return m_pRows ? m_pRows->getUInt64(column.c_str()) : m_pResult ? m_pResult->getUInt64(column) : 0; }
+	double getDouble(const SQLString& column) const { return m_pRows ? m_pRows->getDouble(column.c_str()) : m_pResult ? m_pResult->getDouble(column) : 0.0; }
+	float getFloat(const SQLString& column) const { return static_cast<float>(getDouble(column)); }
+	std::string getString(const SQLString& column) const { return m_pRows ? m_pRows->getString(column.c_str()) : m_pResult ? std::string(m_pResult->getString(column).c_str()) : ""; }
+	std::string getDateTime(const SQLString& column) const { return getString(column); }
+	bool next() const { return m_pRows ? m_pRows->next() : m_pResult && m_pResult->next(); }
+	size_t rowsCount() const { return m_pRows ? m_pRows->rowsCount() : m_pResult ? m_pResult->rowsCount() : 0; }
+	size_t getRow() const { return m_pRows ? m_pRows->getRow() : m_pResult ? m_pResult->getRow() : 0; }
 
 	nlohmann::json getJson(const SQLString& column) const
 	{
-		if(!m_pResult)
+		if(!*this)
 			return nullptr;
 
-		const std::string jsonString = m_pResult->getString(column).c_str();
+		const std::string jsonString = getString(column);
 		if(jsonString.empty())
 			return nullptr;
 
@@ -103,10 +147,10 @@ public:
 
 	BigInt getBigInt(const SQLString& column) const
 	{
-		if(!m_pResult)
+		if(!*this)
 			return BigInt();
 
-		const std::string stringValue = m_pResult->getString(column).c_str();
+		const std::string stringValue = getString(column);
 		if(stringValue.empty())
 			return BigInt();
 
@@ -128,6 +172,7 @@ private:
 	std::unique_ptr<Statement> m_pStmt;
 	std::unique_ptr<ResultSet> m_pResult;
 	std::shared_ptr<Connection> m_pConnection;
+	sqlitedb::StatementPtr m_pRows;
 };
 
 
@@ -155,11 +200,23 @@ public:
 	CThreadPool(const CThreadPool&) = delete;
 	CThreadPool& operator=(const CThreadPool&) = delete;
 
+	struct CLaneStats
+	{
+		size_t m_Depth {};
+		uint64_t m_Executed {};
+		double m_AvgWaitMs {};
+		double m_MaxWaitMs {};
+	};
+
 	// Enqueues a task to be executed by a worker thread.
 	// The task must be a callable that accepts a `Connection*`.
-	void Enqueue(std::function<void(Connection*, int)> task, DB type, std::string query);
+	// The lane of the current CSqlQueueScope wins over the default lane.
+	void Enqueue(std::function<void(Connection*, int)> task, DB type, std::string query, DBLane defaultLane);
 	void EnqueueWithRetry(std::function<void(Connection*, int)> task, DB type, std::string query, int retryCount);
 
+	// wait times are the ones of the tasks started since the previous call
+	CLaneStats GetLaneStats(DBLane lane);
+
 private:
 	struct CTask
 	{
@@ -168,14 +225,31 @@ private:
 		DB m_Type;
 		std::string m_Query;
 		int m_RetryCount;
+		DBLane m_Lane;
+		uint64_t m_OrderKey;
+	};
+
+	struct CLane
+	{
+		std::deque<CTask> m_qTasks;
+		size_t m_Queued {}; // including the tasks waiting for their order key
+		uint64_t m_Executed {};
+		uint64_t m_WindowExecuted {};
+		int64_t m_WindowWait {};
+		int64_t m_WindowMaxWait {};
 	};
 
 	void EnqueueTask(CTask&& task);
 	void EnqueueRetry(CTask&& task, const char* reason, int maxRetries);
+	bool HasReadyTask() const;
+	CTask PopTask();
+	void ReleaseOrderKey(uint64_t orderKey);
 	void WorkerThread();
 
 	std::vector<std::thread> m_vWorkers;
-	std::queue<CTask> m_qTasks;
+	std::array<CLane, static_cast<size_t>(DBLane::NUM)> m_aLanes;
+	// a key is present while one of its tasks is queued or running, later tasks of the key wait here
+	std::unordered_map<uint64_t, std::deque<CTask>> m_KeyedTasks;
 	std::mutex m_mxQueue;
 	std::condition_variable m_cvCondition;
 	std::atomic<bool> m_bStop;
@@ -203,6 +277,12 @@ public:
 	CConectionPool& operator=(const CConectionPool&) = delete;
 	static std::unique_ptr<Connection> CreateConnection();
 
+	// queries go to the embedded SQLite file from sv_sqlite_file instead of MySQL
+	static bool IsSqlite();
+
+	// calls the callback with one formatted line per queue lane
+	void FormatQueueStats(const std::function<void(const char*)>& fnLine) const;
+
 private:
 	CConectionPool();
 	~CConectionPool();
@@ -0,0 +1,186 @@
+#include "sql_id_allocator.h"
+
+#include <base/system.h>
+#include <engine/shared/config.h>
+
+#include "sql_connect_pool.h"
+
+#include <functional>
+#include <future>
+
+namespace
+{
+	constexpr int MAX_RESERVE_ATTEMPTS = 8;
+	// total time one Register or one blocking reservation may wait for the database
+	constexpr auto RESERVE_WAIT_TIME = std::chrono::seconds(10);
+
+	// waits for an async DML task, only used on startup
+	bool WaitFor(const std::function<void(CallbackUpdatePtr)>& Start, std::chrono::steady_clock::time_point Deadline)
+	{
+		if(std::chrono::steady_clock::now() >= Deadline)
+			return false;
+
+		auto pPromise = std::make_shared<std::promise<bool>>();
+		auto Future = pPromise->get_future();
+		Start([pPromise](bool Updated) { pPromise->set_value(Updated); });
+		if(Future.wait_until(Deadline) != std::future_status::ready)
+			return false;
+		return Future.get();
+	}
+}
+
+CSqlIdAllocator& CSqlIdAllocator::Instance()
+{
+	static CSqlIdAllocator s_Instance;
+	return s_Instance;
+}
+
+void CSqlIdAllocator::Register(const char* pTable)
+{
+	bool CreateTable;
+	{
+		std::lock_guard Lock(m_Mutex);
+		if(m_Sequences.contains(pTable))
+			return;
+		CreateTable = m_Sequences.empty();
+		m_Sequences[pTable] = {};
+	}
+
+	// the whole registration shares one deadline, so a dead database does not hold the start for long
+	const auto Deadline = std::chrono::steady_clock::now() + RESERVE_WAIT_TIME;
+	if(CreateTable)
+	{
+		WaitFor([](CallbackUpdatePtr Callback)
+		{
+			Database->Execute<DB::OTHER>(std::move(Callback), "CREATE TABLE IF NOT EXISTS " TW_ID_SEQUENCES_TABLE " "
+				"(TableName VARCHAR(64) NOT NULL PRIMARY KEY, NextID INT NOT NULL DEFAULT 1)");
+		}, Deadline);
+	}
+
+	// the sequence never goes below the existing rows, rows may have been inserted without the allocator
+	const std::string Table(pTable);
+	WaitFor([&Table](CallbackUpdatePtr Callback)
+	{
+		Database->Execute<DB::OTHER>(std::move(Callback), "INSERT INTO " TW_ID_SEQUENCES_TABLE " (TableName, NextID) "
+			"SELECT '{}', COALESCE(MAX(ID), 0) + 1 FROM {} ON DUPLICATE KEY UPDATE NextID = GREATEST(NextID, VALUES(NextID))", Table, Table);
+	}, Deadline);
+
+	if(!ReserveBlocking(pTable, Deadline))
+		dbg_msg("sql_id", "failed to reserve the initial id block for '%s'", pTable);
+
+	// the second block is there before the first one runs out
+	StartRefill(Table);
+}
+
+int CSqlIdAllocator::Next(const char* pTable)
+{
+	const std::string Table(pTable);
+	int ID = -1;
+	bool Refill = false;
+	{
+		std::lock_guard Lock(m_Mutex);
+		auto it = m_Sequences.find(Table);
+		dbg_assert(it != m_Sequences.end(), "id allocator used for unregistered table");
+
+		auto& Sequence = it->second;
+		if(!Sequence.m_vRanges.empty())
+		{
+			auto& Range = Sequence.m_vRanges.front();
+			ID = Range.m_First++;
+			if(Range.m_First >= Range.m_End)
+				Sequence.m_vRanges.pop_front();
+			Sequence.m_Available--;
+		}
+
+		// refill once less than a whole block is left, the database has a full block of time to answer
+		Refill = Sequence.m_Available < g_Config.m_SvSqlIdBlockSize && !Sequence.m_Refilling;
+	}
+
+	// outside the lock, the queue may block and the callbacks lock again
+	if(Refill)
+		StartRefill(Table);
+	if(ID < 0)
+		dbg_msg("sql_id", "id reserve for '%s' is exhausted", pTable);
+	return ID;
+}
+
+bool CSqlIdAllocator::ReserveBlocking(const std::string& Table, std::chrono::steady_clock::time_point Deadline)
+{
+	const int BlockSize = g_Config.m_SvSqlIdBlockSize;
+	for(int Attempt = 0; Attempt < MAX_RESERVE_ATTEMPTS && std::chrono::steady_clock::now() < Deadline; Attempt++)
+	{
+		ResultPtr pRes = Database->Execute<DB::SELECT>("NextID", TW_ID_SEQUENCES_TABLE, "WHERE TableName = '{}'", Table);
+		if(!pRes->next())
+			return false;
+
+		// another process may have taken the same block, then the update does not match
+		const int First = pRes->getInt("NextID");
+		const bool Reserved = WaitFor([&](CallbackUpdatePtr Callback)
+		{
+			Database->Execute<DB::UPDATE>(std::move(Callback), TW_ID_SEQUENCES_TABLE,
+				"NextID = '{}' WHERE TableName = '{}' AND NextID = '{}'", First + BlockSize, Table, First);
+		}, Deadline);
+		if(Reserved)
+		{
+			AddRange(Table, First, First + BlockSize);
+			return true;
+		}
+	}
+	return false;
+}
+
+void CSqlIdAllocator::StartRefill(const std::string& Table)
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+		auto& Sequence = m_Sequences[Table];
+		if(Sequence.m_Refilling)
+			return;
+		Sequence.m_Refilling = true;
+	}
+	ReserveAsync(Table, 0);
+}
+
+void CSqlIdAllocator::ReserveAsync(const std::string& Table, int Attempt)
+{
+	if(Attempt >= MAX_RESERVE_ATTEMPTS)
+	{
+		dbg_msg("sql_id", "background id reservation for '%s' failed", Table.c_str());
+		std::lock_guard Lock(m_Mutex);
+		m_Sequences[Table].m_Refilling = false;
+		return;
+	}
+
+	const auto pSelect = Database->Prepare<DB::SELECT>("NextID", TW_ID_SEQUENCES_TABLE, "WHERE TableName = '{}'", Table);
+	pSelect->AtExecute([this, Table, Attempt](ResultPtr pRes)
+	{
+		if(!pRes->next())
+		{
+			ReserveAsync(Table, MAX_RESERVE_ATTEMPTS);
+			return;
+		}
+
+		const int BlockSize = g_Config.m_SvSqlIdBlockSize;
+		const int First = pRes->getInt("NextID");
+		Database->Execute<DB::UPDATE>([this, Table, Attempt, First, BlockSize](bool Updated)
+		{
+			if(!Updated)
+			{
+				ReserveAsync(Table, Attempt + 1);
+				return;
+			}
+
+			AddRange(Table, First, First + BlockSize);
+			std::lock_guard Lock(m_Mutex);
+			m_Sequences[Table].m_Refilling = false;
+		}, TW_ID_SEQUENCES_TABLE, "NextID = '{}' WHERE TableName = '{}' AND NextID = '{}'", First + BlockSize, Table, First);
+	});
+}
+
+void CSqlIdAllocator::AddRange(const std::string& Table, int First, int End)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto& Sequence = m_Sequences[Table];
+	Sequence.m_vRanges.push_back({ First, End });
+	Sequence.m_Available += End - First;
+}
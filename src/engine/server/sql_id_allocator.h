@@ -0,0 +1,59 @@
+#ifndef ENGINE_SERVER_SQL_ID_ALLOCATOR_H
+#define ENGINE_SERVER_SQL_ID_ALLOCATOR_H
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#define TW_ID_SEQUENCES_TABLE "tw_id_sequences"
+
+/**
+ * @class CSqlIdAllocator
+ * @brief Hands out primary keys from ID blocks reserved in the sequence table.
+ *
+ * Blocks are reserved with a compare-and-swap UPDATE on `tw_id_sequences`, so several
+ * processes can share one database. The first block of a table is reserved on Register(),
+ * further blocks are reserved in the background so up to two blocks are kept locally.
+ */
+class CSqlIdAllocator
+{
+public:
+	static CSqlIdAllocator& Instance();
+
+	// Blocking for at most 10 seconds, call once at startup. Seeds the sequence from MAX(ID) of the table.
+	void Register(const char* pTable);
+
+	// Never blocks, it runs on the game tick. Returns -1 while the reserve is empty,
+	// a background reservation is started then and the caller may try again later.
+	int Next(const char* pTable);
+
+private:
+	struct CRange
+	{
+		int m_First;
+		int m_End;
+	};
+
+	struct CSequence
+	{
+		std::deque<CRange> m_vRanges {};
+		int m_Available {};
+		bool m_Refilling {};
+	};
+
+	CSqlIdAllocator() = default;
+
+	bool ReserveBlocking(const std::string& Table, std::chrono::steady_clock::time_point Deadline);
+	void StartRefill(const std::string& Table);
+	void ReserveAsync(const std::string& Table, int Attempt);
+	void AddRange(const std::string& Table, int First, int End);
+
+	std::unordered_map<std::string, CSequence> m_Sequences;
+	std::mutex m_Mutex;
+};
+
+#define IdAllocator (&CSqlIdAllocator::Instance())
+
+#endif // ENGINE_SERVER_SQL_ID_ALLOCATOR_H
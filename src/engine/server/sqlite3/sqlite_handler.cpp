@@ -0,0 +1,773 @@
+#include <base/system.h>
+#include "sqlite_handler.h"
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <initializer_list>
+
+namespace
+{
+	constexpr auto npos = std::string_view::npos;
+
+	bool IsWordChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	size_t SkipSpaces(std::string_view s, size_t i)
+	{
+		while(i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\n' || s[i] == '\r'))
+			i++;
+		return i;
+	}
+
+	size_t WordEnd(std::string_view s, size_t i)
+	{
+		while(i < s.size() && IsWordChar(s[i]))
+			i++;
+		return i;
+	}
+
+	std::string_view Trim(std::string_view s)
+	{
+		const size_t Start = SkipSpaces(s, 0);
+		size_t End = s.size();
+		while(End > Start && (s[End - 1] == ' ' || s[End - 1] == '\t' || s[End - 1] == '\n' || s[End - 1] == '\r'))
+			End--;
+		return s.substr(Start, End - Start);
+	}
+
+	// matches a whole word case-insensitively at i
+	bool IsWord(std::string_view s, size_t i, std::string_view Word, size_t* pEnd = nullptr)
+	{
+		const size_t End = WordEnd(s, i);
+		if(End - i != Word.size() || str_comp_nocase_num(s.data() + i, Word.data(), (int)Word.size()) != 0)
+			return false;
+
+		if(pEnd)
+			*pEnd = End;
+		return true;
+	}
+
+	// matches a sequence of words separated by whitespace
+	bool IsWords(std::string_view s, size_t i, std::initializer_list<std::string_view> Words, size_t* pEnd)
+	{
+		for(const auto& Word : Words)
+		{
+			if(!IsWord(s, SkipSpaces(s, i), Word, &i))
+				return false;
+		}
+
+		*pEnd = i;
+		return true;
+	}
+
+	bool IsCall(std::string_view s, size_t End)
+	{
+		End = SkipSpaces(s, End);
+		return End < s.size() && s[End] == '(';
+	}
+
+	// copies a quoted literal as a SQLite string, MySQL escapes with backslashes
+	size_t CopyLiteral(std::string_view s, size_t i, std::string& Out)
+	{
+		const char Quote = s[i++];
+		Out += '\'';
+		while(i < s.size())
+		{
+			const char c = s[i];
+			if(c == '\\' && i + 1 < s.size())
+			{
+				char Escaped = s[i + 1];
+				switch(Escaped)
+				{
+				case 'n': Escaped = '\n'; break;
+				case 'r': Escaped = '\r'; break;
+				case 't': Escaped = '\t'; break;
+				case 'Z': Escaped = '\x1a'; break;
+				case '0': Escaped = '\0'; break;
+				default: break;
+				}
+
+				if(Escaped == '\'')
+					Out += "''";
+				else if(Escaped != '\0')
+					Out += Escaped;
+				i += 2;
+				continue;
+			}
+
+			if(c == Quote)
+			{
+				if(i + 1 < s.size() && s[i + 1] == Quote)
+				{
+					Out += Quote == '\'' ? "''" : "\"";
+					i += 2;
+					continue;
+				}
+
+				i++;
+				break;
+			}
+
+			if(c == '\'')
+				Out += "''";
+			else
+				Out += c;
+			i++;
+		}
+		Out += '\'';
+		return i;
+	}
+
+	// '42' as 42, so MAX, MIN and expressions compare numbers the way MySQL converts them,
+	// columns still apply their own affinity when the value is compared or stored
+	bool IsIntegerLiteral(std::string_view s, size_t i)
+	{
+		const char Quote = s[i++];
+		const size_t Start = i;
+		if(i < s.size() && s[i] == '-')
+			i++;
+		const size_t Digits = i;
+		while(i < s.size() && s[i] >= '0' && s[i] <= '9')
+			i++;
+
+		const size_t NumDigits = i - Digits;
+		return i < s.size() && s[i] == Quote && NumDigits > 0 && NumDigits <= 18
+			&& (s[Digits] != '0' || NumDigits == 1) && !(NumDigits == 1 && s[Digits] == '0' && Digits != Start);
+	}
+
+	size_t CopyIdentifier(std::string_view s, size_t i, std::string& Out)
+	{
+		const size_t Close = s.find('`', i + 1);
+		const size_t End = Close == npos ? s.size() : Close + 1;
+		Out.append(s.substr(i, End - i));
+		return End;
+	}
+
+	// position after the parenthesis matching the one at Open
+	size_t SkipParens(std::string_view s, size_t Open)
+	{
+		std::string Ignored;
+		int Depth = 0;
+		size_t i = Open;
+		while(i < s.size())
+		{
+			const char c = s[i];
+			if(c == '\'' || c == '"')
+			{
+				i = CopyLiteral(s, i, Ignored);
+				continue;
+			}
+			if(c == '`')
+			{
+				i = CopyIdentifier(s, i, Ignored);
+				continue;
+			}
+
+			i++;
+			if(c == '(')
+				Depth++;
+			else if(c == ')' && --Depth == 0)
+				break;
+		}
+		return i;
+	}
+
+	size_t FindLastWord(std::string_view s, std::string_view Word)
+	{
+		size_t Found = npos;
+		for(size_t i = 0; i < s.size(); i++)
+		{
+			if((i == 0 || !IsWordChar(s[i - 1])) && IsWord(s, i, Word))
+				Found = i;
+		}
+		return Found;
+	}
+
+	// SQLite can't tell an upsert from a join constraint after INSERT ... SELECT ... FROM without a WHERE,
+	// only the outer SELECT counts, subqueries in parentheses have their own
+	bool NeedsWhereBeforeUpsert(std::string_view Query)
+	{
+		if(!IsWord(Query, SkipSpaces(Query, 0), "INSERT"))
+			return false;
+
+		std::string Ignored;
+		bool Select = false;
+		bool Where = false;
+		int Depth = 0;
+		size_t i = 0;
+		while(i < Query.size())
+		{
+			const char c = Query[i];
+			if(c == '\'' || c == '"')
+			{
+				i = CopyLiteral(Query, i, Ignored);
+				continue;
+			}
+			if(c == '`')
+			{
+				i = CopyIdentifier(Query, i, Ignored);
+				continue;
+			}
+			if(Depth == 0 && IsWordChar(c) && (i == 0 || !IsWordChar(Query[i - 1])))
+			{
+				if(IsWord(Query, i, "SELECT"))
+				{
+					Select = true;
+					Where = false;
+				}
+				else if(IsWord(Query, i, "WHERE"))
+					Where = true;
+				i = WordEnd(Query, i);
+				continue;
+			}
+
+			if(c == '(')
+				Depth++;
+			else if(c == ')')
+				Depth--;
+			i++;
+		}
+		return Select && !Where;
+	}
+
+	std::string Translate(std::string_view s, bool ColumnDefinition)
+	{
+		std::string Out;
+		Out.reserve(s.size() + 32);
+
+		bool Upsert = false;
+		size_t i = 0;
+		while(i < s.size())
+		{
+			const char c = s[i];
+			if(c == '\'' && IsIntegerLiteral(s, i))
+			{
+				const size_t Close = s.find('\'', i + 1);
+				Out.append(s.substr(i + 1, Close - i - 1));
+				i = Close + 1;
+				continue;
+			}
+			if(c == '\'' || c == '"')
+			{
+				i = CopyLiteral(s, i, Out);
+				continue;
+			}
+			if(c == '`')
+			{
+				i = CopyIdentifier(s, i, Out);
+				continue;
+			}
+			if(!IsWordChar(c) || (i > 0 && IsWordChar(s[i - 1])))
+			{
+				Out += c;
+				i++;
+				continue;
+			}
+
+			size_t End = WordEnd(s, i);
+			if(IsWords(s, i, { "ON", "DUPLICATE", "KEY", "UPDATE" }, &End))
+			{
+				if(NeedsWhereBeforeUpsert(Out))
+					Out += "WHERE true ";
+				Out += "ON CONFLICT DO UPDATE SET";
+				Upsert = true;
+			}
+			else if(IsWords(s, i, { "INSERT", "IGNORE" }, &End))
+			{
+				Out += "INSERT OR IGNORE";
+			}
+			else if(Upsert && IsWord(s, i, "VALUES") && IsCall(s, End))
+			{
+				// VALUES(Column) is the row that failed to insert
+				const size_t Open = s.find('(', End);
+				const size_t Close = s.find(')', Open);
+				if(Close == npos)
+				{
+					Out.append(s.substr(i));
+					break;
+				}
+				Out += "excluded.";
+				Out.append(Trim(s.substr(Open + 1, Close - Open - 1)));
+				End = Close + 1;
+			}
+			else if(IsWord(s, i, "IF") && IsCall(s, End))
+				Out += "IIF";
+			else if(IsWord(s, i, "GREATEST") && IsCall(s, End))
+				Out += "MAX";
+			else if(IsWord(s, i, "LEAST") && IsCall(s, End))
+				Out += "MIN";
+			else if(IsWord(s, i, "CURRENT_TIMESTAMP") && IsCall(s, End))
+			{
+				Out += "CURRENT_TIMESTAMP";
+				End = SkipParens(s, s.find('(', End));
+			}
+			else if(ColumnDefinition && (IsWord(s, i, "unsigned") || IsWord(s, i, "zerofill") || IsWord(s, i, "AUTO_INCREMENT")))
+			{
+				// no equivalent, integer primary keys count up by themselves
+			}
+			else if(ColumnDefinition && (IsWords(s, i, { "CHARACTER", "SET" }, &End) || IsWord(s, i, "COLLATE")))
+			{
+				End = WordEnd(s, SkipSpaces(s, End));
+			}
+			else if(ColumnDefinition && IsWord(s, i, "COMMENT"))
+			{
+				std::string Ignored;
+				const size_t Literal = SkipSpaces(s, End);
+				if(Literal < s.size() && (s[Literal] == '\'' || s[Literal] == '"'))
+					End = CopyLiteral(s, Literal, Ignored);
+			}
+			else if(ColumnDefinition && IsWords(s, i, { "ON", "UPDATE" }, &End))
+			{
+				End = WordEnd(s, SkipSpaces(s, End));
+				if(IsCall(s, End))
+					End = SkipParens(s, s.find('(', End));
+			}
+			else if(ColumnDefinition && IsWord(s, i, "CHECK") && IsCall(s, End))
+			{
+				// MariaDB checks json columns with its own more lenient parser
+				End = SkipParens(s, s.find('(', End));
+			}
+			else if(ColumnDefinition && (IsWord(s, i, "enum") || IsWord(s, i, "set")) && IsCall(s, End))
+			{
+				Out += "TEXT";
+				End = SkipParens(s, s.find('(', End));
+			}
+			else
+			{
+				Out.append(s.substr(i, End - i));
+			}
+			i = End;
+		}
+
+		return Out;
+	}
+
+	// splits on top level commas, outside of parentheses and literals
+	std::vector<std::string_view> SplitList(std::string_view s)
+	{
+		std::vector<std::string_view> vItems;
+		std::string Ignored;
+		int Depth = 0;
+		size_t Start = 0;
+		size_t i = 0;
+		while(i < s.size())
+		{
+			const char c = s[i];
+			if(c == '\'' || c == '"')
+			{
+				i = CopyLiteral(s, i, Ignored);
+				continue;
+			}
+			if(c == '`')
+			{
+				i = CopyIdentifier(s, i, Ignored);
+				continue;
+			}
+
+			if(c == '(')
+				Depth++;
+			else if(c == ')')
+				Depth--;
+			else if(c == ',' && Depth == 0)
+			{
+				vItems.push_back(Trim(s.substr(Start, i - Start)));
+				Start = i + 1;
+			}
+			i++;
+		}
+
+		if(!Trim(s.substr(Start)).empty())
+			vItems.push_back(Trim(s.substr(Start)));
+		return vItems;
+	}
+
+	// splits a dump into statements, dropping comments and conditional comments
+	std::vector<std::string> SplitStatements(std::string_view s)
+	{
+		std::vector<std::string> vStatements;
+		std::string Current;
+		size_t i = 0;
+		while(i < s.size())
+		{
+			const char c = s[i];
+			if(c == '\'' || c == '"')
+			{
+				// kept as written, translated later with the statement
+				const size_t Start = i;
+				std::string Ignored;
+				i = CopyLiteral(s, i, Ignored);
+				Current.append(s.substr(Start, i - Start));
+				continue;
+			}
+			if(c == '`')
+			{
+				i = CopyIdentifier(s, i, Current);
+				continue;
+			}
+			if(c == '-' && s.substr(i, 2) == "--")
+			{
+				const size_t Line = s.find('\n', i);
+				i = Line == npos ? s.size() : Line + 1;
+				continue;
+			}
+			if(c == '/' && s.substr(i, 2) == "/*")
+			{
+				const size_t Close = s.find("*/", i + 2);
+				i = Close == npos ? s.size() : Close + 2;
+				continue;
+			}
+			if(c == ';')
+			{
+				if(!Trim(Current).empty())
+					vStatements.emplace_back(Trim(Current));
+				Current.clear();
+				i++;
+				continue;
+			}
+
+			Current += c;
+			i++;
+		}
+
+		if(!Trim(Current).empty())
+			vStatements.emplace_back(Trim(Current));
+		return vStatements;
+	}
+
+	std::string FirstIdentifier(std::string_view s)
+	{
+		const size_t Open = s.find('`');
+		const size_t Close = Open == npos ? npos : s.find('`', Open + 1);
+		return Close == npos ? std::string() : std::string(s.substr(Open + 1, Close - Open - 1));
+	}
+
+	// names of a column list like (`A`, `B`(191)), prefix lengths are dropped
+	std::vector<std::string> ColumnList(std::string_view s)
+	{
+		std::vector<std::string> vColumns;
+		const size_t Open = s.find('(');
+		if(Open == npos)
+			return vColumns;
+
+		const auto List = s.substr(Open + 1, SkipParens(s, Open) - Open - 2);
+		for(const auto& Item : SplitList(List))
+			vColumns.push_back(FirstIdentifier(Item));
+		return vColumns;
+	}
+
+	std::string JoinColumns(const std::vector<std::string>& vColumns)
+	{
+		std::string Out;
+		for(const auto& Column : vColumns)
+			Out += (Out.empty() ? "`" : ", `") + Column + "`";
+		return Out;
+	}
+
+	struct CDumpTable
+	{
+		struct CIndex
+		{
+			std::string m_Name;
+			std::vector<std::string> m_vColumns;
+			bool m_Unique;
+		};
+
+		struct CForeignKey
+		{
+			std::vector<std::string> m_vColumns;
+			std::string m_RefTable;
+			std::vector<std::string> m_vRefColumns;
+			std::string m_Actions;
+		};
+
+		std::string m_Name;
+		std::vector<std::string> m_vColumnNames;
+		std::vector<std::string> m_vColumns;
+		std::vector<bool> m_vIntegerColumns;
+		std::vector<std::string> m_vPrimaryKey;
+		std::vector<CIndex> m_vIndexes;
+		std::vector<CForeignKey> m_vForeignKeys;
+
+		// PRIMARY KEY, KEY, UNIQUE KEY and CONSTRAINT clauses of CREATE TABLE and ALTER TABLE
+		void AddKey(std::string_view Clause)
+		{
+			size_t End;
+			if(IsWords(Clause, 0, { "PRIMARY", "KEY" }, &End))
+				m_vPrimaryKey = ColumnList(Clause.substr(End));
+			else if(IsWords(Clause, 0, { "UNIQUE", "KEY" }, &End) || IsWords(Clause, 0, { "UNIQUE", "INDEX" }, &End))
+				m_vIndexes.push_back({ FirstIdentifier(Clause.substr(End)), ColumnList(Clause.substr(End)), true });
+			else if(IsWord(Clause, 0, "KEY", &End) || IsWord(Clause, 0, "INDEX", &End))
+				m_vIndexes.push_back({ FirstIdentifier(Clause.substr(End)), ColumnList(Clause.substr(End)), false });
+			else if(IsWord(Clause, 0, "CONSTRAINT"))
+			{
+				const size_t Foreign = FindLastWord(Clause, "FOREIGN");
+				const size_t References = FindLastWord(Clause, "REFERENCES");
+				if(Foreign == npos || References == npos)
+					return;
+
+				CForeignKey Key;
+				Key.m_vColumns = ColumnList(Clause.substr(Foreign, References - Foreign));
+				const auto Target = Clause.substr(References);
+				Key.m_RefTable = FirstIdentifier(Target);
+				Key.m_vRefColumns = ColumnList(Target);
+				const size_t Open = Target.find('(');
+				if(Open != npos)
+					Key.m_Actions = std::string(Trim(Target.substr(SkipParens(Target, Open))));
+				m_vForeignKeys.push_back(std::move(Key));
+			}
+		}
+
+		bool IsUnique(const std::vector<std::string>& vColumns) const
+		{
+			if(vColumns == m_vPrimaryKey)
+				return true;
+			for(const auto& Index : m_vIndexes)
+			{
+				if(Index.m_Unique && Index.m_vColumns == vColumns)
+					return true;
+			}
+			return false;
+		}
+	};
+
+	void ParseCreateTable(std::string_view Statement, CDumpTable& Table)
+	{
+		const size_t Open = Statement.find('(');
+		if(Open == npos)
+			return;
+
+		const auto Body = Statement.substr(Open + 1, SkipParens(Statement, Open) - Open - 2);
+		for(const auto& Item : SplitList(Body))
+		{
+			if(Item.empty() || Item[0] != '`')
+			{
+				Table.AddKey(Item);
+				continue;
+			}
+
+			// MySQL compares text case-insensitively unless the collation is binary
+			const size_t NameEnd = Item.find('`', 1);
+			const size_t TypeStart = SkipSpaces(Item, NameEnd + 1);
+			const auto Type = Item.substr(TypeStart, WordEnd(Item, TypeStart) - TypeStart);
+			const bool Integer = str_comp_nocase_num(Type.data(), "int", 3) == 0 || str_comp_nocase_num(Type.data(), "bigint", 6) == 0
+				|| str_comp_nocase_num(Type.data(), "tinyint", 7) == 0 || str_comp_nocase_num(Type.data(), "smallint", 8) == 0
+				|| str_comp_nocase_num(Type.data(), "mediumint", 9) == 0;
+			const bool Text = Type.find("char") != npos || Type.find("text") != npos || Type.find("CHAR") != npos
+				|| Type.find("TEXT") != npos || IsWord(Type, 0, "enum") || IsWord(Type, 0, "set");
+
+			std::string Column = Translate(Item, true);
+			if(Text && Item.find("_bin") == npos)
+				Column += " COLLATE NOCASE";
+
+			Table.m_vColumnNames.emplace_back(Item.substr(1, NameEnd - 1));
+			Table.m_vColumns.push_back(std::move(Column));
+			Table.m_vIntegerColumns.push_back(Integer);
+		}
+	}
+
+	std::string BuildCreateTable(const CDumpTable& Table, const std::vector<CDumpTable>& vTables)
+	{
+		std::vector<std::string> vItems = Table.m_vColumns;
+		bool RowidKey = false;
+		if(Table.m_vPrimaryKey.size() == 1)
+		{
+			// a single integer key becomes the rowid, so inserts without an ID still count up
+			for(size_t i = 0; i < Table.m_vColumnNames.size(); i++)
+			{
+				if(Table.m_vColumnNames[i] == Table.m_vPrimaryKey[0] && Table.m_vIntegerColumns[i])
+				{
+					vItems[i] = "`" + Table.m_vColumnNames[i] + "` INTEGER PRIMARY KEY";
+					RowidKey = true;
+				}
+			}
+		}
+		if(!RowidKey && !Table.m_vPrimaryKey.empty())
+			vItems.push_back("PRIMARY KEY (" + JoinColumns(Table.m_vPrimaryKey) + ")");
+
+		// SQLite rejects every write to a table whose foreign key doesn't point at a unique key
+		for(const auto& Key : Table.m_vForeignKeys)
+		{
+			const auto it = std::find_if(vTables.begin(), vTables.end(), [&](const CDumpTable& Other) { return Other.m_Name == Key.m_RefTable; });
+			if(it == vTables.end() || !it->IsUnique(Key.m_vRefColumns))
+			{
+				dbg_msg("sqlite", "skipping foreign key of '%s' to '%s', it isn't a unique key.", Table.m_Name.c_str(), Key.m_RefTable.c_str());
+				continue;
+			}
+
+			vItems.push_back("FOREIGN KEY (" + JoinColumns(Key.m_vColumns) + ") REFERENCES `" + Key.m_RefTable + "` ("
+				+ JoinColumns(Key.m_vRefColumns) + ") " + Key.m_Actions);
+		}
+
+		std::string Out = "CREATE TABLE `" + Table.m_Name + "` (\n";
+		for(size_t i = 0; i < vItems.size(); i++)
+			Out += "  " + vItems[i] + (i + 1 < vItems.size() ? ",\n" : "\n");
+		Out += ")";
+		return Out;
+	}
+}
+
+namespace sqlitedb
+{
+	Handler::Handler(const char* pDatabaseFilePath)
+	{
+		if(sqlite3_open_v2(pDatabaseFilePath, &m_pDB, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK)
+		{
+			dbg_msg("sqlite", "can't open database '%s': %s", pDatabaseFilePath, sqlite3_errmsg(m_pDB));
+			sqlite3_close(m_pDB);
+			m_pDB = nullptr;
+			return;
+		}
+
+		// readers run next to the writer, writers wait for each other instead of failing
+		sqlite3_busy_timeout(m_pDB, 5000);
+		sqlite3_exec(m_pDB, "PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL; PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
+	}
+
+	Handler::~Handler()
+	{
+		sqlite3_close(m_pDB);
+	}
+
+	const char* Handler::GetError() const
+	{
+		return m_pDB ? sqlite3_errmsg(m_pDB) : "database is not open";
+	}
+
+	StatementPtr Handler::Select(const std::string& Query)
+	{
+		if(!m_pDB)
+			return nullptr;
+
+		const std::string Translated = TranslateQuery(Query);
+		sqlite3_stmt* pStmt = nullptr;
+		if(sqlite3_prepare_v2(m_pDB, Translated.c_str(), -1, &pStmt, nullptr) != SQLITE_OK)
+			return nullptr;
+
+		int Result = SQLITE_OK;
+		auto pStatement = std::make_unique<Statement>(pStmt, &Result);
+		sqlite3_finalize(pStmt);
+		return Result == SQLITE_DONE ? std::move(pStatement) : nullptr;
+	}
+
+	int Handler::Execute(const std::string& Query)
+	{
+		if(!m_pDB)
+			return -1;
+
+		const std::string Translated = TranslateQuery(Query);
+		const int ChangesBefore = sqlite3_total_changes(m_pDB);
+		const char* pTail = Translated.c_str();
+		while(*pTail)
+		{
+			sqlite3_stmt* pStmt = nullptr;
+			if(sqlite3_prepare_v2(m_pDB, pTail, -1, &pStmt, &pTail) != SQLITE_OK)
+				return -1;
+			if(!pStmt)
+				continue;
+
+			int Result;
+			while((Result = sqlite3_step(pStmt)) == SQLITE_ROW)
+				;
+			sqlite3_finalize(pStmt);
+			if(Result != SQLITE_DONE)
+				return -1;
+		}
+		return sqlite3_total_changes(m_pDB) - ChangesBefore;
+	}
+
+	bool Handler::HasTables()
+	{
+		const auto pResult = Select("SELECT COUNT(*) AS Num FROM sqlite_master WHERE type = 'table'");
+		return pResult && pResult->next() && pResult->getInt("Num") > 0;
+	}
+
+	bool Handler::ImportMySqlDump(std::string_view Dump)
+	{
+		if(!m_pDB)
+			return false;
+
+		// tables are created last, MySQL dumps add the keys with ALTER TABLE after the rows
+		std::vector<CDumpTable> vTables;
+		std::vector<std::string> vInserts;
+		const auto FindTable = [&vTables](const std::string& Name) -> CDumpTable*
+		{
+			auto it = std::find_if(vTables.begin(), vTables.end(), [&](const CDumpTable& Table) { return Table.m_Name == Name; });
+			return it != vTables.end() ? &*it : nullptr;
+		};
+
+		for(const auto& Statement : SplitStatements(Dump))
+		{
+			size_t End;
+			if(IsWords(Statement, 0, { "CREATE", "TABLE" }, &End))
+			{
+				CDumpTable Table;
+				Table.m_Name = FirstIdentifier(std::string_view(Statement).substr(End));
+				ParseCreateTable(Statement, Table);
+				vTables.push_back(std::move(Table));
+			}
+			else if(IsWord(Statement, 0, "INSERT"))
+			{
+				vInserts.push_back(TranslateQuery(Statement));
+			}
+			else if(IsWords(Statement, 0, { "ALTER", "TABLE" }, &End))
+			{
+				const auto Rest = std::string_view(Statement).substr(End);
+				CDumpTable* pTable = FindTable(FirstIdentifier(Rest));
+				if(!pTable)
+					continue;
+
+				for(const auto& Clause : SplitList(Rest.substr(Rest.find('`', Rest.find('`') + 1) + 1)))
+				{
+					size_t ClauseEnd;
+					if(IsWord(Clause, 0, "ADD", &ClauseEnd))
+						pTable->AddKey(Trim(Clause.substr(ClauseEnd)));
+				}
+			}
+		}
+
+		const auto Exec = [this](const std::string& Query)
+		{
+			char* pError = nullptr;
+			if(sqlite3_exec(m_pDB, Query.c_str(), nullptr, nullptr, &pError) == SQLITE_OK)
+				return true;
+
+			dbg_msg("sqlite", "import failed: %s. Query: %.256s", pError ? pError : "", Query.c_str());
+			sqlite3_free(pError);
+			return false;
+		};
+
+		// rows are inserted before the tables they point at
+		Exec("PRAGMA foreign_keys = OFF");
+		bool Success = Exec("BEGIN");
+		for(const auto& Table : vTables)
+			Success = Success && Exec(BuildCreateTable(Table, vTables));
+		for(const auto& Insert : vInserts)
+			Success = Success && Exec(Insert);
+		for(const auto& Table : vTables)
+		{
+			for(const auto& Index : Table.m_vIndexes)
+			{
+				Success = Success && Exec(std::string(Index.m_Unique ? "CREATE UNIQUE INDEX `" : "CREATE INDEX `") + Table.m_Name + "_"
+					+ Index.m_Name + "` ON `" + Table.m_Name + "` (" + JoinColumns(Index.m_vColumns) + ")");
+			}
+		}
+
+		if(Success)
+			Success = Exec("COMMIT");
+		else
+			Exec("ROLLBACK");
+		Exec("PRAGMA foreign_keys = ON");
+
+		if(Success)
+			dbg_msg("sqlite", "imported %d tables from the MySQL dump.", (int)vTables.size());
+		return Success;
+	}
+
+	std::string Handler::TranslateQuery(std::string_view Query)
+	{
+		return Translate(Query, false);
+	}
+}
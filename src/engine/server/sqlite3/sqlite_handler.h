@@ -3,111 +3,45 @@
 
 #include "sqlite_statement.h"
 
-/*
- * class
- */
-enum class DB;
+#include <string_view>
+
+struct sqlite3;
 
 namespace sqlitedb
 {
+	/*
+	 * Connection to the embedded database file, used instead of MySQL when
+	 * sv_sqlite_file is set. Components write their queries for MySQL, so every
+	 * query is translated to the SQLite dialect first. Each thread keeps its
+	 * own handler, SQLite serializes the writers through the WAL.
+	 */
 	class Handler
 	{
-		sqlite3* m_pDB;
+		sqlite3* m_pDB {};
 
 	public:
-		Handler(const char* pDatabaseFilePath)
-		{
-			if(sqlite3_open(pDatabaseFilePath, &m_pDB))
-			{
-				dbg_msg("sqlite", "can't open database: %s", sqlite3_errmsg(m_pDB));
-			}
-		}
+		explicit Handler(const char* pDatabaseFilePath);
+		~Handler();
 
-		~Handler()
-		{
-			sqlite3_close(m_pDB);
-		}
+		Handler(const Handler&) = delete;
+		Handler& operator=(const Handler&) = delete;
 
-	public:
-		template <DB T>
-		constexpr std::enable_if_t<T == DB::SELECT, ResultPtr> Execute(const char* pSelect, const char* pTable)
-		{
-			std::string query = fmt_default("SELECT {} FROM {};", pSelect, pTable);
-			sqlite3_stmt* stmt;
-			if(sqlite3_prepare_v2(m_pDB, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-			{
-				dbg_msg("sqlite", "Failed to prepare query: %s", sqlite3_errmsg(m_pDB));
-				return nullptr;
-			}
-			return std::make_unique<Statement>(stmt);
-		}
+		bool IsOpen() const { return m_pDB != nullptr; }
+		const char* GetError() const;
+
+		// returns nullptr if the query failed
+		StatementPtr Select(const std::string& Query);
+
+		// returns the number of changed rows or -1 if the query failed
+		int Execute(const std::string& Query);
 
-		template <DB T, typename... Ts>
-		constexpr std::enable_if_t<T == DB::SELECT, ResultPtr> Execute(const char* pSelect, const char* pTable, const char* pBuffer, Ts&&... args)
-		{
-			std::string strQuery = fmt_default(pBuffer, std::forward<Ts>(args)...);
-			std::string query = fmt_default("SELECT {} FROM {} {}", pSelect, pTable, strQuery);
-			sqlite3_stmt* stmt;
-			if(sqlite3_prepare_v2(m_pDB, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-			{
-				dbg_msg("sqlite", "Failed to prepare query: %s", sqlite3_errmsg(m_pDB));
-				return nullptr;
-			}
-			return std::make_unique<Statement>(stmt);
-		}
+		bool HasTables();
 
-		template<DB T, typename... Ts>
-		constexpr void Execute(const char* pTable, const char* pBuffer, Ts&&... args)
-		{
-			std::string strQuery = fmt_default(pBuffer, std::forward<Ts>(args)...);
+		// creates tables, rows and indexes from a phpMyAdmin dump of the MySQL database
+		bool ImportMySqlDump(std::string_view Dump);
 
-			if constexpr(T == DB::INSERT)
-			{
-				std::string query = fmt_default("INSERT INTO {} {};", pTable, strQuery);
-				sqlite3_stmt* stmt;
-				if(sqlite3_prepare_v2(m_pDB, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-				{
-					dbg_msg("sqlite", "Failed to prepare insert query: %s", sqlite3_errmsg(m_pDB));
-					return;
-				}
-				if(sqlite3_step(stmt) != SQLITE_DONE)
-				{
-					dbg_msg("sqlite", "Failed to execute insert query: %s", sqlite3_errmsg(m_pDB));
-				}
-				sqlite3_finalize(stmt);
-			}
-			else if constexpr(T == DB::UPDATE)
-			{
-				std::string query = fmt_default("UPDATE {} SET {};", pTable, strQuery);
-				sqlite3_stmt* stmt;
-				if(sqlite3_prepare_v2(m_pDB, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-				{
-					dbg_msg("sqlite", "Failed to prepare update query: %s", sqlite3_errmsg(m_pDB));
-					return;
-				}
-				if(sqlite3_step(stmt) != SQLITE_DONE)
-				{
-					dbg_msg("sqlite", "Failed to execute update query: %s", sqlite3_errmsg(m_pDB));
-				}
-				sqlite3_finalize(stmt);
-			}
-			else if constexpr(T == DB::REMOVE)
-			{
-				std::string query = fmt_default("DELETE FROM {} WHERE {}; ", pTable, strQuery);
-				sqlite3_stmt* stmt;
-				if(sqlite3_prepare_v2(m_pDB, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
-				{
-					dbg_msg("sqlite", "Failed to prepare remove query: %s", sqlite3_errmsg(m_pDB));
-					return;
-				}
-				if(sqlite3_step(stmt) != SQLITE_DONE)
-				{
-					dbg_msg("sqlite", "Failed to execute remove query: %s", sqlite3_errmsg(m_pDB));
-				}
-				sqlite3_finalize(stmt);
-			}
-		}
+		static std::string TranslateQuery(std::string_view Query);
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,74 @@
+#include <base/system.h>
+#include "sqlite_statement.h"
+
+#include <sqlite3.h>
+
+#include <cstdlib>
+
+namespace sqlitedb
+{
+	Statement::Statement(sqlite3_stmt* pStmt, int* pResult)
+	{
+		const int NumColumns = sqlite3_column_count(pStmt);
+		m_vColumns.reserve(NumColumns);
+		for(int i = 0; i < NumColumns; i++)
+			m_vColumns.emplace_back(sqlite3_column_name(pStmt, i));
+
+		int Result;
+		while((Result = sqlite3_step(pStmt)) == SQLITE_ROW)
+		{
+			for(int i = 0; i < NumColumns; i++)
+			{
+				// null reads as empty and zero, like the MySQL connector does
+				const auto* pText = reinterpret_cast<const char*>(sqlite3_column_text(pStmt, i));
+				if(pText)
+					m_vValues.emplace_back(pText, sqlite3_column_bytes(pStmt, i));
+				else
+					m_vValues.emplace_back();
+			}
+			m_NumRows++;
+		}
+
+		if(pResult)
+			*pResult = Result;
+	}
+
+	const std::string* Statement::getValue(const char* pColumnName) const
+	{
+		if(m_CurrentRow == 0 || m_CurrentRow > m_NumRows)
+			return nullptr;
+
+		for(size_t i = 0; i < m_vColumns.size(); i++)
+		{
+			if(str_comp_nocase(m_vColumns[i].c_str(), pColumnName) == 0)
+				return &m_vValues[(m_CurrentRow - 1) * m_vColumns.size() + i];
+		}
+
+		dbg_msg("sqlite", "column '%s' can't founded.", pColumnName);
+		return nullptr;
+	}
+
+	int64_t Statement::getInt64(const char* pColumnName) const
+	{
+		const auto* pValue = getValue(pColumnName);
+		return pValue ? std::strtoll(pValue->c_str(), nullptr, 10) : 0;
+	}
+
+	uint64_t Statement::getUInt64(const char* pColumnName) const
+	{
+		const auto* pValue = getValue(pColumnName);
+		return pValue ? std::strtoull(pValue->c_str(), nullptr, 10) : 0;
+	}
+
+	double Statement::getDouble(const char* pColumnName) const
+	{
+		const auto* pValue = getValue(pColumnName);
+		return pValue ? std::strtod(pValue->c_str(), nullptr) : 0.0;
+	}
+
+	std::string Statement::getString(const char* pColumnName) const
+	{
+		const auto* pValue = getValue(pColumnName);
+		return pValue ? *pValue : std::string();
+	}
+}
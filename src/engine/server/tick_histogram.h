@@ -0,0 +1,78 @@
+#ifndef ENGINE_SERVER_TICK_HISTOGRAM_H
+#define ENGINE_SERVER_TICK_HISTOGRAM_H
+
+#include <base/math.h>
+#include <base/system.h>
+
+#include <cstdint>
+
+/*
+ * Fixed size histogram of durations in nanoseconds with power of two buckets,
+ * cheap enough to be filled every tick. Percentiles are upper bucket bounds.
+ */
+class CTickHistogram
+{
+public:
+	enum
+	{
+		NUM_BUCKETS = 40,
+	};
+
+private:
+	uint64_t m_aBuckets[NUM_BUCKETS] {};
+	uint64_t m_Count {};
+	uint64_t m_Sum {};
+	uint64_t m_Max {};
+
+	static int Bucket(uint64_t Value)
+	{
+		int Index = 0;
+		while(Value > 1 && Index < NUM_BUCKETS - 1)
+		{
+			Value >>= 1;
+			Index++;
+		}
+		return Index;
+	}
+
+public:
+	void Reset() { *this = CTickHistogram(); }
+
+	void Add(uint64_t Value)
+	{
+		m_aBuckets[Bucket(Value)]++;
+		m_Count++;
+		m_Sum += Value;
+		if(Value > m_Max)
+			m_Max = Value;
+	}
+
+	uint64_t Count() const { return m_Count; }
+	uint64_t Max() const { return m_Max; }
+	uint64_t Mean() const { return m_Count ? m_Sum / m_Count : 0; }
+
+	uint64_t Percentile(double Fraction) const
+	{
+		if(!m_Count)
+			return 0;
+
+		const uint64_t Target = (uint64_t)(Fraction * (double)(m_Count - 1)) + 1;
+		uint64_t Seen = 0;
+		for(int i = 0; i < NUM_BUCKETS; i++)
+		{
+			Seen += m_aBuckets[i];
+			if(Seen >= Target)
+				return minimum((uint64_t)2 << i, m_Max);
+		}
+		return m_Max;
+	}
+
+	void Format(char* pBuf, int BufSize) const
+	{
+		str_format(pBuf, BufSize, "count=%llu mean=%lluus p50=%lluus p99=%lluus max=%lluus",
+			(unsigned long long)m_Count, (unsigned long long)Mean() / 1000, (unsigned long long)Percentile(0.5) / 1000,
+			(unsigned long long)Percentile(0.99) / 1000, (unsigned long long)m_Max / 1000);
+	}
+};
+
+#endif // ENGINE_SERVER_TICK_HISTOGRAM_H
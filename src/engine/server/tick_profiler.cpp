@@ -0,0 +1,135 @@
+#include "tick_profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+CTickProfiler::CTickProfiler()
+{
+	str_copy(m_aaPhaseNames[PHASE_NET_RECV], "net_recv");
+	str_copy(m_aaPhaseNames[PHASE_TICK_GLOBAL], "tick_global");
+	str_copy(m_aaPhaseNames[PHASE_TICK], "tick");
+	str_copy(m_aaPhaseNames[PHASE_BOT_AI], "bot_ai");
+	str_copy(m_aaPhaseNames[PHASE_PATHFINDING], "pathfinding");
+	str_copy(m_aaPhaseNames[PHASE_SNAP_BUILD], "snap_build");
+	str_copy(m_aaPhaseNames[PHASE_SNAP_SEND], "snap_send");
+	AddWorld(WORLD_GLOBAL);
+}
+
+CTickProfiler::CRow* CTickProfiler::Row(int WorldID) const
+{
+	if(WorldID < WORLD_GLOBAL || WorldID >= ENGINE_MAX_WORLDS)
+		return nullptr;
+	return m_apRows[RowIndex(WorldID)].load(std::memory_order_acquire);
+}
+
+void CTickProfiler::AddWorld(int WorldID)
+{
+	if(WorldID < WORLD_GLOBAL || WorldID >= ENGINE_MAX_WORLDS)
+		return;
+
+	// rows are kept until the profiler is gone, so other threads never see a freed row
+	const int Index = RowIndex(WorldID);
+	if(m_apOwnedRows[Index])
+		return;
+
+	m_apOwnedRows[Index] = std::make_unique<CRow>();
+	m_apRows[Index].store(m_apOwnedRows[Index].get(), std::memory_order_release);
+}
+
+int CTickProfiler::RegisterPhase(const char* pName)
+{
+	std::scoped_lock Lock(m_PhaseMutex);
+	const int NumPhases = m_NumPhases;
+	for(int i = 0; i < NumPhases; i++)
+	{
+		if(str_comp(m_aaPhaseNames[i], pName) == 0)
+			return i;
+	}
+
+	if(NumPhases >= MAX_PHASES)
+		return -1;
+
+	str_copy(m_aaPhaseNames[NumPhases], pName);
+	m_NumPhases = NumPhases + 1;
+	return NumPhases;
+}
+
+void CTickProfiler::Add(int WorldID, int Phase, uint64_t Nanoseconds)
+{
+	CRow* pRow = Row(WorldID);
+	if(!pRow || Phase < 0 || Phase >= MAX_PHASES)
+		return;
+
+	auto& Series = pRow->m_aSeries[Phase];
+	const uint64_t Slot = Series.m_Written.fetch_add(1, std::memory_order_relaxed);
+	Series.m_aSamples[Slot % NUM_SAMPLES].store((uint32_t)std::min<uint64_t>(Nanoseconds, 0xffffffffu), std::memory_order_relaxed);
+}
+
+void CTickProfiler::Accumulate(int WorldID, int Phase, uint64_t Nanoseconds)
+{
+	CRow* pRow = Row(WorldID);
+	if(!pRow || Phase < 0 || Phase >= MAX_PHASES)
+		return;
+
+	pRow->m_aPending[Phase] += Nanoseconds;
+	pRow->m_aHasPending[Phase] = true;
+}
+
+void CTickProfiler::Flush(int WorldID)
+{
+	CRow* pRow = Row(WorldID);
+	if(!pRow)
+		return;
+
+	for(int i = 0; i < MAX_PHASES; i++)
+	{
+		if(!pRow->m_aHasPending[i])
+			continue;
+
+		Add(WorldID, i, pRow->m_aPending[i]);
+		pRow->m_aPending[i] = 0;
+		pRow->m_aHasPending[i] = false;
+	}
+}
+
+CTickProfiler::CStats CTickProfiler::GetStats(int WorldID, int Phase) const
+{
+	CStats Stats;
+	const CRow* pRow = Row(WorldID);
+	if(!pRow || Phase < 0 || Phase >= MAX_PHASES)
+		return Stats;
+
+	const auto& Series = pRow->m_aSeries[Phase];
+	const int Count = (int)std::min<uint64_t>(Series.m_Written.load(std::memory_order_relaxed), NUM_SAMPLES);
+	if(!Count)
+		return Stats;
+
+	std::vector<uint32_t> vSamples(Count);
+	for(int i = 0; i < Count; i++)
+		vSamples[i] = Series.m_aSamples[i].load(std::memory_order_relaxed);
+	std::sort(vSamples.begin(), vSamples.end());
+
+	const auto Percentile = [&vSamples](double Fraction) { return (uint64_t)vSamples[(size_t)(Fraction * (double)(vSamples.size() - 1))]; };
+	Stats.m_Count = Count;
+	Stats.m_P50 = Percentile(0.5);
+	Stats.m_P95 = Percentile(0.95);
+	Stats.m_P99 = Percentile(0.99);
+	Stats.m_Max = vSamples.back();
+	return Stats;
+}
+
+void CTickProfiler::Format(int WorldID, const std::function<void(const char*)>& fnLine) const
+{
+	for(int Phase = 0; Phase < NumPhases(); Phase++)
+	{
+		const auto Stats = GetStats(WorldID, Phase);
+		if(!Stats.m_Count)
+			continue;
+
+		char aBuf[256];
+		str_format(aBuf, sizeof(aBuf), "world=%d phase=%s samples=%d p50=%lluus p95=%lluus p99=%lluus max=%lluus",
+			WorldID, PhaseName(Phase), Stats.m_Count, (unsigned long long)Stats.m_P50 / 1000, (unsigned long long)Stats.m_P95 / 1000,
+			(unsigned long long)Stats.m_P99 / 1000, (unsigned long long)Stats.m_Max / 1000);
+		fnLine(aBuf);
+	}
+}
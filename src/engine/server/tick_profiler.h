@@ -0,0 +1,132 @@
+#ifndef ENGINE_SERVER_TICK_PROFILER_H
+#define ENGINE_SERVER_TICK_PROFILER_H
+
+#include <base/math.h>
+#include <base/system.h>
+
+#include <engine/shared/protocol.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/*
+ * Always on timings of the server tick split into phases per world. Every
+ * phase keeps the last samples in a ring buffer, percentiles are computed
+ * from a copy only when somebody asks for them. Samples may be added from
+ * any thread, rows and phases are registered from the tick thread.
+ */
+class CTickProfiler
+{
+public:
+	enum
+	{
+		WORLD_GLOBAL = -1,
+
+		PHASE_NET_RECV = 0,
+		PHASE_TICK_GLOBAL,
+		PHASE_TICK,
+		PHASE_BOT_AI,
+		PHASE_PATHFINDING,
+		PHASE_SNAP_BUILD,
+		PHASE_SNAP_SEND,
+		NUM_FIXED_PHASES,
+
+		MAX_PHASES = 48,
+		NUM_SAMPLES = 256,
+	};
+
+	struct CStats
+	{
+		int m_Count {};
+		uint64_t m_P50 {};
+		uint64_t m_P95 {};
+		uint64_t m_P99 {};
+		uint64_t m_Max {};
+	};
+
+	// records the lifetime of the scope as one sample
+	class CScope
+	{
+		CTickProfiler* m_pProfiler;
+		int m_WorldID;
+		int m_Phase;
+		std::chrono::nanoseconds m_Start;
+
+	public:
+		CScope(CTickProfiler* pProfiler, int WorldID, int Phase)
+			: m_pProfiler(pProfiler), m_WorldID(WorldID), m_Phase(Phase), m_Start(time_get_nanoseconds()) {}
+		~CScope() { m_pProfiler->Add(m_WorldID, m_Phase, (time_get_nanoseconds() - m_Start).count()); }
+		CScope(const CScope&) = delete;
+		CScope& operator=(const CScope&) = delete;
+	};
+
+	// sums the lifetime of the scope into the current tick, see Accumulate
+	class CAccumulateScope
+	{
+		CTickProfiler* m_pProfiler;
+		int m_WorldID;
+		int m_Phase;
+		std::chrono::nanoseconds m_Start;
+
+	public:
+		CAccumulateScope(CTickProfiler* pProfiler, int WorldID, int Phase)
+			: m_pProfiler(pProfiler), m_WorldID(WorldID), m_Phase(Phase), m_Start(time_get_nanoseconds()) {}
+		~CAccumulateScope() { m_pProfiler->Accumulate(m_WorldID, m_Phase, (time_get_nanoseconds() - m_Start).count()); }
+		CAccumulateScope(const CAccumulateScope&) = delete;
+		CAccumulateScope& operator=(const CAccumulateScope&) = delete;
+	};
+
+private:
+	struct CSeries
+	{
+		std::atomic<uint32_t> m_aSamples[NUM_SAMPLES] {};
+		std::atomic<uint64_t> m_Written {};
+	};
+
+	struct CRow
+	{
+		std::array<CSeries, MAX_PHASES> m_aSeries {};
+		// tick thread only
+		std::array<uint64_t, MAX_PHASES> m_aPending {};
+		std::array<bool, MAX_PHASES> m_aHasPending {};
+	};
+
+	std::array<std::atomic<CRow*>, ENGINE_MAX_WORLDS + 1> m_apRows {};
+	std::array<std::unique_ptr<CRow>, ENGINE_MAX_WORLDS + 1> m_apOwnedRows {};
+	std::array<char[32], MAX_PHASES> m_aaPhaseNames {};
+	std::atomic<int> m_NumPhases { NUM_FIXED_PHASES };
+	std::mutex m_PhaseMutex;
+
+	static int RowIndex(int WorldID) { return WorldID == WORLD_GLOBAL ? ENGINE_MAX_WORLDS : WorldID; }
+	CRow* Row(int WorldID) const;
+
+public:
+	CTickProfiler();
+
+	// creates the row of a world, samples of unknown worlds are dropped
+	void AddWorld(int WorldID);
+
+	// returns the same phase for the same name, -1 when all phases are used
+	int RegisterPhase(const char* pName);
+	const char* PhaseName(int Phase) const { return m_aaPhaseNames[Phase]; }
+	int NumPhases() const { return m_NumPhases; }
+
+	void Add(int WorldID, int Phase, uint64_t Nanoseconds);
+
+	// for phases that run many times per tick, like one call per bot,
+	// the durations are summed and added as one sample by Flush
+	void Accumulate(int WorldID, int Phase, uint64_t Nanoseconds);
+	void Flush(int WorldID);
+
+	CStats GetStats(int WorldID, int Phase) const;
+
+	// calls the callback with one formatted line for every phase with samples
+	void Format(int WorldID, const std::function<void(const char*)>& fnLine) const;
+};
+
+#endif // ENGINE_SERVER_TICK_PROFILER_H
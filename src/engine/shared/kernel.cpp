@@ -101,13 +101,15 @@ public:
 
 	bool ReregisterInterfaceImpl(const char *pName, IInterface *pInterface, int ID) override
 	{
-		if(FindInterfaceInfo(pName, ID) == 0)
+		CInterfaceInfo* pInfo = FindInterfaceInfo(pName, ID);
+		if(pInfo == 0)
 		{
 			dbg_msg("kernel", "ERROR: couldn't reregister interface '%s'. interface doesn't exist", pName);
 			return false;
 		}
 
 		pInterface->m_pKernel = this;
+		pInfo->m_pInterface = pInterface;
 
 		return true;
 	}
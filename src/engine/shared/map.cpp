@@ -70,6 +70,14 @@ int CMap::NumItems() const
 	return m_DataFile.NumItems();
 }
 
+bool CMap::ClaimTilePreparation()
+{
+	if(m_TilesPrepared)
+		return false;
+	m_TilesPrepared = true;
+	return true;
+}
+
 bool CMap::Load(const char *pMapName)
 {
 	IStorageEngine *pStorage = Kernel()->RequestInterface<IStorageEngine>();
@@ -118,12 +126,14 @@ bool CMap::Load(const char *pMapName)
 	// Replace existing datafile with new datafile
 	m_DataFile.Close();
 	m_DataFile = std::move(NewDataFile);
+	m_TilesPrepared = false;
 	return true;
 }
 
 void CMap::Unload()
 {
 	m_DataFile.Close();
+	m_TilesPrepared = false;
 }
 
 bool CMap::IsLoaded() const
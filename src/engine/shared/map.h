@@ -11,6 +11,7 @@
 class CMap : public IEngineMap
 {
 	CDataFileReader m_DataFile;
+	bool m_TilesPrepared = false;
 
 public:
 	CMap();
@@ -30,6 +31,7 @@ public:
 	int FindItemIndex(int Type, int ID) override;
 	void *FindItem(int Type, int ID) override;
 	int NumItems() const override;
+	bool ClaimTilePreparation() override;
 
 	bool Load(const char *pMapName) override;
 	void Unload() override;
@@ -462,116 +462,169 @@ int CSnapshotDelta::UnpackDelta(const CSnapshot *pFrom, CSnapshot *pTo, const vo
 
 // CSnapshotStorage
 
+static int AlignedSnapSize(int Size)
+{
+	return (maximum(Size, 0) + 7) & ~7;
+}
+
 void CSnapshotStorage::Init()
 {
-	m_pFirst = 0;
-	m_pLast = 0;
+	for(auto &Entry : m_aEntries)
+		Entry.m_Tick = -1;
+
+	m_NumEntries = 0;
+	m_FirstTick = -1;
+	m_LastTick = -1;
+	m_DataStart = 0;
+	m_DataEnd = 0;
 }
 
 void CSnapshotStorage::PurgeAll()
 {
-	CHolder *pHolder = m_pFirst;
+	// release the buffer as well, the storage is purged when the client leaves
+	free(m_pData);
+	m_pData = nullptr;
+	m_DataCapacity = 0;
+	Init();
+}
+
+void CSnapshotStorage::PurgeUntil(int Tick)
+{
+	while(m_NumEntries > 0 && m_FirstTick < Tick)
+		RemoveOldest();
+}
+
+void CSnapshotStorage::RemoveOldest()
+{
+	Slot(m_FirstTick).m_Tick = -1;
+	m_NumEntries--;
 
-	while(pHolder)
+	if(m_NumEntries == 0)
 	{
-		CHolder *pNext = pHolder->m_pNext;
-		free(pHolder);
-		pHolder = pNext;
+		Init();
+		return;
 	}
 
-	// no more snapshots in storage
-	m_pFirst = 0;
-	m_pLast = 0;
+	// ticks can have gaps, find the next stored one
+	do
+		m_FirstTick++;
+	while(Slot(m_FirstTick).m_Tick != m_FirstTick);
+	m_DataStart = Slot(m_FirstTick).m_Offset;
 }
 
-void CSnapshotStorage::PurgeUntil(int Tick)
+int CSnapshotStorage::AllocData(int Size)
 {
-	CHolder *pHolder = m_pFirst;
+	if(m_NumEntries == 0)
+	{
+		if(m_DataCapacity < Size)
+			GrowData(Size);
+		m_DataStart = 0;
+		m_DataEnd = Size;
+		return 0;
+	}
 
-	while(pHolder)
+	if(m_DataStart < m_DataEnd)
+	{
+		// free space is at the end and in front of the oldest snapshot
+		if(m_DataCapacity - m_DataEnd >= Size)
+		{
+			m_DataEnd += Size;
+			return m_DataEnd - Size;
+		}
+		if(m_DataStart >= Size)
+		{
+			m_DataEnd = Size;
+			return 0;
+		}
+	}
+	else if(m_DataStart - m_DataEnd >= Size)
 	{
-		CHolder *pNext = pHolder->m_pNext;
-		if(pHolder->m_Tick >= Tick)
-			return; // no more to remove
-		free(pHolder);
+		m_DataEnd += Size;
+		return m_DataEnd - Size;
+	}
 
-		// did we come to the end of the list?
-		if(!pNext)
-			break;
+	GrowData(Size);
+	m_DataEnd += Size;
+	return m_DataEnd - Size;
+}
 
-		m_pFirst = pNext;
-		pNext->m_pPrev = 0x0;
+void CSnapshotStorage::GrowData(int Size)
+{
+	int Used = 0;
+	for(int Tick = m_FirstTick; m_NumEntries > 0 && Tick <= m_LastTick; Tick++)
+	{
+		if(Slot(Tick).m_Tick == Tick)
+			Used += AlignedSnapSize(Slot(Tick).m_SnapSize) + AlignedSnapSize(Slot(Tick).m_AltSnapSize);
+	}
 
-		pHolder = pNext;
+	// move the stored snapshots to the front of the new buffer in tick order
+	const int NewCapacity = maximum(m_DataCapacity * 2, Used + Size);
+	char *pNewData = (char *)malloc(NewCapacity);
+	int Offset = 0;
+	for(int Tick = m_FirstTick; m_NumEntries > 0 && Tick <= m_LastTick; Tick++)
+	{
+		CEntry &Entry = Slot(Tick);
+		if(Entry.m_Tick != Tick)
+			continue;
+
+		const int EntrySize = AlignedSnapSize(Entry.m_SnapSize) + AlignedSnapSize(Entry.m_AltSnapSize);
+		mem_copy(pNewData + Offset, m_pData + Entry.m_Offset, EntrySize);
+		Entry.m_Offset = Offset;
+		Offset += EntrySize;
 	}
 
-	// no more snapshots in storage
-	m_pFirst = 0;
-	m_pLast = 0;
+	free(m_pData);
+	m_pData = pNewData;
+	m_DataCapacity = NewCapacity;
+	m_DataStart = 0;
+	m_DataEnd = Offset;
 }
 
 void CSnapshotStorage::Add(int Tick, int64_t Tagtime, int DataSize, const void *pData, int AltDataSize, const void *pAltData)
 {
-	// allocate memory for holder + snapshot_data
-	int TotalSize = sizeof(CHolder) + DataSize;
+	// ticks only go forward, anything else means the history is no longer valid
+	if(m_NumEntries > 0 && Tick <= m_LastTick)
+		Init();
 
-	if(AltDataSize > 0)
-	{
-		TotalSize += AltDataSize;
-	}
-
-	CHolder *pHolder = (CHolder *)malloc(TotalSize);
+	// drop what does not fit into the ring anymore
+	while(m_NumEntries > 0 && Tick - m_FirstTick >= MAX_TICKS)
+		RemoveOldest();
 
-	// set data
-	pHolder->m_Tick = Tick;
-	pHolder->m_Tagtime = Tagtime;
-	pHolder->m_SnapSize = DataSize;
-	pHolder->m_pSnap = (CSnapshot *)(pHolder + 1);
-	mem_copy(pHolder->m_pSnap, pData, DataSize);
+	const int SnapSize = AlignedSnapSize(DataSize);
+	const int Offset = AllocData(SnapSize + AlignedSnapSize(AltDataSize));
 
+	CEntry &Entry = Slot(Tick);
+	Entry.m_Tick = Tick;
+	Entry.m_Tagtime = Tagtime;
+	Entry.m_Offset = Offset;
+	Entry.m_SnapSize = DataSize;
+	Entry.m_AltSnapSize = maximum(AltDataSize, 0);
+	mem_copy(m_pData + Offset, pData, DataSize);
 	if(AltDataSize > 0) // create alternative if wanted
-	{
-		pHolder->m_pAltSnap = (CSnapshot *)(((char *)pHolder->m_pSnap) + DataSize);
-		mem_copy(pHolder->m_pAltSnap, pAltData, AltDataSize);
-		pHolder->m_AltSnapSize = AltDataSize;
-	}
-	else
-	{
-		pHolder->m_pAltSnap = 0;
-		pHolder->m_AltSnapSize = 0;
-	}
+		mem_copy(m_pData + Offset + SnapSize, pAltData, AltDataSize);
 
-	// link
-	pHolder->m_pNext = 0;
-	pHolder->m_pPrev = m_pLast;
-	if(m_pLast)
-		m_pLast->m_pNext = pHolder;
-	else
-		m_pFirst = pHolder;
-	m_pLast = pHolder;
+	if(m_NumEntries == 0)
+		m_FirstTick = Tick;
+	m_LastTick = Tick;
+	m_NumEntries++;
 }
 
 int CSnapshotStorage::Get(int Tick, int64_t *pTagtime, const CSnapshot **ppData, const CSnapshot **ppAltData)
 {
-	CHolder *pHolder = m_pFirst;
-
-	while(pHolder)
-	{
-		if(pHolder->m_Tick == Tick)
-		{
-			if(pTagtime)
-				*pTagtime = pHolder->m_Tagtime;
-			if(ppData)
-				*ppData = pHolder->m_pSnap;
-			if(ppAltData)
-				*ppAltData = pHolder->m_pAltSnap;
-			return pHolder->m_SnapSize;
-		}
+	if(m_NumEntries == 0 || Tick < m_FirstTick || Tick > m_LastTick)
+		return -1;
 
-		pHolder = pHolder->m_pNext;
-	}
+	const CEntry &Entry = Slot(Tick);
+	if(Entry.m_Tick != Tick)
+		return -1;
 
-	return -1;
+	if(pTagtime)
+		*pTagtime = Entry.m_Tagtime;
+	if(ppData)
+		*ppData = (const CSnapshot *)(m_pData + Entry.m_Offset);
+	if(ppAltData)
+		*ppAltData = Entry.m_AltSnapSize > 0 ? (const CSnapshot *)(m_pData + Entry.m_Offset + AlignedSnapSize(Entry.m_SnapSize)) : nullptr;
+	return Entry.m_SnapSize;
 }
 
 // CSnapshotBuilder
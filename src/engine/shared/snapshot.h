@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 
 // CSnapshot
 
@@ -106,32 +107,51 @@ public:
 class CSnapshotStorage
 {
 public:
-	class CHolder
+	enum
 	{
-	public:
-		CHolder *m_pPrev;
-		CHolder *m_pNext;
-
-		int64_t m_Tagtime;
-		int m_Tick;
-
-		int m_SnapSize;
-		int m_AltSnapSize;
-
-		CSnapshot *m_pSnap;
-		CSnapshot *m_pAltSnap;
+		// ring slots, enough for the 3 second delta window of the server (150 ticks)
+		MAX_TICKS = 256,
 	};
 
-	CHolder *m_pFirst;
-	CHolder *m_pLast;
-
 	CSnapshotStorage() { Init(); }
-	~CSnapshotStorage() { PurgeAll(); }
+	~CSnapshotStorage() { free(m_pData); }
+	CSnapshotStorage(const CSnapshotStorage &) = delete;
+	CSnapshotStorage &operator=(const CSnapshotStorage &) = delete;
+
 	void Init();
 	void PurgeAll();
 	void PurgeUntil(int Tick);
 	void Add(int Tick, int64_t Tagtime, int DataSize, const void *pData, int AltDataSize, const void *pAltData);
 	int Get(int Tick, int64_t *pTagtime, const CSnapshot **ppData, const CSnapshot **ppAltData);
+
+	int NumSnapshots() const { return m_NumEntries; }
+	int DataCapacity() const { return m_DataCapacity; }
+
+private:
+	struct CEntry
+	{
+		int64_t m_Tagtime;
+		int m_Tick;
+		int m_Offset;
+		int m_SnapSize;
+		int m_AltSnapSize;
+	};
+
+	CEntry &Slot(int Tick) { return m_aEntries[Tick & (MAX_TICKS - 1)]; }
+	void RemoveOldest();
+	int AllocData(int Size);
+	void GrowData(int Size);
+
+	// snapshots are indexed by tick, payloads live in one contiguous byte ring
+	CEntry m_aEntries[MAX_TICKS];
+	int m_NumEntries = 0;
+	int m_FirstTick = -1;
+	int m_LastTick = -1;
+
+	char *m_pData = nullptr;
+	int m_DataCapacity = 0;
+	int m_DataStart = 0;
+	int m_DataEnd = 0;
 };
 
 class CSnapshotBuilder
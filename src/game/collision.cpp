@@ -79,8 +79,16 @@ void CCollision::Init(IKernel* pKernel, int WorldID)
 
 	// initailize base game tiles
 	IMap* pMap = m_pLayers->Map();
+	m_vZones.assign(1, ZoneDetail {});
+	m_vActionZoneNames.assign(1, std::string {});
+	m_aSwitchZones.fill(0);
+	m_aSwitchActionZones.fill(0);
 	m_pTiles = static_cast<CTile*>(pMap->GetData(pGameLayer->m_Data));
 	InitSettings();
+
+	// the tile layers are shared by every world loaded from the same map, they are
+	// prepared by the first world, the others only read them
+	m_PrepareTiles = pMap->ClaimTilePreparation();
 	InitTiles(m_pTiles);
 
 	// front layer
@@ -115,6 +123,8 @@ void CCollision::Init(IKernel* pKernel, int WorldID)
 	auto DoorLayerSize = m_Width * m_Height;
 	m_pDoor = new CDoorTile[DoorLayerSize]();
 	mem_zero(m_pDoor, DoorLayerSize * sizeof(CDoorTile));
+	InitZones();
+	InitSpecialTiles();
 }
 
 static void initGatheringNode(const std::string& nodeType, const std::vector<std::string>& vSettings, int Number, std::unordered_map<int, GatheringNode>& vNodesContainer)
@@ -156,7 +166,8 @@ void CCollision::InitSettings()
 			if(mystd::loadSettings<std::string, bool>(Identity, settings, &detail.Name, &detail.PVP))
 			{
 				dbg_msg("map-init", "Zone '%s' (switch: %d) initialized: PVP=%s", detail.Name.c_str(), i, detail.PVP ? "true" : "false");
-				m_vZoneDetail[i] = detail;
+				m_aSwitchZones[i] = (uint8_t)m_vZones.size();
+				m_vZones.push_back(std::move(detail));
 			}
 		}
 
@@ -180,12 +191,20 @@ void CCollision::InitSettings()
 
 		// initialize action zones details
 		{
-			ActionZoneDetail detail;
+			std::string Name;
 			const auto Identity = std::string("#action_zone ").append(std::to_string(i));
-			if(mystd::loadSettings<std::string>(Identity, settings, &detail.Name))
+			if(mystd::loadSettings<std::string>(Identity, settings, &Name) && !Name.empty())
 			{
-				dbg_msg("map-init", "Action zone '%s' (switch: %d) initialized", detail.Name.c_str(), i);
-				m_vActionZoneDetail[i] = detail;
+				// switches with the same name share one id
+				int ActionZoneID = FindActionZoneID(Name);
+				if(!ActionZoneID)
+				{
+					ActionZoneID = (int)m_vActionZoneNames.size();
+					m_vActionZoneNames.push_back(Name);
+				}
+
+				dbg_msg("map-init", "Action zone '%s' (switch: %d) initialized", Name.c_str(), i);
+				m_aSwitchActionZones[i] = (uint8_t)ActionZoneID;
 			}
 		}
 	}
@@ -222,7 +241,12 @@ void CCollision::InitTiles(CTile* pTiles)
 	{
 		CTile& currentTile = pTiles[i];
 		const int tileIndex = currentTile.m_Index;
-		currentTile.m_ColFlags = 0;
+		if(m_PrepareTiles)
+		{
+			currentTile.m_ColFlags = 0;
+			if(auto it = TILE_COLFLAG_MAP.find(tileIndex); it != TILE_COLFLAG_MAP.end())
+				currentTile.m_ColFlags = static_cast<char>(it->second);
+		}
 
 		if(tileIndex > 128)
 			continue;
@@ -246,10 +270,6 @@ void CCollision::InitTiles(CTile* pTiles)
 			vec2 Pos = CalculateTileCenter(i, m_Width);
 			SetDoorCollisionAt(Pos.x, Pos.y, TILE_STOPA, 0, 0);
 		}
-
-		if(auto it = TILE_COLFLAG_MAP.find(tileIndex); it != TILE_COLFLAG_MAP.end())
-			currentTile.m_ColFlags = static_cast<char>(it->second);
-
 	}
 }
 
@@ -269,14 +289,16 @@ void CCollision::InitTeleports()
 		{
 			case TILE_TELE_FROM:
 			case TILE_TELE_FROM_CONFIRM:
-				m_pTiles[i].m_Index = static_cast<char>(teleType);
+				if(m_PrepareTiles)
+					m_pTiles[i].m_Index = static_cast<char>(teleType);
 				break;
 
 			case TILE_TELE_OUT:
-				m_pTiles[i].m_Index = static_cast<char>(teleType);
+				if(m_PrepareTiles)
+					m_pTiles[i].m_Index = static_cast<char>(teleType);
 				{
 					const vec2 tilePos = CalculateTileCenter(i, m_Width);
-					m_vTeleOuts[teleNumber].push_back(tilePos);
+					m_avTeleOuts[teleNumber].push_back(tilePos);
 				}
 				break;
 
@@ -301,10 +323,9 @@ void CCollision::InitSwitchExtra()
 		switch(switchType)
 		{
 			case TILE_SW_ZONE:
-				if(m_vZoneDetail.contains(switchNumber))
+				if(const int ZoneID = m_aSwitchZones[switchNumber]; m_PrepareTiles && ZoneID)
 				{
-					const auto& zone = m_vZoneDetail.at(switchNumber);
-					if(!zone.PVP)
+					if(!m_vZones[ZoneID].PVP)
 						m_pTiles[i].m_ColFlags |= COLFLAG_SAFE;
 				}
 				break;
@@ -326,6 +347,44 @@ void CCollision::InitSwitchExtra()
 
 void CCollision::InitSpeedupExtra() {}
 
+void CCollision::InitZones()
+{
+	const int NumTiles = m_Width * m_Height;
+	m_vZoneTiles.assign(NumTiles, CZoneTile {});
+
+	// zones and action zones from the switch layer
+	if(m_pSwitchExtra)
+	{
+		for(int i = 0; i < NumTiles; ++i)
+		{
+			const CSwitchTileExtra& switchTile = m_pSwitchExtra[i];
+			if(switchTile.m_Type == TILE_SW_ZONE)
+				m_vZoneTiles[i].m_Zone = m_aSwitchZones[switchTile.m_Number];
+			else if(switchTile.m_Type == TILE_SW_ACTION_ZONE)
+				m_vZoneTiles[i].m_ActionZone = m_aSwitchActionZones[switchTile.m_Number];
+		}
+	}
+
+	// fixed cams cover every tile with the center inside the rect, the first cam wins
+	for(int CamIndex = 0; CamIndex < (int)m_vFixedCamZones.size() && CamIndex < 0xffff; ++CamIndex)
+	{
+		const vec4& Rect = m_vFixedCamZones[CamIndex].Rect;
+		const int StartX = maximum(0, (int)std::floor(Rect.x / TILE_SIZE - 0.5f) + 1);
+		const int StartY = maximum(0, (int)std::floor(Rect.y / TILE_SIZE - 0.5f) + 1);
+		const int EndX = minimum(m_Width - 1, (int)std::ceil(Rect.z / TILE_SIZE - 0.5f) - 1);
+		const int EndY = minimum(m_Height - 1, (int)std::ceil(Rect.w / TILE_SIZE - 0.5f) - 1);
+		for(int y = StartY; y <= EndY; ++y)
+		{
+			for(int x = StartX; x <= EndX; ++x)
+			{
+				auto& ZoneTile = m_vZoneTiles[y * m_Width + x];
+				if(!ZoneTile.m_FixedCam)
+					ZoneTile.m_FixedCam = (uint16_t)(CamIndex + 1);
+			}
+		}
+	}
+}
+
 void CCollision::InitEntities(const std::function<void(int, vec2, int)>& funcInit) const
 {
 	for(int y = 0; y < m_Height; ++y)
@@ -545,86 +604,62 @@ int CCollision::GetPureMapIndex(float x, float y) const
 	return Ny * m_Width + Nx;
 }
 
-std::vector<int> CCollision::GetMapIndices(vec2 PrevPos, vec2 Pos, unsigned MaxIndices) const
+void CCollision::InitSpecialTiles()
 {
-	std::vector<int> vIndices;
-	float d = distance(PrevPos, Pos);
-	int End(d + 1);
-	if(!d)
+	const int NumTiles = m_Width * m_Height;
+	m_vSpecialTiles.assign((NumTiles + 63) / 64, 0);
+	for(int Index = 0; Index < NumTiles; Index++)
 	{
-		int Nx = clamp((int)Pos.x / 32, 0, m_Width - 1);
-		int Ny = clamp((int)Pos.y / 32, 0, m_Height - 1);
-		int Index = Ny * m_Width + Nx;
+		bool Special = TileExists(Index);
 
-		if(TileExists(Index))
+		// solid ground alone has nothing to handle
+		const int MainIndex = m_pTiles[Index].m_Index;
+		if(Special && (MainIndex == TILE_SOLID || MainIndex == TILE_NOHOOK))
 		{
-			vIndices.push_back(Index);
-			return vIndices;
-		}
-		else
-			return vIndices;
-	}
-	else
-	{
-		int LastIndex = 0;
-		for(int i = 0; i < End; i++)
-		{
-			float a = i / d;
-			vec2 Tmp = mix(PrevPos, Pos, a);
-			int Nx = clamp((int)Tmp.x / 32, 0, m_Width - 1);
-			int Ny = clamp((int)Tmp.y / 32, 0, m_Height - 1);
-			int Index = Ny * m_Width + Nx;
-			if(LastIndex != Index && TileExists(Index))
-			{
-				if(MaxIndices && vIndices.size() > MaxIndices)
-					return vIndices;
-
-				vIndices.push_back(Index);
-				LastIndex = Index;
-			}
+			Special = (m_pFront && m_pFront[Index].m_Index > TILE_AIR)
+				|| (m_pTele && m_pTele[Index].m_Type > TILE_AIR)
+				|| (m_pSpeedupExtra && m_pSpeedupExtra[Index].m_Force > 0)
+				|| (m_pSwitchExtra && m_pSwitchExtra[Index].m_Type > TILE_AIR)
+				|| TileExistsNext(Index);
 		}
 
-		return vIndices;
+		if(Special)
+			m_vSpecialTiles[Index / 64] |= (uint64_t)1 << (Index % 64);
 	}
 }
 
-std::optional<CCollision::ZoneDetail> CCollision::GetZonedetail(vec2 Pos) const
+void CCollision::MarkSpecialTiles(int Index)
 {
-	if(!m_pSwitchExtra)
-		return std::nullopt;
-
-	int Nx = clamp(round_to_int(Pos.x) / 32, 0, m_Width - 1);
-	int Ny = clamp(round_to_int(Pos.y) / 32, 0, m_Height - 1);
-	int Number = m_pSwitchExtra[Ny * m_Width + Nx].m_Number;
-
-	if(m_vZoneDetail.contains(Number))
-		return m_vZoneDetail.at(Number);
-
-	return std::nullopt;
+	// doors act on the tile and, as stoppers, on the neighbours
+	const int NumTiles = m_Width * m_Height;
+	for(const int Near : { Index, Index - 1, Index + 1, Index - m_Width, Index + m_Width })
+	{
+		if(Near >= 0 && Near < NumTiles)
+			m_vSpecialTiles[Near / 64] |= (uint64_t)1 << (Near % 64);
+	}
 }
 
-bool CCollision::IsActiveActionZone(std::string_view ActionZoneName, vec2 Pos) const
+int CCollision::FindActionZoneID(std::string_view ActionZoneName) const
 {
 	if(ActionZoneName.empty())
-		return false;
-
-	const auto switchNumber = GetSwitchTileNumberAtTileIndex(Pos, TILE_SW_ACTION_ZONE);
-	if(!switchNumber || !m_vActionZoneDetail.contains(*switchNumber))
-		return false;
+		return 0;
 
-	const auto& detail = m_vActionZoneDetail.at(*switchNumber);
-	return detail.Name == ActionZoneName;
+	for(int ID = 1; ID < (int)m_vActionZoneNames.size(); ++ID)
+	{
+		if(m_vActionZoneNames[ID] == ActionZoneName)
+			return ID;
+	}
+	return 0;
 }
 
 std::optional<std::pair<vec2, bool>> CCollision::TryGetFixedCamPos(vec2 currentPos) const
 {
-	for(const auto& [Pos, Rect, Smooth] : m_vFixedCamZones)
-	{
-		if(currentPos.x > Rect.x && currentPos.x < Rect.z &&
-			currentPos.y > Rect.y && currentPos.y < Rect.w)
-			return std::make_pair(Pos, Smooth);
-	}
-	return std::nullopt;
+	const int FixedCam = GetZoneTile(currentPos).m_FixedCam;
+	if(!FixedCam)
+		return std::nullopt;
+
+	const auto& CamZone = m_vFixedCamZones[FixedCam - 1];
+	return std::make_pair(CamZone.Pos, CamZone.Smooth);
 }
 
 void CCollision::SetDoorCollisionAt(float x, float y, int Type, int Flags, int Number)
@@ -638,6 +673,7 @@ void CCollision::SetDoorCollisionAt(float x, float y, int Type, int Flags, int N
 	m_pDoor[Ny * m_Width + Nx].m_Index = Type;
 	m_pDoor[Ny * m_Width + Nx].m_Flags = Flags;
 	m_pDoor[Ny * m_Width + Nx].m_Number = Number;
+	MarkSpecialTiles(Ny * m_Width + Nx);
 }
 
 void CCollision::SetDoorFromToCollisionAt(vec2 From, vec2 To, int Type, int Flags, int Number)
@@ -663,6 +699,7 @@ void CCollision::SetDoorFromToCollisionAt(vec2 From, vec2 To, int Type, int Flag
 			m_pDoor[Index].m_Index = Type;
 			m_pDoor[Index].m_Flags = Flags;
 			m_pDoor[Index].m_Number = Number;
+			MarkSpecialTiles(Index);
 		}
 	}
 }
@@ -721,7 +758,7 @@ bool CCollision::IntersectLineDoor(vec2 From, vec2 To) const
 	return false;
 }
 
-std::optional<vec2> CCollision::TryGetTeleportOut(vec2 currentPos)
+std::optional<vec2> CCollision::TryGetTeleportOut(vec2 currentPos) const
 {
 	if(!m_pTele)
 		return std::nullopt;
@@ -733,7 +770,7 @@ std::optional<vec2> CCollision::TryGetTeleportOut(vec2 currentPos)
 	if(Number <= 0)
 		return std::nullopt;
 
-	const auto& TeleOuts = m_vTeleOuts[Number];
+	const auto& TeleOuts = m_avTeleOuts[Number];
 	if(TeleOuts.empty())
 		return std::nullopt;
 
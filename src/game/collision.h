@@ -3,7 +3,13 @@
 #ifndef GAME_COLLISION_H
 #define GAME_COLLISION_H
 
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <vector>
+#include <base/math.h>
 #include <base/vmath.h>
 
 class CTile;
@@ -47,11 +53,6 @@ public:
 		std::vector<vec2> vPositions {};
 		std::string Text {};
 	};
-	struct ActionZoneDetail
-	{
-		std::string Name {};
-	};
-
 	struct FixedCamZoneDetail
 	{
 		vec2 Pos {};
@@ -70,11 +71,29 @@ private:
 	CDoorTile* m_pDoor;
 	CLayers* m_pLayers {};
 
-	std::map<int, std::vector<vec2>> m_vTeleOuts {};
+	// one bit per tile that may need tile handling, plain air and solid ground are clear
+	std::vector<uint64_t> m_vSpecialTiles {};
+	// this world writes the derived tile data into the shared map, see IMap::ClaimTilePreparation
+	bool m_PrepareTiles {};
+
+	// zone ids of every tile, compiled at map load so a zone query is one read
+	struct CZoneTile
+	{
+		uint8_t m_Zone;
+		uint8_t m_ActionZone;
+		uint16_t m_FixedCam;
+	};
+	std::vector<CZoneTile> m_vZoneTiles {};
+
+	// indexed by zone id, id 0 is no zone
+	std::vector<ZoneDetail> m_vZones {};
+	std::vector<std::string> m_vActionZoneNames {};
 	std::vector<FixedCamZoneDetail> m_vFixedCamZones {};
-	std::map<int, ZoneDetail> m_vZoneDetail {};
+	std::array<uint8_t, 256> m_aSwitchZones {};
+	std::array<uint8_t, 256> m_aSwitchActionZones {};
+
+	std::array<std::vector<vec2>, 256> m_avTeleOuts {};
 	std::map<int, TextZoneDetail> m_vZoneTextDetail {};
-	std::map<int, ActionZoneDetail> m_vActionZoneDetail {};
 	std::unordered_map<int, GatheringNode> m_vOreNodes {};
 	std::unordered_map<int, GatheringNode> m_vPlantNodes {};
 	std::unordered_map<int, GatheringNode> m_vFishNodes {};
@@ -85,6 +104,9 @@ private:
 	void InitTeleports();
 	void InitSwitchExtra();
 	void InitSpeedupExtra();
+	void InitZones();
+	void InitSpecialTiles();
+	void MarkSpecialTiles(int Index);
 
 	// flags
 	int GetMainTileFlags(float x, float y) const;
@@ -139,7 +161,50 @@ public:
 	int GetMapIndex(vec2 Pos) const;
 	int GetPureMapIndex(float x, float y) const;
 	int GetPureMapIndex(vec2 pos) const { return GetPureMapIndex(pos.x, pos.y); }
-	std::vector<int> GetMapIndices(vec2 PrevPos, vec2 Pos, unsigned MaxIndices = 0) const;
+	bool IsSpecialTile(int Index) const { return (m_vSpecialTiles[Index / 64] >> (Index % 64)) & 1 && TileExists(Index); }
+
+	// calls Func(Index) for every special tile crossed on the way from PrevPos to Pos,
+	// in order and once per tile, stops early when Func returns false
+	template<typename F>
+	void ForEachSpecialTile(vec2 PrevPos, vec2 Pos, F&& Func) const
+	{
+		int x = (int)std::floor(PrevPos.x / 32.0f);
+		int y = (int)std::floor(PrevPos.y / 32.0f);
+		const int EndX = (int)std::floor(Pos.x / 32.0f);
+		const int EndY = (int)std::floor(Pos.y / 32.0f);
+		const vec2 Delta = Pos - PrevPos;
+		const int StepX = Delta.x > 0 ? 1 : -1;
+		const int StepY = Delta.y > 0 ? 1 : -1;
+
+		// distance along the line to the next vertical and horizontal tile border
+		const float DeltaX = Delta.x != 0 ? 32.0f / std::abs(Delta.x) : 0.0f;
+		const float DeltaY = Delta.y != 0 ? 32.0f / std::abs(Delta.y) : 0.0f;
+		float NextX = Delta.x != 0 ? ((StepX > 0 ? (x + 1) * 32.0f - PrevPos.x : PrevPos.x - x * 32.0f) / std::abs(Delta.x)) : 0.0f;
+		float NextY = Delta.y != 0 ? ((StepY > 0 ? (y + 1) * 32.0f - PrevPos.y : PrevPos.y - y * 32.0f) / std::abs(Delta.y)) : 0.0f;
+
+		int LastIndex = -1;
+		for(int Steps = std::abs(EndX - x) + std::abs(EndY - y); Steps >= 0; Steps--)
+		{
+			const int Index = clamp(y, 0, m_Height - 1) * m_Width + clamp(x, 0, m_Width - 1);
+			if(Index != LastIndex)
+			{
+				LastIndex = Index;
+				if(IsSpecialTile(Index) && !Func(Index))
+					return;
+			}
+
+			if(x == EndX || (y != EndY && NextY < NextX))
+			{
+				y += StepY;
+				NextY += DeltaY;
+			}
+			else
+			{
+				x += StepX;
+				NextX += DeltaX;
+			}
+		}
+	}
 
 	// doors
 	void SetDoorCollisionAt(float x, float y, int Type, int Flags, int Number = TEAM_ALL);
@@ -149,9 +214,21 @@ public:
 
 	// other
 	std::map<int, TextZoneDetail>& GetTextZones() { return m_vZoneTextDetail; }
-	std::optional<ZoneDetail> GetZonedetail(vec2 Pos) const;
-	bool IsActiveActionZone(std::string_view ActionZoneName, vec2 Pos) const;
-	std::optional<vec2> TryGetTeleportOut(vec2 currentPos);
+	const CZoneTile& GetZoneTile(vec2 Pos) const
+	{
+		const int Nx = clamp(round_to_int(Pos.x) / 32, 0, m_Width - 1);
+		const int Ny = clamp(round_to_int(Pos.y) / 32, 0, m_Height - 1);
+		return m_vZoneTiles[Ny * m_Width + Nx];
+	}
+	const ZoneDetail* GetZoneDetail(vec2 Pos) const
+	{
+		const int ZoneID = GetZoneTile(Pos).m_Zone;
+		return ZoneID ? &m_vZones[ZoneID] : nullptr;
+	}
+	int GetActionZoneID(vec2 Pos) const { return GetZoneTile(Pos).m_ActionZone; }
+	const std::string& GetActionZoneName(int ActionZoneID) const { return m_vActionZoneNames[ActionZoneID]; }
+	int FindActionZoneID(std::string_view ActionZoneName) const;
+	std::optional<vec2> TryGetTeleportOut(vec2 currentPos) const;
 	std::optional<std::pair<vec2, bool>> TryGetFixedCamPos(vec2 currentPos) const;
 	const std::unordered_map<int, GatheringNode>& GetOreNodes() const { return m_vOreNodes; }
 	const std::unordered_map<int, GatheringNode>& GetPlantNodes() const { return m_vPlantNodes; }
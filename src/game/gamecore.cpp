@@ -5,6 +5,8 @@
 #include "collision.h"
 #include "mapitems.h"
 
+#include <algorithm>
+
 const char* CTuningParams::ms_apNames[] =
 {
 #define MACRO_TUNING_PARAM(Name, ScriptName, Value) #ScriptName,
@@ -81,6 +83,154 @@ void CTuningParams::ApplyDiff(const CTuningParams* pSource)
 	#undef MACRO_TUNING_PARAM
 }
 
+float CWorldCore::GridCoord(float Value)
+{
+	// far away and broken positions fall into the border cells
+	constexpr float Limit = 1000000.0f;
+	const float Clamped = Value > -Limit ? (Value < Limit ? Value : Limit) : -Limit;
+	return floorf(Clamped / (float)GRID_CELL_SIZE);
+}
+
+int CWorldCore::GridBucket(float CellX, float CellY)
+{
+	const unsigned X = (unsigned)(int)CellX;
+	const unsigned Y = (unsigned)(int)CellY;
+	return (int)(((X * 73856093u) ^ (Y * 19349663u)) % GRID_BUCKETS);
+}
+
+void CWorldCore::GridLink(int ClientID, int Bucket)
+{
+	CGrid& Grid = *m_pGrid;
+	Grid.m_aBucket[ClientID] = Bucket;
+	Grid.m_aPrev[ClientID] = -1;
+	Grid.m_aNext[ClientID] = Grid.m_aHead[Bucket];
+	if(Grid.m_aHead[Bucket] != -1)
+		Grid.m_aPrev[Grid.m_aHead[Bucket]] = ClientID;
+	Grid.m_aHead[Bucket] = ClientID;
+}
+
+void CWorldCore::GridUnlink(int ClientID)
+{
+	CGrid& Grid = *m_pGrid;
+	const int Prev = Grid.m_aPrev[ClientID];
+	const int Next = Grid.m_aNext[ClientID];
+	if(Prev != -1)
+		Grid.m_aNext[Prev] = Next;
+	else
+		Grid.m_aHead[Grid.m_aBucket[ClientID]] = Next;
+	if(Next != -1)
+		Grid.m_aPrev[Next] = Prev;
+}
+
+void CWorldCore::InsertCore(int ClientID, CCharacterCore* pCore)
+{
+	if(ClientID < 0 || ClientID >= MAX_CLIENTS || !pCore)
+		return;
+
+	if(m_apCharacters[ClientID])
+		RemoveCore(ClientID);
+
+	if(!m_pGrid)
+	{
+		m_pGrid = std::make_unique<CGrid>();
+		std::fill(std::begin(m_pGrid->m_aHead), std::end(m_pGrid->m_aHead), -1);
+		mem_zero(m_pGrid->m_aMark, sizeof(m_pGrid->m_aMark));
+		m_pGrid->m_Stamp = 0;
+		m_pGrid->m_NumActive = 0;
+	}
+
+	m_apCharacters[ClientID] = pCore;
+	pCore->m_Id = ClientID;
+	GridLink(ClientID, GridBucket(GridCoord(pCore->m_Pos.x), GridCoord(pCore->m_Pos.y)));
+
+	CGrid& Grid = *m_pGrid;
+	int* pEnd = Grid.m_aActive + Grid.m_NumActive;
+	int* pPos = std::lower_bound(Grid.m_aActive, pEnd, ClientID);
+	std::copy_backward(pPos, pEnd, pEnd + 1);
+	*pPos = ClientID;
+	Grid.m_NumActive++;
+}
+
+void CWorldCore::RemoveCore(int ClientID)
+{
+	if(ClientID < 0 || ClientID >= MAX_CLIENTS || !m_apCharacters[ClientID])
+		return;
+
+	m_apCharacters[ClientID] = nullptr;
+	if(!m_pGrid)
+		return;
+
+	GridUnlink(ClientID);
+	CGrid& Grid = *m_pGrid;
+	int* pEnd = Grid.m_aActive + Grid.m_NumActive;
+	int* pPos = std::lower_bound(Grid.m_aActive, pEnd, ClientID);
+	if(pPos != pEnd && *pPos == ClientID)
+	{
+		std::copy(pPos + 1, pEnd, pPos);
+		Grid.m_NumActive--;
+	}
+}
+
+void CWorldCore::UpdateCore(const CCharacterCore* pCore)
+{
+	const int ClientID = pCore->m_Id;
+	if(!m_pGrid || ClientID < 0 || ClientID >= MAX_CLIENTS || m_apCharacters[ClientID] != pCore)
+		return;
+
+	const int Bucket = GridBucket(GridCoord(pCore->m_Pos.x), GridCoord(pCore->m_Pos.y));
+	if(Bucket == m_pGrid->m_aBucket[ClientID])
+		return;
+
+	GridUnlink(ClientID);
+	GridLink(ClientID, Bucket);
+}
+
+int CWorldCore::FindCores(vec2 Min, vec2 Max, int* pIDs) const
+{
+	if(!m_pGrid || !m_pGrid->m_NumActive)
+		return 0;
+
+	CGrid& Grid = *m_pGrid;
+	const float MinX = GridCoord(Min.x);
+	const float MinY = GridCoord(Min.y);
+	const float MaxX = GridCoord(Max.x);
+	const float MaxY = GridCoord(Max.y);
+	const float NumCells = (MaxX - MinX + 1.0f) * (MaxY - MinY + 1.0f);
+
+	// large or broken boxes are cheaper as a plain scan
+	if(!(NumCells <= (float)minimum((int)GRID_MAX_QUERY_CELLS, Grid.m_NumActive)))
+	{
+		std::copy(Grid.m_aActive, Grid.m_aActive + Grid.m_NumActive, pIDs);
+		return Grid.m_NumActive;
+	}
+
+	// different cells can share a bucket, marks keep every id once
+	if(++Grid.m_Stamp == 0)
+	{
+		mem_zero(Grid.m_aMark, sizeof(Grid.m_aMark));
+		Grid.m_Stamp = 1;
+	}
+
+	int Num = 0;
+	for(float y = MinY; y <= MaxY; y += 1.0f)
+	{
+		for(float x = MinX; x <= MaxX; x += 1.0f)
+		{
+			for(int ID = Grid.m_aHead[GridBucket(x, y)]; ID != -1; ID = Grid.m_aNext[ID])
+			{
+				if(Grid.m_aMark[ID] == Grid.m_Stamp)
+					continue;
+
+				Grid.m_aMark[ID] = Grid.m_Stamp;
+				pIDs[Num++] = ID;
+			}
+		}
+	}
+
+	std::sort(pIDs, pIDs + Num);
+	return Num;
+}
+
 float HermiteBasis1(float v)
 {
 	return 2 * v * v * v - 3 * v * v + 1;
@@ -310,9 +460,16 @@ void CCharacterCore::Tick(bool UseInput, CTuningParams* pTuningParams)
 		// Check against other players first
 		if (m_pWorld && pTuning->m_PlayerHooking)
 		{
+			int aIDs[MAX_CLIENTS];
+			const vec2 Range(PhysicalSize() + 4.0f, PhysicalSize() + 4.0f);
+			const vec2 Min(minimum(m_HookPos.x, NewPos.x), minimum(m_HookPos.y, NewPos.y));
+			const vec2 Max(maximum(m_HookPos.x, NewPos.x), maximum(m_HookPos.y, NewPos.y));
+			const int Num = m_pWorld->FindCores(Min - Range, Max + Range, aIDs);
+
 			float Distance = 0.0f;
-			for (int i = 0; i < MAX_CLIENTS; i++)
+			for (int n = 0; n < Num; n++)
 			{
+				const int i = aIDs[n];
 				CCharacterCore* pCharCore = m_pWorld->m_apCharacters[i];
 				if (!pCharCore || pCharCore->m_CollisionDisabled || m_WorldID != pCharCore->m_WorldID || pCharCore == this)
 					continue;
@@ -410,8 +567,26 @@ void CCharacterCore::Tick(bool UseInput, CTuningParams* pTuningParams)
 
 	if (m_pWorld)
 	{
-		for (int i = 0; i < MAX_CLIENTS; i++)
+		int aIDs[MAX_CLIENTS];
+		const vec2 Range(PhysicalSize() * 1.25f + 4.0f, PhysicalSize() * 1.25f + 4.0f);
+		int Num = m_pWorld->FindCores(m_Pos - Range, m_Pos + Range, aIDs);
+
+		// the hooked player is dragged at any distance
+		if (m_HookedPlayer >= 0 && m_HookedPlayer < MAX_CLIENTS && m_pWorld->m_apCharacters[m_HookedPlayer])
 		{
+			int* pEnd = aIDs + Num;
+			int* pPos = std::lower_bound(aIDs, pEnd, m_HookedPlayer);
+			if (pPos == pEnd || *pPos != m_HookedPlayer)
+			{
+				std::copy_backward(pPos, pEnd, pEnd + 1);
+				*pPos = m_HookedPlayer;
+				Num++;
+			}
+		}
+
+		for (int n = 0; n < Num; n++)
+		{
+			const int i = aIDs[n];
 			CCharacterCore* pCharCore = m_pWorld->m_apCharacters[i];
 			if (!pCharCore || pCharCore->m_CollisionDisabled || m_WorldID != pCharCore->m_WorldID || pCharCore == this)
 				continue;
@@ -507,15 +682,21 @@ void CCharacterCore::Move(CTuningParams* pTuningParams)
 		float Distance = distance(m_Pos, NewPos);
 		if (Distance > 0)
 		{
+			int aIDs[MAX_CLIENTS];
+			const vec2 Range(PhysicalSize() + 4.0f, PhysicalSize() + 4.0f);
+			const vec2 Min(minimum(m_Pos.x, NewPos.x), minimum(m_Pos.y, NewPos.y));
+			const vec2 Max(maximum(m_Pos.x, NewPos.x), maximum(m_Pos.y, NewPos.y));
+			const int Num = m_pWorld->FindCores(Min - Range, Max + Range, aIDs);
+
 			int End = Distance + 1;
 			vec2 LastPos = m_Pos;
 			for (int i = 0; i < End; i++)
 			{
 				float a = i / Distance;
 				vec2 Pos = mix(m_Pos, NewPos, a);
-				for (int p = 0; p < MAX_CLIENTS; p++)
+				for (int n = 0; n < Num; n++)
 				{
-					CCharacterCore* pCharCore = m_pWorld->m_apCharacters[p];
+					CCharacterCore* pCharCore = m_pWorld->m_apCharacters[aIDs[n]];
 					if (!pCharCore || m_WorldID != pCharCore->m_WorldID || pCharCore == this)
 						continue;
 					if((!(pCharCore->m_Super || m_Super) && (m_Solo || pCharCore->m_Solo || pCharCore->m_CollisionDisabled)))
@@ -528,6 +709,7 @@ void CCharacterCore::Move(CTuningParams* pTuningParams)
 							m_Pos = LastPos;
 						else if (distance(NewPos, pCharCore->m_Pos) > D)
 							m_Pos = NewPos;
+						m_pWorld->UpdateCore(this);
 						return;
 					}
 				}
@@ -537,6 +719,8 @@ void CCharacterCore::Move(CTuningParams* pTuningParams)
 	}
 
 	m_Pos = NewPos;
+	if(m_pWorld)
+		m_pWorld->UpdateCore(this);
 }
 
 void CCharacterCore::Write(CNetObj_CharacterCore* pObjCore)
@@ -574,6 +758,8 @@ void CCharacterCore::Read(const CNetObj_CharacterCore* pObjCore)
 	m_Jumped = pObjCore->m_Jumped;
 	m_Direction = pObjCore->m_Direction;
 	m_Angle = pObjCore->m_Angle;
+	if(m_pWorld)
+		m_pWorld->UpdateCore(this);
 }
 
 void CCharacterCore::ReadDDNet(const CNetObj_DDNetCharacter *pObjDDNet)
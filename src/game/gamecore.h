@@ -11,6 +11,8 @@
 
 #include "prng.h"
 
+#include <memory>
+
 class CCollision;
 class CTeamsCore;
 
@@ -187,6 +189,32 @@ enum
 
 class CWorldCore
 {
+	// spatial hash over the registered cores, lets the physics visit only nearby characters
+	enum
+	{
+		GRID_CELL_SIZE = 128,
+		GRID_BUCKETS = 1024,
+		GRID_MAX_QUERY_CELLS = 64,
+	};
+
+	struct CGrid
+	{
+		int m_aHead[GRID_BUCKETS];
+		int m_aNext[MAX_CLIENTS];
+		int m_aPrev[MAX_CLIENTS];
+		int m_aBucket[MAX_CLIENTS];
+		unsigned m_aMark[MAX_CLIENTS];
+		unsigned m_Stamp;
+		int m_aActive[MAX_CLIENTS]; // registered client ids, sorted
+		int m_NumActive;
+	};
+	std::unique_ptr<CGrid> m_pGrid {};
+
+	static float GridCoord(float Value);
+	static int GridBucket(float CellX, float CellY);
+	void GridLink(int ClientID, int Bucket);
+	void GridUnlink(int ClientID);
+
 public:
 	CWorldCore()
 	{
@@ -206,6 +234,13 @@ public:
 		return m_pPrng->RandomBits() % BelowThis;
 	}
 
+	void InsertCore(int ClientID, class CCharacterCore* pCore);
+	void RemoveCore(int ClientID);
+	void UpdateCore(const class CCharacterCore* pCore);
+
+	// ids of the cores that may lie inside the box, ascending like a scan over m_apCharacters
+	int FindCores(vec2 Min, vec2 Max, int* pIDs) const;
+
 	CTuningParams m_Tuning;
 	class CCharacterCore* m_apCharacters[MAX_CLIENTS];
 	CPrng* m_pPrng;
@@ -325,6 +360,7 @@ public:
 	int m_MoveRestrictions;
 	bool m_DamageDisabled;
 	int m_WorldID;
+	int m_Id = -1;
 	std::set<int> m_vDoorHitSet {};
 };
 
@@ -4,12 +4,13 @@
 #define GAME_ALLOC_H
 
 #include <new>
+#include <vector>
 
 #include <base/system.h>
 #ifndef __has_feature
 #define __has_feature(x) 0
 #endif
-#if __has_feature(address_sanitizer)
+#if __has_feature(address_sanitizer) || defined(__SANITIZE_ADDRESS__)
 #include <sanitizer/asan_interface.h>
 #else
 #define ASAN_POISON_MEMORY_REGION(addr, size) \
@@ -33,6 +34,95 @@ public: \
 \
 private:
 
+// like MACRO_ALLOC_HEAP, but freed objects of exactly POOLTYPE are kept for the next
+// new, for objects that are created and destroyed all the time. Game thread only.
+#define MACRO_ALLOC_FREELIST(POOLTYPE, MaxFree) \
+public: \
+	void *operator new(size_t Size) \
+	{ \
+		auto &vFree = FreeBlocks(); \
+		void *p; \
+		if(Size == sizeof(POOLTYPE) && !vFree.empty()) \
+		{ \
+			p = vFree.back(); \
+			vFree.pop_back(); \
+			ASAN_UNPOISON_MEMORY_REGION(p, Size); \
+		} \
+		else \
+			p = malloc(Size); \
+		mem_zero(p, Size); \
+		return p; \
+	} \
+	void operator delete(void *pPtr, size_t Size) \
+	{ \
+		auto &vFree = FreeBlocks(); \
+		if(Size == sizeof(POOLTYPE) && vFree.size() < (MaxFree)) \
+		{ \
+			ASAN_POISON_MEMORY_REGION(pPtr, Size); \
+			vFree.push_back(pPtr); \
+		} \
+		else \
+			free(pPtr); \
+	} \
+\
+private: \
+	static std::vector<void *> &FreeBlocks() \
+	{ \
+		static std::vector<void *> s_vFreeBlocks; \
+		return s_vFreeBlocks; \
+	}
+
+// std allocator with the same reuse for single objects, e.g. for std::allocate_shared
+template<typename T, size_t MaxFree = 256>
+class CFreeListAllocator
+{
+	static std::vector<void *> &FreeBlocks()
+	{
+		static std::vector<void *> s_vFreeBlocks;
+		return s_vFreeBlocks;
+	}
+
+public:
+	using value_type = T;
+	template<typename U>
+	struct rebind
+	{
+		using other = CFreeListAllocator<U, MaxFree>;
+	};
+
+	CFreeListAllocator() = default;
+	template<typename U>
+	CFreeListAllocator(const CFreeListAllocator<U, MaxFree> &) {}
+
+	T *allocate(size_t Num)
+	{
+		auto &vFree = FreeBlocks();
+		if(Num == 1 && !vFree.empty())
+		{
+			void *p = vFree.back();
+			vFree.pop_back();
+			ASAN_UNPOISON_MEMORY_REGION(p, sizeof(T));
+			return static_cast<T *>(p);
+		}
+		return static_cast<T *>(::operator new(Num * sizeof(T)));
+	}
+
+	void deallocate(T *p, size_t Num)
+	{
+		auto &vFree = FreeBlocks();
+		if(Num == 1 && vFree.size() < MaxFree)
+		{
+			ASAN_POISON_MEMORY_REGION(p, sizeof(T));
+			vFree.push_back(p);
+		}
+		else
+			::operator delete(p);
+	}
+
+	template<typename U>
+	bool operator==(const CFreeListAllocator<U, MaxFree> &) const { return true; }
+};
+
 #define MACRO_ALLOC_POOL_ID() \
 public: \
 	void *operator new(size_t Size, int id); \
@@ -211,6 +211,7 @@ struct CAccountSharedData
 {
 	int m_LastKilledByWeapon;
 	CAuctionSlot m_TempAuctionSlot;
+	CAuctionBrowseState m_AuctionBrowse;
 
 	// guest account data
 	int m_AuthType {};
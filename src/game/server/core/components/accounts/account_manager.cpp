@@ -3,6 +3,7 @@
 #include "account_manager.h"
 
 #include <base/hash_ctxt.h>
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/gamecontext.h>
 #include <generated/server_data.h>
 
@@ -133,6 +134,7 @@ class DbAuthorization
 			pPlayer->GetSharedData().m_GuestLogin.clear();
 
 		pPlayer->Account()->Init(Data.m_AccountID, pContext->GetClientID(), Data.m_Login.c_str(), Data.m_Language, Data.m_LoginDate, std::move(pRes));
+		pContext->Server()->RecordClientLogin(pContext->GetClientID(), Data.m_AccountID);
 		pContext->GS()->Chat(pContext->GetClientID(), "Login successful. Welcome back!");
 		if(Data.m_PinCode.empty() && !pPlayer->IsGuestLogin())
 		{
@@ -159,6 +161,28 @@ public:
 		auto pAuth = Database->Prepare<DB::SELECT>("ID", "tw_accounts_data", "WHERE Nick = '{}'", Nick);
 		pAuth->AtExecute([pContext](ResultPtr pRes) { DbAuthorization::OnCheckNickname(pContext, pRes); });
 	}
+
+	// replayed logins were already verified while recording, so credentials are skipped
+	static void StartReplayAuthorization(CAccountManager* pMgr, int ClientID, int AccountID)
+	{
+		auto pContext = DbAsync::MakeContext<DbAuthorization::CAuthorizationPayload>(ClientID,
+			DbAuthorization::CAuthorizationPayload { pMgr, {}, {}, AccountID, {}, {}, {} });
+		auto pCheck = Database->Prepare<DB::SELECT>("Username, LoginDate, Language, PinCode", "tw_accounts", "WHERE ID = '{}'", AccountID);
+		pCheck->AtExecute([pContext](ResultPtr pRes)
+		{
+			auto* pPlayer = pContext->GetPlayer(false);
+			if(!pPlayer || pPlayer->IsAuthed() || !pRes->next())
+				return;
+
+			auto& Data = pContext->Data();
+			Data.m_Login = pRes->getString("Username");
+			Data.m_Language = pRes->getString("Language");
+			Data.m_LoginDate = pRes->getString("LoginDate");
+			Data.m_PinCode = pRes->getString("PinCode");
+			auto pData = Database->Prepare<DB::SELECT>("*", "tw_accounts_data", "WHERE ID = '{}'", Data.m_AccountID);
+			pData->AtExecute([pContext](ResultPtr pDataRes) { OnLoadAccountData(pContext, pDataRes); });
+		});
+	}
 };
 
 class DbRegistration
@@ -181,9 +205,6 @@ class DbRegistration
 		const auto& Data = pContext->Data();
 		if(Data.m_InitID > 0)
 			Database->Execute<DB::REMOVE>("tw_accounts", "WHERE ID = '{}'", Data.m_InitID);
-		else
-			Database->Execute<DB::REMOVE>("tw_accounts", "WHERE Username = '{}' AND Password = '{}' AND PasswordSalt = '{}' ORDER BY ID DESC LIMIT 1",
-				Data.m_Login, Data.m_PasswordHash, Data.m_PasswordSalt);
 
 		pContext->GS()->Chat(pContext->GetClientID(), "Registration failed due to server error.");
 		pContext->GS()->Chat(pContext->GetClientID(), "Please try again a bit later.");
@@ -247,37 +268,29 @@ class DbRegistration
 			return;
 		}
 
-		const auto& Data = pContext->Data();
-		Database->Execute<DB::INSERT>([pContext](bool Updated) { OnInsertAccount(pContext, Updated); },
-			"tw_accounts", "(Username, Password, PasswordSalt, RegisterDate, RegisteredIP) VALUES ('{}', '{}', '{}', UTC_TIMESTAMP(), '{}')",
-			Data.m_Login, Data.m_PasswordHash, Data.m_PasswordSalt, Data.m_RegisteredIP);
-
-	}
-
-	static void OnInsertAccount(const CRegistrationContextPtr& pContext, bool Updated)
-	{
-		if(!Updated)
+		// the account ID comes from the reserved block, no need to read it back after insert
+		auto& Data = pContext->Data();
+		Data.m_InitID = IdAllocator->Next("tw_accounts");
+		if(Data.m_InitID <= 0)
 		{
-			CleanupAccountOnError(pContext);
+			pGS->Chat(pContext->GetClientID(), "Registration failed due to server error.");
+			pGS->Chat(pContext->GetClientID(), "Please try again a bit later.");
 			return;
 		}
 
-		const auto& Data = pContext->Data();
-		auto pInitID = Database->Prepare<DB::SELECT>("ID", "tw_accounts",
-			"WHERE Username = '{}' AND Password = '{}' AND PasswordSalt = '{}' ORDER BY ID DESC LIMIT 1",
-			Data.m_Login, Data.m_PasswordHash, Data.m_PasswordSalt);
-		pInitID->AtExecute([pContext](ResultPtr pRes) { OnResolveAccountID(pContext, pRes); });
+		Database->Execute<DB::INSERT>([pContext](bool Updated) { OnInsertAccount(pContext, Updated); },
+			"tw_accounts", "(ID, Username, Password, PasswordSalt, RegisterDate, RegisteredIP) VALUES ('{}', '{}', '{}', '{}', UTC_TIMESTAMP(), '{}')",
+			Data.m_InitID, Data.m_Login, Data.m_PasswordHash, Data.m_PasswordSalt, Data.m_RegisteredIP);
 	}
 
-	static void OnResolveAccountID(const CRegistrationContextPtr& pContext, ResultPtr pRes)
+	static void OnInsertAccount(const CRegistrationContextPtr& pContext, bool Updated)
 	{
-		if(!pRes->next())
+		if(!Updated)
 		{
 			CleanupAccountOnError(pContext);
 			return;
 		}
 
-		pContext->Data().m_InitID = pRes->getInt("ID");
 		Database->Execute<DB::INSERT>([pContext](bool Updated) { OnInsertAccountData(pContext, Updated); },
 			"tw_accounts_data", "(ID, Nick) VALUES ('{}', '{}')", pContext->Data().m_InitID, pContext->Data().m_Nickname);
 	}
@@ -314,6 +327,22 @@ public:
 };
 
 
+void CAccountManager::OnPreInit()
+{
+	IdAllocator->Register("tw_accounts");
+
+	// seed player top lists
+	auto& TopLists = CMmoController::TopLists();
+	ResultPtr pRes = Database->Execute<DB::SELECT>("ID, Nick, Rating, Bank", "tw_accounts_data");
+	while(pRes->next())
+	{
+		const auto AccountID = pRes->getInt("ID");
+		const auto Nickname = pRes->getString("Nick");
+		TopLists.PlayerRating.Set(AccountID, Nickname, pRes->getInt("Rating"));
+		TopLists.PlayerWealthy.Set(AccountID, Nickname, pRes->getBigInt("Bank"));
+	}
+}
+
 void CAccountManager::OnPlayerLogin(CPlayer* pPlayer)
 {
 	if(!pPlayer || !pPlayer->Account())
@@ -1090,6 +1119,11 @@ AccountCodeResult CAccountManager::LoginAccountRaw(int ClientID, const char* pLo
 	return AccountCodeResult::AOP_LOGIN_OK;
 }
 
+void CAccountManager::LoginAccountByID(int ClientID, int AccountID)
+{
+	DbAuthorization::StartReplayAuthorization(this, ClientID, AccountID);
+}
+
 void CAccountManager::TryLoginGuestByTimeoutCode(int ClientID, const char* pNickname, const char* pCode, const char* pGuestLogin)
 {
 	const auto cNick = CSqlString<32>(pNickname);
@@ -1142,7 +1176,7 @@ void CAccountManager::LoadAccount(CPlayer* pPlayer, bool FirstInitilize)
 	// Check if it is not the first initialization
 	if(!FirstInitilize)
 	{
-		const int Letters = Core()->MailboxManager()->GetMailCount(pAccount->GetID());
+		const int Letters = Core()->MailboxManager()->GetUnreadMailCount(pAccount->GetID());
 		if(Letters > 0)
 		{
 			GS()->Chat(ClientID, "You have '{} unread letters'.", Letters);
@@ -1397,7 +1431,11 @@ bool CAccountManager::ChangeNickname(const std::string& newNickname, int ClientI
 	if(pRes->next())
 		return false;
 
-	Database->Execute<DB::UPDATE>("tw_accounts_data", "Nick = '{}' WHERE ID = '{}'", cClearNick.cstr(), pPlayer->Account()->GetID());
+	const auto AccountID = pPlayer->Account()->GetID();
+	Database->Execute<DB::UPDATE>("tw_accounts_data", "Nick = '{}' WHERE ID = '{}'", cClearNick.cstr(), AccountID);
+	CMmoController::TopLists().PlayerRating.Rename(AccountID, cClearNick.cstr());
+	CMmoController::TopLists().PlayerWealthy.Rename(AccountID, cClearNick.cstr());
+	Server()->UpdateAccountBase(AccountID, cClearNick.cstr(), pPlayer->Account()->GetRatingSystem().GetRating());
 	Server()->SetClientName(ClientID, newNickname.c_str());
 	return true;
 }
@@ -15,6 +15,7 @@ class CAccountManager : public MmoComponent
 		mystd::freeContainer(CAccountData::ms_aData, CAccountSharedData::ms_aPlayerSharedData);
 	}
 
+	void OnPreInit() override;
 	void OnPlayerLogin(CPlayer* pPlayer) override;
 	void OnClientReset(int ClientID) override;
 	void OnCharacterTile(CCharacter* pChr) override;
@@ -37,6 +38,7 @@ public:
 	AccountCodeResult RegisterGuestAccount(int ClientID, const char* pNickname);
 	AccountCodeResult LoginAccount(int ClientID, const char *pLogin, const char *pPassword);
 	AccountCodeResult LoginAccountRaw(int ClientID, const char* pLogin, const char* pPassword);
+	void LoginAccountByID(int ClientID, int AccountID);
 
 	void TryLoginGuestByTimeoutCode(int ClientID, const char* pNickname, const char* pCode, const char* pGuestLogin);
 	void LoadAccount(CPlayer *pPlayer, bool FirstInitilize = false);
@@ -64,6 +64,7 @@ void BonusManager::AddBonus(const TemporaryBonus& bonus)
 		pGS->Chat(m_ClientID, "You have received: '{} +{~.2}%'", bonusType, bonus.Amount);
 	}
 
+	MarkChanged();
 	Save();
 }
 
@@ -99,6 +100,8 @@ void BonusManager::Load()
 			}
 		}
 	}
+
+	MarkChanged();
 }
 
 void BonusManager::Save() const
@@ -147,6 +150,7 @@ void BonusManager::PostTick()
 
 	if(hasChanges)
 	{
+		MarkChanged();
 		Save();
 	}
 }
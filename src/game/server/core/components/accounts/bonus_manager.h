@@ -59,6 +59,7 @@ class BonusManager
 {
 	int m_ClientID{};
 	std::vector<TemporaryBonus> m_vTemporaryBonuses{};
+	uint32_t m_Version{};
 
 public:
 	void Init(int ClientID)
@@ -92,7 +93,15 @@ public:
 	std::string GetBonusActivitiesString() const;
 	std::vector<TemporaryBonus>& GetTemporaryBonuses() { return m_vTemporaryBonuses; }
 
+	// changes whenever the set of bonuses changes, unique over all managers
+	uint32_t GetVersion() const { return m_Version; }
+
 private:
+	void MarkChanged()
+	{
+		static uint32_t s_LastVersion = 0;
+		m_Version = ++s_LastVersion;
+	}
 	void Load();
 	void Save() const;
 };
@@ -241,7 +241,9 @@ void RatingSystem::Save()
 	auto Result = mystd::file::save(m_FileName.c_str(), Data.data(), static_cast<unsigned>(Data.size()));
 	if(Result == mystd::file::result::SUCCESSFUL)
 	{
-		Database->Execute<DB::UPDATE>("tw_accounts_data", "Rating = '{}' WHERE ID = '{}'", m_Rating, m_pAccount->GetID());
+		const auto AccountID = m_pAccount->GetID();
+		Database->Execute<DB::UPDATE>("tw_accounts_data", "Rating = '{}' WHERE ID = '{}'", m_Rating, AccountID);
+		CMmoController::TopLists().PlayerRating.Set(AccountID, Instance::Server()->GetAccountNickname(AccountID), m_Rating);
 	}
 	else
 	{
@@ -23,6 +23,7 @@ public:
 	static CAetherData* CreateElement(const AetherIdentifier& ID)
 	{
 		auto pData = new CAetherData(ID);
+		m_IndexByID.Insert(ID, pData);
 		return m_pData.emplace_back(pData);
 	}
 
@@ -32,6 +33,7 @@ public:
 		str_copy(m_aName, pName, sizeof(m_aName));
 		m_Pos = Pos;
 		m_WorldID = WorldID;
+		m_IndexByPos.Insert(WorldID, Pos, this);
 	}
 
 	AetherIdentifier GetID() const { return m_ID; } // Get the Aether ID
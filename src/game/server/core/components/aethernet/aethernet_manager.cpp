@@ -178,14 +178,10 @@ void CAethernetManager::UnlockLocationByPos(CPlayer* pPlayer, vec2 Pos) const
 
 CAetherData* CAethernetManager::GetAetherByID(int AetherID) const
 {
-	const auto& iter = std::ranges::find_if(CAetherData::Data(), [AetherID](const CAetherData* pAether)
-	                                        { return pAether->GetID() == AetherID; });
-	return iter != CAetherData::Data().end() ? *iter : nullptr;
+	return CAetherData::FindByID(AetherID);
 }
 
 CAetherData* CAethernetManager::GetAetherByPos(vec2 Pos) const
 {
-	const auto& iter = std::ranges::find_if(CAetherData::Data(), [Pos](const CAetherData* pAether)
-	                                        { return distance(pAether->GetPosition(), Pos) < 320.f; });
-	return iter != CAetherData::Data().end() ? *iter : nullptr;
+	return CAetherData::FindByPos(GS()->GetWorldID(), Pos, 320.f);
 }
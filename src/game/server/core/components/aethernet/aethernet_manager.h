@@ -14,6 +14,7 @@ class CAethernetManager : public MmoComponent
 	{
 		// free data
 		mystd::freeContainer(CAetherData::Data(), s_vpAetherSortedList);
+		CAetherData::ClearIndexes();
 	};
 
 	void OnPreInit() override;
@@ -5,4 +5,89 @@
 int CAuctionSlot::GetTaxPrice() const
 {
 	return maximum(1, translate_to_percent_rest(m_Price, g_Config.m_SvAuctionSlotTaxRate));
-}
\ No newline at end of file
+}
+void CAuctionSlot::Init(const CItem& Item, int Price, int OwnerID)
+{
+	RemoveFromIndexes();
+	m_Item = Item;
+	m_Price = Price;
+	m_OwnerID = OwnerID;
+	AddToIndexes();
+}
+
+void CAuctionSlot::AddToIndexes()
+{
+	m_IndexByPrice.insert(this);
+	m_IndexByGroup[m_Item.Info()->GetGroup()].insert(this);
+	m_IndexByItem[m_Item.GetID()].insert(this);
+	m_IndexByOwner[m_OwnerID].push_back(this);
+	m_Indexed = true;
+}
+
+void CAuctionSlot::RemoveFromIndexes()
+{
+	if(!m_Indexed)
+		return;
+
+	// empty buckets are erased, so the group filter only cycles through groups on sale
+	const auto EraseFrom = [this](auto& Index, const auto& Key)
+	{
+		if(const auto It = Index.find(Key); It != Index.end())
+		{
+			if constexpr(std::is_same_v<std::decay_t<decltype(It->second)>, PriceIndex>)
+				It->second.erase(this);
+			else
+				std::erase(It->second, this);
+			if(It->second.empty())
+				Index.erase(It);
+		}
+	};
+	m_IndexByPrice.erase(this);
+	EraseFrom(m_IndexByGroup, m_Item.Info()->GetGroup());
+	EraseFrom(m_IndexByItem, m_Item.GetID());
+	EraseFrom(m_IndexByOwner, m_OwnerID);
+	m_Indexed = false;
+}
+
+void CAuctionSlot::Remove(CAuctionSlot* pSlot)
+{
+	pSlot->RemoveFromIndexes();
+	Unindex(pSlot->m_ID, pSlot);
+
+	// the order of data doesn't matter, the last slot takes the free place
+	auto*& pLast = m_pData.back();
+	pLast->m_DataPos = pSlot->m_DataPos;
+	m_pData[pSlot->m_DataPos] = pLast;
+	m_pData.pop_back();
+	delete pSlot;
+}
+
+void CAuctionSlot::ClearIndexes()
+{
+	MultiworldIdentifiableData::ClearIndexes();
+	m_IndexByPrice.clear();
+	m_IndexByGroup.clear();
+	m_IndexByItem.clear();
+	m_IndexByOwner.clear();
+}
+
+const std::vector<CAuctionSlot*>& CAuctionSlot::GetSlotsByOwner(int AccountID)
+{
+	static const std::vector<CAuctionSlot*> s_vEmpty {};
+	const auto It = m_IndexByOwner.find(AccountID);
+	return It != m_IndexByOwner.end() ? It->second : s_vEmpty;
+}
+
+const CAuctionSlot* CAuctionSlot::GetCheapestByItem(int ItemID)
+{
+	const auto It = m_IndexByItem.find(ItemID);
+	return It != m_IndexByItem.end() ? *It->second.begin() : nullptr;
+}
+
+std::optional<ItemGroup> CAuctionSlot::GetNextGroup(ItemGroup Group)
+{
+	const auto It = m_IndexByGroup.upper_bound(Group);
+	if(It == m_IndexByGroup.end())
+		return std::nullopt;
+	return It->first;
+}
@@ -6,12 +6,46 @@
 #include <game/server/core/components/inventory/item_data.h>
 
 constexpr auto TW_AUCTION_SLOTS_TABLE = "tw_auction_slots";
+
+// browsing filter of a player, default values don't filter
+struct CAuctionFilter
+{
+	ItemGroup m_Group { ItemGroup::Unknown };
+	int m_MinPrice {};
+	int m_MaxPrice {};
+};
+
 class CAuctionSlot : public MultiworldIdentifiableData<std::deque<CAuctionSlot*>>
 {
+public:
+	// ordered by price, then by ID
+	using PriceKey = std::pair<int, int>;
+	struct CPriceOrder
+	{
+		using is_transparent = void;
+		static PriceKey Key(const CAuctionSlot* pSlot) { return { pSlot->m_Price, pSlot->m_ID }; }
+		bool operator()(const CAuctionSlot* pLeft, const CAuctionSlot* pRight) const { return Key(pLeft) < Key(pRight); }
+		bool operator()(const CAuctionSlot* pLeft, const PriceKey& Right) const { return Key(pLeft) < Right; }
+		bool operator()(const PriceKey& Left, const CAuctionSlot* pRight) const { return Left < Key(pRight); }
+	};
+	using PriceIndex = std::set<CAuctionSlot*, CPriceOrder>;
+
+private:
 	int m_ID {};
 	CItem m_Item {};
 	int m_Price {};
 	int m_OwnerID {};
+	size_t m_DataPos {};
+	bool m_Indexed {};
+
+	// listed slots only, the temporary slot of the create menu is never indexed
+	static inline PriceIndex m_IndexByPrice {};
+	static inline std::map<ItemGroup, PriceIndex> m_IndexByGroup {};
+	static inline ska::flat_hash_map<int, PriceIndex> m_IndexByItem {};
+	static inline ska::flat_hash_map<int, std::vector<CAuctionSlot*>> m_IndexByOwner {};
+
+	void AddToIndexes();
+	void RemoveFromIndexes();
 
 public:
 	CAuctionSlot() = default;
@@ -21,22 +55,23 @@ public:
 	{
 		auto* pAuctionSlot = new CAuctionSlot;
 		pAuctionSlot->m_ID = ID;
+		pAuctionSlot->m_DataPos = m_pData.size();
+		m_IndexByID.Insert(ID, pAuctionSlot);
 		return m_pData.emplace_back(pAuctionSlot);
 	}
 
+	// unindex, erase from data and free the slot
+	static void Remove(CAuctionSlot* pSlot);
+	static void ClearIndexes();
+
 	// functions
-	void Init(const CItem& Item, int Price, int OwnerID)
-	{
-		m_Item = Item;
-		m_Price = Price;
-		m_OwnerID = OwnerID;
-	}
+	void Init(const CItem& Item, int Price, int OwnerID);
 
 	int GetID() const { return m_ID; }
 
-	// Setter methods for item and price
-	void SetItem(CItem Item) { m_Item = std::move(Item); }
-	void SetPrice(int Price) { m_Price = Price; }
+	// Setter methods for item and price, only for slots that are not listed
+	void SetItem(CItem Item) { dbg_assert(!m_Indexed, "listed auction slot changed"); m_Item = std::move(Item); }
+	void SetPrice(int Price) { dbg_assert(!m_Indexed, "listed auction slot changed"); m_Price = Price; }
 
 	// Getter methods for item and price
 	CItem* GetItem() { return &m_Item; }                           // Return a pointer to the item
@@ -44,6 +79,44 @@ public:
 	int GetPrice() const { return m_Price; }                       // Return the price
 	int GetTaxPrice() const;                                       // Declaration for a function to calculate the tax price
 	int GetOwnerID() const { return m_OwnerID; }
+
+	// indexed lookups
+	static const std::vector<CAuctionSlot*>& GetSlotsByOwner(int AccountID);
+	static const CAuctionSlot* GetCheapestByItem(int ItemID);
+	static std::optional<ItemGroup> GetNextGroup(ItemGroup Group);
+
+	// visits listed slots matching the filter by price starting at the key, until the callback returns false
+	template<typename F>
+	static void ForEachFiltered(const CAuctionFilter& Filter, const PriceKey& From, F&& Func)
+	{
+		const PriceIndex* pIndex = &m_IndexByPrice;
+		if(Filter.m_Group != ItemGroup::Unknown)
+		{
+			const auto It = m_IndexByGroup.find(Filter.m_Group);
+			if(It == m_IndexByGroup.end())
+				return;
+			pIndex = &It->second;
+		}
+
+		const PriceKey Start = std::max(From, PriceKey { Filter.m_MinPrice, 0 });
+		for(auto It = pIndex->lower_bound(Start); It != pIndex->end(); ++It)
+		{
+			if(Filter.m_MaxPrice > 0 && (*It)->GetPrice() > Filter.m_MaxPrice)
+				break;
+			if(!Func(*It))
+				break;
+		}
+	}
 };
-#endif
 
+// a player's position in the market list, the start keys of the previous pages are kept for going back
+struct CAuctionBrowseState
+{
+	CAuctionFilter m_Filter {};
+	std::vector<CAuctionSlot::PriceKey> m_vPageStarts {};
+
+	CAuctionSlot::PriceKey GetPageStart() const { return m_vPageStarts.empty() ? CAuctionSlot::PriceKey { 0, 0 } : m_vPageStarts.back(); }
+	int GetPage() const { return (int)m_vPageStarts.size() + 1; }
+	void ResetPages() { m_vPageStarts.clear(); }
+};
+#endif
@@ -2,19 +2,26 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "auction_manager.h"
 
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/gamecontext.h>
 #include <game/server/core/components/inventory/inventory_manager.h>
 #include <game/server/core/components/mails/mail_wrapper.h>
 
+// market slots shown per page
+constexpr int AUCTION_PAGE_SIZE = 20;
+
 CAuctionManager::~CAuctionManager()
 {
 	for(auto*& pPtr : CAuctionSlot::Data())
 		delete pPtr;
 	CAuctionSlot::Data().clear();
+	CAuctionSlot::ClearIndexes();
 }
 
 void CAuctionManager::OnPreInit()
 {
+	IdAllocator->Register(TW_AUCTION_SLOTS_TABLE);
+
 	// init auction slots
 	ResultPtr pRes = Database->Execute<DB::SELECT>("*", TW_AUCTION_SLOTS_TABLE);
 	while(pRes->next())
@@ -86,39 +93,60 @@ void CAuctionManager::ShowAuction(CPlayer* pPlayer) const
 
 	// show your auction list
 	VoteWrapper VSelf(ClientID, VWF_SEPARATE_OPEN | VWF_STYLE_SIMPLE, "Your slots {}/{}", UsedsSlots, g_Config.m_SvMaxPlayerAuctionSlots);
-	for(auto& pSlot : CAuctionSlot::Data())
+	for(const auto* pSlot : CAuctionSlot::GetSlotsByOwner(AccountID))
 	{
-		// self slots
-		if(pSlot->GetOwnerID() == AccountID)
-		{
-			const CItem* pItem = pSlot->GetItem();
-			VSelf.AddOption("AUCTION_BUY", pSlot->GetID(), "{}. Cancel: {} x{} ({$})", VSelf.NextPos(), pItem->Info()->GetName(), pItem->GetValue(), pSlot->GetPrice());
-		}
+		const CItem* pItem = pSlot->GetItem();
+		VSelf.AddOption("AUCTION_BUY", pSlot->GetID(), "{}. Cancel: {} x{} ({$})", VSelf.NextPos(), pItem->Info()->GetName(), pItem->GetValue(), pSlot->GetPrice());
 	}
 	VoteWrapper::AddEmptyline(ClientID);
 
-	// show other auction list
-	VoteWrapper VList(ClientID, VWF_SEPARATE_OPEN | VWF_STYLE_SIMPLE, "Market slots");
-	std::vector<const CAuctionSlot*> vOtherSlots;
-	vOtherSlots.reserve(CAuctionSlot::Data().size());
-	for(const auto& pSlot : CAuctionSlot::Data())
-	{
-		if(pSlot->GetOwnerID() != AccountID)
-			vOtherSlots.push_back(pSlot);
-	}
+	// market filter
+	auto& Browse = pPlayer->GetSharedData().m_AuctionBrowse;
+	const auto& Filter = Browse.m_Filter;
+	VoteWrapper VFilter(ClientID, VWF_SEPARATE_OPEN | VWF_STYLE_SIMPLE, "Market filter");
+	VFilter.AddOption("AUCTION_FILTER_GROUP", "Category: {}", Filter.m_Group == ItemGroup::Unknown ? "All" : GetItemGroupName(Filter.m_Group));
+	VFilter.AddOption("AUCTION_FILTER_MIN_PRICE", "Min price: {$}", Filter.m_MinPrice);
+	if(Filter.m_MaxPrice > 0)
+		VFilter.AddOption("AUCTION_FILTER_MAX_PRICE", "Max price: {$}", Filter.m_MaxPrice);
+	else
+		VFilter.AddOption("AUCTION_FILTER_MAX_PRICE", "Max price: any");
+	VFilter.AddOption("AUCTION_FILTER_RESET", "Reset filter");
+	VoteWrapper::AddEmptyline(ClientID);
 
-	std::ranges::sort(vOtherSlots, [](const CAuctionSlot* pLeft, const CAuctionSlot* pRight)
+	// show one page of other slots, only the slots from the page start on are visited
+	VoteWrapper VList(ClientID, VWF_SEPARATE_OPEN | VWF_STYLE_SIMPLE, "Market slots (page {})", Browse.GetPage());
+	std::optional<CAuctionSlot::PriceKey> NextPageStart;
+	int Shown = 0;
+	CAuctionSlot::ForEachFiltered(Filter, Browse.GetPageStart(), [&](const CAuctionSlot* pSlot)
 	{
-		if(pLeft->GetPrice() != pRight->GetPrice())
-			return pLeft->GetPrice() < pRight->GetPrice();
-		return pLeft->GetID() < pRight->GetID();
-	});
+		if(pSlot->GetOwnerID() == AccountID)
+			return true;
+
+		if(Shown >= AUCTION_PAGE_SIZE)
+		{
+			NextPageStart = CAuctionSlot::CPriceOrder::Key(pSlot);
+			return false;
+		}
 
-	for(const auto* pSlot : vOtherSlots)
-	{
 		const CItem* pItem = pSlot->GetItem();
 		VList.AddMenu(MENU_AUCTION_SLOT_SELECT, pSlot->GetID(), "{}. {} x{} | {$} | {~}",
-			VList.NextPos(), pItem->Info()->GetName(), pItem->GetValue(), pSlot->GetPrice(), Server()->GetAccountNickname(pSlot->GetOwnerID()));
+			(Browse.GetPage() - 1) * AUCTION_PAGE_SIZE + VList.NextPos(), pItem->Info()->GetName(), pItem->GetValue(), pSlot->GetPrice(), Server()->GetAccountNickname(pSlot->GetOwnerID()));
+		Shown++;
+		return true;
+	});
+
+	if(!Shown)
+		VList.Add("No slots found.");
+
+	// pages
+	if(Browse.GetPage() > 1 || NextPageStart)
+	{
+		VoteWrapper::AddEmptyline(ClientID);
+		VoteWrapper VPages(ClientID, VWF_SEPARATE_OPEN | VWF_STYLE_SIMPLE, "Pages");
+		if(Browse.GetPage() > 1)
+			VPages.AddOption("AUCTION_PAGE_PREV", "Previous page");
+		if(NextPageStart)
+			VPages.AddOption("AUCTION_PAGE_NEXT", MakeAnyList(NextPageStart->first, NextPageStart->second), "Next page");
 	}
 }
 
@@ -146,6 +174,8 @@ void CAuctionManager::ShowCreateSlot(CPlayer* pPlayer) const
 		VInfo.Add("Available: {}", AvailableValue);
 		VInfo.Add("Min price: {$}", MinimalPrice);
 		VInfo.Add("Tax: {$}", pAuctionData->GetTaxPrice());
+		if(const auto* pCheapest = CAuctionSlot::GetCheapestByItem(ItemID))
+			VInfo.Add("Lowest market price: {$} for x{}", pCheapest->GetPrice(), pCheapest->GetItem()->GetValue());
 		if(Enchant > 0)
 		{
 			VInfo.Add("Enchant level: +{}", Enchant);
@@ -198,6 +228,61 @@ bool CAuctionManager::OnPlayerVoteCommand(CPlayer* pPlayer, const char* pCmd, co
 		return true;
 	}
 
+	if(PPSTR(pCmd, "AUCTION_FILTER_GROUP") == 0)
+	{
+		// cycle through the groups on sale, then back to all
+		auto& Browse = pPlayer->GetSharedData().m_AuctionBrowse;
+		Browse.m_Filter.m_Group = CAuctionSlot::GetNextGroup(Browse.m_Filter.m_Group).value_or(ItemGroup::Unknown);
+		Browse.ResetPages();
+		pPlayer->m_VotesData.UpdateVotesIf(MENU_AUCTION_LIST);
+		return true;
+	}
+
+	if(PPSTR(pCmd, "AUCTION_FILTER_MIN_PRICE") == 0)
+	{
+		auto& Browse = pPlayer->GetSharedData().m_AuctionBrowse;
+		Browse.m_Filter.m_MinPrice = maximum(0, ReasonNumber);
+		Browse.ResetPages();
+		pPlayer->m_VotesData.UpdateVotesIf(MENU_AUCTION_LIST);
+		return true;
+	}
+
+	if(PPSTR(pCmd, "AUCTION_FILTER_MAX_PRICE") == 0)
+	{
+		auto& Browse = pPlayer->GetSharedData().m_AuctionBrowse;
+		Browse.m_Filter.m_MaxPrice = maximum(0, ReasonNumber);
+		Browse.ResetPages();
+		pPlayer->m_VotesData.UpdateVotesIf(MENU_AUCTION_LIST);
+		return true;
+	}
+
+	if(PPSTR(pCmd, "AUCTION_FILTER_RESET") == 0)
+	{
+		auto& Browse = pPlayer->GetSharedData().m_AuctionBrowse;
+		Browse.m_Filter = {};
+		Browse.ResetPages();
+		pPlayer->m_VotesData.UpdateVotesIf(MENU_AUCTION_LIST);
+		return true;
+	}
+
+	if(PPSTR(pCmd, "AUCTION_PAGE_NEXT") == 0)
+	{
+		const int Price = GetIfExists<int>(Extras, 0, NOPE);
+		const int SlotID = GetIfExists<int>(Extras, 1, NOPE);
+		pPlayer->GetSharedData().m_AuctionBrowse.m_vPageStarts.emplace_back(Price, SlotID);
+		pPlayer->m_VotesData.UpdateVotesIf(MENU_AUCTION_LIST);
+		return true;
+	}
+
+	if(PPSTR(pCmd, "AUCTION_PAGE_PREV") == 0)
+	{
+		auto& vPageStarts = pPlayer->GetSharedData().m_AuctionBrowse.m_vPageStarts;
+		if(!vPageStarts.empty())
+			vPageStarts.pop_back();
+		pPlayer->m_VotesData.UpdateVotesIf(MENU_AUCTION_LIST);
+		return true;
+	}
+
 	if(PPSTR(pCmd, "AUCTION_NUMBER") == 0)
 	{
 		// initialize variables
@@ -331,6 +416,14 @@ void CAuctionManager::CreateSlot(CPlayer* pPlayer, CAuctionSlot* pAuctionData) c
 		return;
 	}
 
+	// reserve the slot ID before spending anything
+	const int InitID = IdAllocator->Next(TW_AUCTION_SLOTS_TABLE);
+	if(InitID <= 0)
+	{
+		GS()->Chat(ClientID, "Auction is temporarily unavailable, try again later.");
+		return;
+	}
+
 	// spend tax price
 	if(pPlayer->Account()->SpendCurrency(pAuctionData->GetTaxPrice()))
 	{
@@ -341,10 +434,6 @@ void CAuctionManager::CreateSlot(CPlayer* pPlayer, CAuctionSlot* pAuctionData) c
 		// try to spend selling auction item
 		if(pPlayer->Account()->SpendCurrency(pItem->GetValue(), pItem->GetID()))
 		{
-			// get the highest group ID from the database
-			ResultPtr pResID = Database->Execute<DB::SELECT>("ID", TW_AUCTION_SLOTS_TABLE, "ORDER BY ID DESC LIMIT 1");
-			const int InitID = pResID->next() ? pResID->getInt("ID") + 1 : 1; // Increment the highest group ID by 1, or set to 1 if no previous group exists
-
 			// insert new slot
 			Database->Execute<DB::INSERT>(TW_AUCTION_SLOTS_TABLE, "(ID, ItemID, Value, Price, Enchant, OwnerID) VALUES ('{}', '{}', '{}', '{}', '{}', '{}')",
 				InitID, pItem->GetID(), pItem->GetValue(), pAuctionData->GetPrice(), pItem->GetEnchant(), pPlayer->Account()->GetID());
@@ -414,10 +503,7 @@ bool CAuctionManager::BuySlot(CPlayer* pPlayer, int ID) const
 
 int CAuctionManager::GetSlotsCountByAccountID(int AccountID) const
 {
-	return (int)std::ranges::count_if(CAuctionSlot::Data(), [AccountID](const CAuctionSlot* pSlot)
-	{
-		return pSlot->GetOwnerID() == AccountID;
-	});
+	return (int)CAuctionSlot::GetSlotsByOwner(AccountID).size();
 }
 
 int CAuctionManager::GetTotalSlotsCount() const
@@ -427,11 +513,7 @@ int CAuctionManager::GetTotalSlotsCount() const
 
 CAuctionSlot* CAuctionManager::GetSlot(int ID) const
 {
-	auto it = std::ranges::find_if(CAuctionSlot::Data(), [ID](const CAuctionSlot* pSlot)
-	{
-		return pSlot->GetID() == ID;
-	});
-	return it != CAuctionSlot::Data().end() ? *it : nullptr;
+	return CAuctionSlot::FindByID(ID);
 }
 
 void CAuctionManager::RemoveSlotByID(int ID) const
@@ -439,6 +521,6 @@ void CAuctionManager::RemoveSlotByID(int ID) const
 	if(auto* pSlot = GetSlot(ID))
 	{
 		Database->Execute<DB::REMOVE>(TW_AUCTION_SLOTS_TABLE, "WHERE ID = '{}'", ID);
-		std::erase(CAuctionSlot::Data(), pSlot);
+		CAuctionSlot::Remove(pSlot);
 	}
 }
@@ -1,6 +1,8 @@
 #ifndef GAME_SERVER_CORE_COMPONENTS_DUTIES_DUNGEON_DATA_H
 #define GAME_SERVER_CORE_COMPONENTS_DUTIES_DUNGEON_DATA_H
 
+#include <scenarios/base/scenario_graph.h>
+
 class CGS;
 class CPlayer;
 
@@ -15,7 +17,7 @@ class CDungeonData : public MultiworldIdentifiableData< std::deque< CDungeonData
 	int m_Progress {};
 	int m_Players {};
 	int m_WorldID {};
-	nlohmann::json m_Scenario{};
+	ScenarioGraphPtr m_pScenario {};
 
 public:
 	enum DungeonState
@@ -34,12 +36,12 @@ public:
 		return m_pData.emplace_back(std::move(pData));
 	}
 
-	void Init(const vec2& WaitingDoorPos, int WorldID, const nlohmann::json& Scenario)
+	void Init(const vec2& WaitingDoorPos, int WorldID, ScenarioGraphPtr pScenario)
 	{
 		m_WorldID = WorldID;
 		m_WaitingDoorPos = WaitingDoorPos;
 		m_State = STATE_UNINITIALIZED;
-		m_Scenario = Scenario;
+		m_pScenario = std::move(pScenario);
 	}
 
 	int GetID() const { return m_ID; }
@@ -53,7 +55,7 @@ public:
 	void UpdateProgress(int Progress) { m_Progress = Progress; }
 	void UpdatePlayers(int Players) { m_Players = Players; }
 
-	const nlohmann::json& GetScenario() const { return m_Scenario; }
+	const ScenarioGraphPtr& GetScenario() const { return m_pScenario; }
 	bool IsPlaying() const { return m_State >= STATE_ACTIVE; }
 	int GetProgress() const { return m_Progress; }
 	int GetPlayersNum() const { return m_Players; }
@@ -14,10 +14,10 @@ void CDutiesManager::OnPreInit()
 		const int ID = pRes->getInt("ID");
 		auto WaitingDoorPos = vec2(pRes->getInt("DoorX"), pRes->getInt("DoorY"));
 		auto WorldID = pRes->getInt("WorldID");
-		auto Scenario = pRes->getJson("Scenario");
+		auto pScenario = ScenarioGraph::Compile(pRes->getJson("Scenario"));
 
 		auto* pDungeon = CDungeonData::CreateElement(ID);
-		pDungeon->Init(WaitingDoorPos, WorldID, Scenario);
+		pDungeon->Init(WaitingDoorPos, WorldID, std::move(pScenario));
 	}
 }
 
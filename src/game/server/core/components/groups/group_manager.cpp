@@ -3,12 +3,15 @@
 #include "group_manager.h"
 #include "group_data.h"
 
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/core/tools/vote_optional.h>
 #include <game/server/gamecontext.h>
 #include <generated/server_data.h>
 
 void CGroupManager::OnPreInit()
 {
+	IdAllocator->Register(TW_GROUPS_TABLE);
+
 	// Create a pointer to store the result of the database query
 	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_groups");
 	while(pRes->next())
@@ -55,9 +58,13 @@ GroupData* CGroupManager::CreateGroup(CPlayer* pPlayer) const
 		return nullptr;
 	}
 
-	// Get the highest group ID from the database
-	ResultPtr pResID = Database->Execute<DB::SELECT>("ID", TW_GROUPS_TABLE, "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pResID->next() ? pResID->getInt("ID") + 1 : 1; // Increment the highest group ID by 1, or set to 1 if no previous group exists
+	// Reserve the group ID
+	const int InitID = IdAllocator->Next(TW_GROUPS_TABLE);
+	if(InitID <= 0)
+	{
+		GS()->Chat(pPlayer->GetCID(), "Group creation is temporarily unavailable, try again later.");
+		return nullptr;
+	}
 
 	// Initialize variables
 	int OwnerUID = pPlayer->Account()->GetID();
@@ -1,6 +1,7 @@
 /* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "guild_data.h"
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/gamecontext.h>
 #include <game/server/core/components/mails/mail_wrapper.h>
 
@@ -67,6 +68,7 @@ void CGuild::AddExperience(uint64_t Experience)
 	{
 		Database->Execute<DB::UPDATE>("tw_guilds", "Level = '{}', Exp = '{}' WHERE ID = '{}'", m_Level, m_Experience, m_ID);
 	}
+	CMmoController::TopLists().GuildLeveling.Set(m_ID, GetName(), { m_Level, m_Experience });
 }
 
 GuildResult CGuild::SetLeader(int AccountID)
@@ -97,22 +99,21 @@ GuildResult CGuild::BuyHouse(int HouseID)
 		return GuildResult::BUY_HOUSE_ALREADY_HAVE;
 
 	// find the house data
-	auto IterHouse = std::find_if(CGuildHouse::Data().begin(), CGuildHouse::Data().end(), [&HouseID](const CGuildHouse* p)
-	{ return p->GetID() == HouseID; });
+	auto* pHouse = CGuildHouse::FindByID(HouseID);
 
 	// check house validity
-	if(IterHouse == CGuildHouse::Data().end())
+	if(!pHouse)
 		return GuildResult::BUY_HOUSE_UNAVAILABLE;
 
 	// check if the house is already purchased
-	if((*IterHouse)->IsPurchased())
+	if(pHouse->IsPurchased())
 		return GuildResult::BUY_HOUSE_ALREADY_PURCHASED;
 
 	// try to buy the house
-	if(GetBankManager()->Spend((*IterHouse)->GetInitialFee()))
+	if(GetBankManager()->Spend(pHouse->GetInitialFee()))
 	{
 		// implement the house
-		m_pHouse = *IterHouse;
+		m_pHouse = pHouse;
 		m_pHouse->UpdateGuild(this);
 		m_pHouse->m_RentDays = GUILD_RENT_DAYS_DEFAULT;
 		Database->Execute<DB::UPDATE>(TW_GUILDS_HOUSES, "GuildID = '{}', RentDays = '{}' WHERE ID = '{}'", m_ID, m_pHouse->m_RentDays, HouseID);
@@ -246,6 +247,7 @@ void CGuild::CBank::Add(const BigInt& Value)
 {
 	m_Value += Value;
 	Database->Execute<DB::UPDATE>(TW_GUILDS_TABLE, "Bank = '{}' WHERE ID = '{}'", m_Value, m_pGuild->GetID());
+	CMmoController::TopLists().GuildWealthy.Set(m_pGuild->GetID(), m_pGuild->GetName(), m_Value);
 }
 
 bool CGuild::CBank::Spend(const BigInt& Value)
@@ -255,6 +257,7 @@ bool CGuild::CBank::Spend(const BigInt& Value)
 
 	m_Value -= Value;
 	Database->Execute<DB::UPDATE>(TW_GUILDS_TABLE, "Bank = '{}' WHERE ID = '{}'", m_Value, m_pGuild->GetID());
+	CMmoController::TopLists().GuildWealthy.Set(m_pGuild->GetID(), m_pGuild->GetName(), m_Value);
 	return true;
 }
 
@@ -307,6 +310,9 @@ void CGuild::CLogEntry::Add(int64_t LogFlag, const char* pBuffer, ...)
 		// add the formatted string and timestamp to the logs list
 		const auto cBuf = CSqlString<64>(aBuf);
 		m_aLogs.push_back({ cBuf.cstr(), aBufTimeStamp });
+
+		// nobody waits for the history rows
+		CSqlQueueScope QueueScope(DBLane::BULK);
 		Database->Execute<DB::INSERT>(TW_GUILDS_HISTORY_TABLE, "(GuildID, Text, Time) VALUES ('{}', '{}', '{}')", m_pGuild->GetID(), cBuf.cstr(), aBufTimeStamp);
 	}
 }
@@ -465,8 +471,9 @@ GuildResult CGuild::CRanksManager::Add(const std::string& Rank)
 		return GuildResult::RANK_ADD_LIMIT_HAS_REACHED;
 
 	// get next rank ID
-	ResultPtr pResID = Database->Execute<DB::SELECT>("ID", "tw_guilds_ranks", "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pResID->next() ? pResID->getInt("ID") + 1 : 1;
+	const int InitID = IdAllocator->Next("tw_guilds_ranks");
+	if(InitID <= 0)
+		return GuildResult::RANK_ADD_UNAVAILABLE;
 
 	// implement the new rank
 	GuildIdentifier GuildID = m_pGuild->GetID();
@@ -791,6 +798,7 @@ void CGuild::CMembersManager::Save() const
 	}
 
 	// Update the guild data in the database
+	CSqlQueueScope QueueScope(std::nullopt, DBOrderKey::Guild(m_pGuild->GetID()));
 	Database->Execute<DB::UPDATE, 300>(TW_GUILDS_TABLE, "DefaultRankID = '{}', Members = '{}' WHERE ID = '{}'",
 		m_pGuild->GetRanks()->GetDefaultRank()->GetID(), MembersData.dump().c_str(), m_pGuild->GetID());
 }
@@ -53,6 +53,7 @@ enum class GuildResult : int
 
 	RANK_ADD_LIMIT_HAS_REACHED,          // Cannot add more ranks, limit reached
 	RANK_ADD_ALREADY_EXISTS,             // Rank already exists
+	RANK_ADD_UNAVAILABLE,                // No rank ID could be reserved, database unavailable
 	RANK_REMOVE_IS_DEFAULT,              // Cannot remove default rank
 	RANK_REMOVE_DOES_NOT_EXIST,          // Rank does not exist
 	RANK_RENAME_ALREADY_NAME_EXISTS,     // Rank name already exists
@@ -323,6 +324,15 @@ private:
 	CGuildWarData* m_pWar {};
 	CGuildHouse* m_pHouse {};
 
+	// names are compared case-insensitive, key is lowercased name
+	static inline detail::CIdentifierIndex<std::string, CGuild> m_IndexByName {};
+	static std::string NameKey(const char* pName)
+	{
+		std::string Key(pName);
+		std::ranges::transform(Key, Key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return Key;
+	}
+
 public:
 	CGuild() = default;
 	~CGuild();
@@ -331,6 +341,7 @@ public:
 	{
 		auto pData = new CGuild;
 		pData->m_ID = ID;
+		m_IndexByID.Insert(ID, pData);
 		return m_pData.emplace_back(pData);
 	}
 
@@ -338,6 +349,7 @@ public:
 		uint64_t Experience, int Score, int LeaderUID, const BigInt& Bank, int64_t Logflag, ResultPtr* pRes)
 	{
 		m_Name = Name;
+		m_IndexByName.Insert(NameKey(Name.c_str()), this);
 		m_LeaderUID = LeaderUID;
 		m_Level = Level;
 		m_Experience = Experience;
@@ -352,6 +364,18 @@ public:
 		m_pRanks->UpdateDefaultRank();
 	}
 
+	static CGuild* FindByName(const char* pName) { return m_IndexByName.Find(NameKey(pName)); }
+	static void Unindex(CGuild* pGuild)
+	{
+		m_IndexByName.Erase(NameKey(pGuild->GetName()), pGuild);
+		MultiworldIdentifiableData::Unindex(pGuild->GetID(), pGuild);
+	}
+	static void ClearIndexes()
+	{
+		m_IndexByName.Clear();
+		MultiworldIdentifiableData::ClearIndexes();
+	}
+
 	// Get guild ID
 	GuildIdentifier GetID() const
 	{
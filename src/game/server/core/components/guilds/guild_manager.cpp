@@ -2,6 +2,7 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "guild_manager.h"
 
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/gamecontext.h>
 #include <generated/server_data.h>
 
@@ -12,6 +13,9 @@
 
 void CGuildManager::OnPreInit()
 {
+	IdAllocator->Register(TW_GUILDS_TABLE);
+	IdAllocator->Register("tw_guilds_ranks");
+
 	ResultPtr pRes = Database->Execute<DB::SELECT>("*", TW_GUILDS_TABLE);
 	while(pRes->next())
 	{
@@ -29,6 +33,8 @@ void CGuildManager::OnPreInit()
 
 		// initialize guild
 		CGuild::CreateElement(ID)->Init(Name, JsonMembers, DefaultRankID, Level, Experience, Score, LeaderUID, Bank, LogFlag, &pRes);
+		CMmoController::TopLists().GuildLeveling.Set(ID, Name, { Level, Experience });
+		CMmoController::TopLists().GuildWealthy.Set(ID, Name, Bank);
 	}
 
 	InitWars();
@@ -375,6 +381,7 @@ bool CGuildManager::OnPlayerVoteCommand(CPlayer* pPlayer, const char* pCmd, cons
 		{
 			default: GS()->Chat(ClientID, "Unforeseen error."); break;
 			case GuildResult::RANK_ADD_ALREADY_EXISTS: GS()->Chat(ClientID, "The rank name already exists"); break;
+			case GuildResult::RANK_ADD_UNAVAILABLE: GS()->Chat(ClientID, "Ranks cannot be created right now, please try again later."); break;
 			case GuildResult::RANK_ADD_LIMIT_HAS_REACHED: GS()->Chat(ClientID, "Rank limit reached, '{} out of {}'.", (int)GUILD_RANKS_MAX_COUNT, (int)GUILD_RANKS_MAX_COUNT); break;
 			case GuildResult::RANK_WRONG_NUMBER_OF_CHAR_IN_NAME: GS()->Chat(ClientID, "Minimum number of 'characters 2, maximum 16'."); break;
 			case GuildResult::RANK_SUCCESSFUL:
@@ -1136,6 +1143,14 @@ void CGuildManager::Create(CPlayer* pPlayer, const char* pGuildName) const
 		return;
 	}
 
+	// get next guild ID
+	const int InitID = IdAllocator->Next(TW_GUILDS_TABLE);
+	if(InitID <= 0)
+	{
+		GS()->Chat(ClientID, "Guild creation is temporarily unavailable, try again later.");
+		return;
+	}
+
 	// check guild ticket
 	if(!pPlayer->Account()->SpendCurrency(1, itTicketGuild))
 	{
@@ -1143,10 +1158,6 @@ void CGuildManager::Create(CPlayer* pPlayer, const char* pGuildName) const
 		return;
 	}
 
-	// get next guild ID
-	ResultPtr pResID = Database->Execute<DB::SELECT>("ID", TW_GUILDS_TABLE, "ORDER BY ID DESC LIMIT 1");
-	const int InitID = pResID->next() ? pResID->getInt("ID") + 1 : 1; // TODO: thread save ? hm need for table all time auto increment = 1; NEED FIX IT -- use some kind of uuid
-
 	// implement creation and add to table
 	CGuild* pGuild = CGuild::CreateElement(InitID);
 	const std::string MembersData = R"({"members":[{"id":)" + std::to_string(pPlayer->Account()->GetID()) + R"(,"rank_id":0,"deposit":"0"}]})";
@@ -1154,6 +1165,8 @@ void CGuildManager::Create(CPlayer* pPlayer, const char* pGuildName) const
 	pPlayer->Account()->ReinitializeGuild();
 	Database->Execute<DB::INSERT>(TW_GUILDS_TABLE, "(ID, Name, LeaderUID, Members) VALUES ('{}', '{}', '{}', '{}')",
 		InitID, GuildName.cstr(), pPlayer->Account()->GetID(), MembersData.c_str());
+	CMmoController::TopLists().GuildLeveling.Set(InitID, GuildName.cstr(), { 1, 0 });
+	CMmoController::TopLists().GuildWealthy.Set(InitID, GuildName.cstr(), 0);
 	GS()->Chat(-1, "New guilds '{~}' have been created!", GuildName.cstr());
 	pPlayer->m_VotesData.UpdateVotesIf(MENU_MAIN);
 }
@@ -1194,8 +1207,11 @@ void CGuildManager::Disband(GuildIdentifier ID) const
 	Database->Execute<DB::REMOVE>(TW_GUILDS_TABLE, "WHERE ID = '{}'", pGuild->GetID());
 
 	// erase guild from server
-	delete pGuild;
+	CMmoController::TopLists().GuildLeveling.Remove(pGuild->GetID());
+	CMmoController::TopLists().GuildWealthy.Remove(pGuild->GetID());
+	CGuild::Unindex(pGuild);
 	CGuild::Data().erase(std::find(CGuild::Data().begin(), CGuild::Data().end(), pGuild));
+	delete pGuild;
 }
 
 void CGuildManager::ShowMenu(int ClientID) const
@@ -1834,33 +1850,17 @@ void CGuildManager::ShowLogsMenu(CPlayer* pPlayer) const
 
 CGuild* CGuildManager::GetGuildByID(GuildIdentifier ID) const
 {
-	auto itGuild = std::ranges::find_if(CGuild::Data(), [&ID](CGuild* p)
-	{
-		return p->GetID() == ID;
-	});
-
-
-	return itGuild != CGuild::Data().end() ? (*itGuild) : nullptr;
+	return CGuild::FindByID(ID);
 }
 
 CGuild* CGuildManager::GetGuildByName(const char* pGuildname) const
 {
-	auto itGuild = std::ranges::find_if(CGuild::Data(), [&pGuildname](CGuild* p)
-	{
-		return str_comp_nocase(p->GetName(), pGuildname) == 0;
-	});
-
-	return itGuild != CGuild::Data().end() ? (*itGuild) : nullptr;
+	return CGuild::FindByName(pGuildname);
 }
 
 CGuildHouse* CGuildManager::GetHouseByID(const GuildHouseIdentifier& ID) const
 {
-	auto pHouse = std::ranges::find_if(CGuildHouse::Data(), [&ID](const CGuildHouse* p)
-	{
-		return ID == p->GetID();
-	});
-
-	return pHouse != CGuildHouse::Data().end() ? *pHouse : nullptr;
+	return CGuildHouse::FindByID(ID);
 }
 
 CGuildHouse* CGuildManager::GetHouseByPos(vec2 Pos) const
@@ -1869,12 +1869,7 @@ CGuildHouse* CGuildManager::GetHouseByPos(vec2 Pos) const
 	if(!switchNumber)
 		return nullptr;
 
-	auto pHouse = std::ranges::find_if(CGuildHouse::Data(), [&](auto& p)
-	{
-		return *switchNumber == p->GetID();
-	});
-
-	return pHouse != CGuildHouse::Data().end() ? *pHouse : nullptr;
+	return CGuildHouse::FindByID(*switchNumber);
 }
 
 CFarmzone* CGuildManager::GetHouseFarmzoneByPos(vec2 Pos) const
@@ -1883,11 +1878,8 @@ CFarmzone* CGuildManager::GetHouseFarmzoneByPos(vec2 Pos) const
 	if(!switchNumber)
 		return nullptr;
 
-	for(auto& pHouse : CGuildHouse::Data())
+	if(auto* pHouse = CGuildHouse::FindByID(*switchNumber))
 	{
-		if(*switchNumber != pHouse->GetID())
-			continue;
-
 		for(auto& Farmzone : pHouse->GetFarmzonesManager()->GetContainer())
 		{
 			if(distance(Pos, Farmzone.second.GetPos()) < Farmzone.second.GetRadius())
@@ -13,6 +13,8 @@ class CGuildManager : public MmoComponent
 		// free data
 		mystd::freeContainer(CGuild::Data());
 		mystd::freeContainer(CGuildHouse::Data());
+		CGuild::ClearIndexes();
+		CGuildHouse::ClearIndexes();
 		mystd::freeContainer(CGuildWarHandler::Data());
 	};
 
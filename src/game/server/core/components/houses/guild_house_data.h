@@ -44,6 +44,7 @@ public:
 	{
 		auto pData = new CGuildHouse;
 		pData->m_ID = ID;
+		m_IndexByID.Insert(ID, pData);
 		return m_pData.emplace_back(std::move(pData));
 	}
 
@@ -49,6 +49,7 @@ public:
 	{
 		auto pData = new CHouse();
 		pData->m_ID = ID;
+		m_IndexByID.Insert(ID, pData);
 		return m_pData.emplace_back(std::move(pData));
 	}
 
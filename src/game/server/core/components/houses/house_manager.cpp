@@ -607,12 +607,7 @@ void CHouseManager::ShowMenu(CPlayer* pPlayer) const
 
 CHouse* CHouseManager::GetHouse(HouseIdentifier ID) const
 {
-	auto pHouse = std::ranges::find_if(CHouse::Data(), [ID](auto& p)
-	{
-		return p->GetID() == ID;
-	});
-
-	return pHouse != CHouse::Data().end() ? *pHouse : nullptr;
+	return CHouse::FindByID(ID);
 }
 
 CHouse* CHouseManager::GetHouseByPos(vec2 Pos) const
@@ -621,12 +616,7 @@ CHouse* CHouseManager::GetHouseByPos(vec2 Pos) const
 	if(!switchNumber)
 		return nullptr;
 
-	auto pHouse = std::ranges::find_if(CHouse::Data(), [&](auto& p)
-	{
-		return *switchNumber == p->GetID();
-	});
-
-	return pHouse != CHouse::Data().end() ? *pHouse : nullptr;
+	return CHouse::FindByID(*switchNumber);
 }
 
 CFarmzone* CHouseManager::GetHouseFarmzoneByPos(vec2 Pos) const
@@ -635,12 +625,9 @@ CFarmzone* CHouseManager::GetHouseFarmzoneByPos(vec2 Pos) const
 	if(!switchNumber)
 		return nullptr;
 
-	for(auto& p : CHouse::Data())
+	if(auto* pHouse = CHouse::FindByID(*switchNumber))
 	{
-		if(*switchNumber != p->GetID())
-			continue;
-
-		for(auto& Farmzone : p->GetFarmzonesManager()->GetContainer())
+		for(auto& Farmzone : pHouse->GetFarmzonesManager()->GetContainer())
 		{
 			if(distance(Pos, Farmzone.second.GetPos()) < Farmzone.second.GetRadius())
 				return &Farmzone.second;
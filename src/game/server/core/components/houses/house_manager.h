@@ -15,6 +15,7 @@ class CHouseManager : public MmoComponent
 	{
 		// free data
 		mystd::freeContainer(CHouse::Data());
+		CHouse::ClearIndexes();
 	}
 
 	void OnInitWorld(const std::string& SqlQueryWhereWorld) override;
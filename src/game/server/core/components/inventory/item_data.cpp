@@ -100,6 +100,7 @@ namespace
 				UserID, ItemID, Value, Settings, Enchant, Durability > 0 ? Durability : 100, ExpiresAt, Key, Serial,
 			});
 
+			CSqlQueueScope QueueScope(std::nullopt, DBOrderKey::Account(UserID));
 			OnWrite(pContext);
 		}
 	};
@@ -2,40 +2,103 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "mail_wrapper.h"
 
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/gamecontext.h>
 #include "mailbox_manager.h"
 
+namespace
+{
+	struct CQueuedMail
+	{
+		int m_AccountID {};
+		CMailData m_Mail {};
+	};
+
+	// mails waiting for an id or for a failed insert, shared by all worlds
+	std::mutex s_QueueMutex {};
+	std::vector<CQueuedMail> s_vQueue {};
+
+	void QueueMail(int AccountID, CMailData Mail)
+	{
+		std::lock_guard Lock(s_QueueMutex);
+		s_vQueue.push_back({ AccountID, std::move(Mail) });
+	}
+
+	// the recipient's cache only gets the mail once the row is stored, a failed insert
+	// keeps its id, so a retry can't store the mail twice
+	void StoreMail(int AccountID, CMailData Mail)
+	{
+		if(Mail.m_ID <= 0)
+			Mail.m_ID = IdAllocator->Next(TW_ACCOUNTS_MAILBOX_TABLE);
+		if(Mail.m_ID <= 0)
+		{
+			dbg_msg("mail", "no mail id available, mail '%s' to account %d is queued", Mail.m_Name.c_str(), AccountID);
+			QueueMail(AccountID, std::move(Mail));
+			return;
+		}
+
+		// parse description's
+		std::string EndDescription {};
+		for(auto& Line : Mail.m_vDescriptions)
+			EndDescription += Line + "\n";
+
+		// prepare sql string
+		const CSqlString<64> cTitle = CSqlString<64>(Mail.m_Name.c_str());
+		const CSqlString<64> cSender = CSqlString<64>(Mail.m_Sender.c_str());
+		const CSqlString<256> cDesc = CSqlString<256>(EndDescription.c_str());
+
+		// get prepared json attached items
+		nlohmann::json preparedItemsJson {};
+		preparedItemsJson["items"] = Mail.m_vAttachedItems;
+
+		const int MailID = Mail.m_ID;
+		Database->Execute<DB::INSERT>([AccountID, Mail](bool Inserted) mutable
+		{
+			if(!Inserted)
+			{
+				dbg_msg("mail", "failed to store mail %d to account %d, it is queued", Mail.m_ID, AccountID);
+				QueueMail(AccountID, std::move(Mail));
+				return;
+			}
+
+			CMailboxCache::Deliver(AccountID, std::move(Mail));
+		}, TW_ACCOUNTS_MAILBOX_TABLE, "(ID, Name, Description, AttachedItems, UserID, Sender) VALUES ('{}', '{}', '{}', '{}', '{}', '{}');",
+			MailID, cTitle.cstr(), cDesc.cstr(), preparedItemsJson.dump().c_str(), AccountID, cSender.cstr());
+	}
+}
+
 void MailWrapper::Send()
 {
 	CGS* pGS = (CGS*)Instance::GameServer();
 
+	CMailData Mail;
+	Mail.m_Name = m_Title;
+	Mail.m_Sender = m_Sender;
+	Mail.m_vDescriptions = m_vDescriptionLines;
+	Mail.m_vAttachedItems = m_vAttachedItems;
+	StoreMail(m_AccountID, std::move(Mail));
+
 	// send information about new message
 	const bool LocalMsg = pGS->ChatAccount(m_AccountID, "[Mail] New mail: {}", m_Title);
 	if(LocalMsg)
 	{
 		const int LetterCount = pGS->Core()->MailboxManager()->GetMailCount(m_AccountID);
-		if(LetterCount >= (int)MAIL_MAX_CAPACITY)
+		if(LetterCount > (int)MAIL_MAX_CAPACITY)
 		{
 			pGS->ChatAccount(m_AccountID, "[Mail] Mailbox is full.");
 			pGS->ChatAccount(m_AccountID, "[Mail] Clear old mails to receive new ones.");
 		}
 	}
+}
 
-	// parse description's
-	std::string EndDescription {};
-	for(auto& Line : m_vDescriptionLines)
-		EndDescription += Line + "\n";
-
-	// prepare sql string
-	const CSqlString<64> cTitle = CSqlString<64>(m_Title.c_str());
-	const CSqlString<64> cSender = CSqlString<64>(m_Sender.c_str());
-	const CSqlString<256> cDesc = CSqlString<256>(EndDescription.c_str());
-
-	// get prepared json attached items
-	nlohmann::json preparedItemsJson {};
-	preparedItemsJson["items"] = m_vAttachedItems;
+void MailWrapper::SendQueued()
+{
+	std::vector<CQueuedMail> vQueue;
+	{
+		std::lock_guard Lock(s_QueueMutex);
+		vQueue.swap(s_vQueue);
+	}
 
-	// send to database
-	Database->Execute<DB::INSERT>("tw_accounts_mailbox", "(Name, Description, AttachedItems, UserID, Sender) VALUES ('{}', '{}', '{}', '{}', '{}');",
-		cTitle.cstr(), cDesc.cstr(), preparedItemsJson.dump().c_str(), m_AccountID, cSender.cstr());
+	for(auto& Queued : vQueue)
+		StoreMail(Queued.m_AccountID, std::move(Queued.m_Mail));
 }
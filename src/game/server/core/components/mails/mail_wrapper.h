@@ -35,7 +35,11 @@ public:
 		return *this;
 	}
 
+	// a mail that can't be stored yet is queued and retried, it is never dropped
 	void Send();
+
+	// stores queued mails, called once per second
+	static void SendQueued();
 };
 
 #endif
\ No newline at end of file
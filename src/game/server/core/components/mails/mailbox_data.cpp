@@ -0,0 +1,186 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#include "mailbox_data.h"
+
+void CMailboxCache::Load(int ClientID, int AccountID)
+{
+	{
+		std::lock_guard Lock(m_Mutex);
+		auto it = m_Mailboxes.find(AccountID);
+		if(it != m_Mailboxes.end() && it->second.m_ClientID == ClientID)
+			return;
+
+		m_Mailboxes[AccountID] = CMailbox { ClientID };
+	}
+
+	const auto pSelect = Database->Prepare<DB::SELECT>("*", TW_ACCOUNTS_MAILBOX_TABLE, "WHERE UserID = '{}'", AccountID);
+	pSelect->AtExecute([ClientID, AccountID](ResultPtr pRes)
+	{
+		std::vector<CMailData> vMails {};
+		while(pRes->next())
+		{
+			CMailData Mail;
+			Mail.m_ID = pRes->getInt("ID");
+			Mail.m_Name = pRes->getString("Name").c_str();
+			Mail.m_Sender = pRes->getString("Sender").c_str();
+			Mail.m_vDescriptions = ParseDescription(pRes->getString("Description").c_str());
+			Mail.m_vAttachedItems = pRes->getJson("AttachedItems").value("items", CItemsContainer {});
+			Mail.m_Readed = pRes->getBoolean("Readed");
+			vMails.push_back(std::move(Mail));
+		}
+
+		// the client may have left while loading
+		std::lock_guard Lock(m_Mutex);
+		auto it = m_Mailboxes.find(AccountID);
+		if(it == m_Mailboxes.end() || it->second.m_ClientID != ClientID)
+			return;
+
+		// mails delivered while loading are already inside
+		auto& Mailbox = it->second;
+		for(auto& Mail : vMails)
+			Insert(Mailbox, std::move(Mail));
+		Mailbox.m_Loaded = true;
+	});
+}
+
+void CMailboxCache::Unload(int ClientID)
+{
+	std::lock_guard Lock(m_Mutex);
+	for(auto it = m_Mailboxes.begin(); it != m_Mailboxes.end();)
+	{
+		if(it->second.m_ClientID == ClientID)
+			it = m_Mailboxes.erase(it);
+		else
+			++it;
+	}
+}
+
+bool CMailboxCache::Deliver(int AccountID, CMailData Mail)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	if(it == m_Mailboxes.end())
+		return false;
+
+	Insert(it->second, std::move(Mail));
+	return true;
+}
+
+bool CMailboxCache::IsLoaded(int AccountID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	return it != m_Mailboxes.end() && it->second.m_Loaded;
+}
+
+int CMailboxCache::GetCount(int AccountID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	return it != m_Mailboxes.end() ? (int)it->second.m_vMails.size() : 0;
+}
+
+int CMailboxCache::GetUnreadCount(int AccountID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	return it != m_Mailboxes.end() ? it->second.m_UnreadCount : 0;
+}
+
+std::vector<CMailData> CMailboxCache::GetMails(int AccountID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	return it != m_Mailboxes.end() ? it->second.m_vMails : std::vector<CMailData> {};
+}
+
+std::optional<CMailData> CMailboxCache::GetMail(int AccountID, int MailID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	if(it == m_Mailboxes.end())
+		return std::nullopt;
+
+	for(const auto& Mail : it->second.m_vMails)
+	{
+		if(Mail.m_ID == MailID)
+			return Mail;
+	}
+	return std::nullopt;
+}
+
+bool CMailboxCache::MarkReaded(int AccountID, int MailID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	if(it == m_Mailboxes.end())
+		return false;
+
+	for(auto& Mail : it->second.m_vMails)
+	{
+		if(Mail.m_ID != MailID)
+			continue;
+
+		if(Mail.m_Readed)
+			return false;
+		Mail.m_Readed = true;
+		it->second.m_UnreadCount--;
+		return true;
+	}
+	return false;
+}
+
+std::optional<CMailData> CMailboxCache::Take(int AccountID, int MailID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	if(it == m_Mailboxes.end())
+		return std::nullopt;
+
+	// removed from the cache first, so the mail can't be claimed twice
+	auto& vMails = it->second.m_vMails;
+	auto itMail = std::find_if(vMails.begin(), vMails.end(), [MailID](const CMailData& Mail) { return Mail.m_ID == MailID; });
+	if(itMail == vMails.end())
+		return std::nullopt;
+
+	CMailData Mail = std::move(*itMail);
+	vMails.erase(itMail);
+	if(!Mail.m_Readed)
+		it->second.m_UnreadCount--;
+	return Mail;
+}
+
+void CMailboxCache::RemoveReaded(int AccountID)
+{
+	std::lock_guard Lock(m_Mutex);
+	auto it = m_Mailboxes.find(AccountID);
+	if(it == m_Mailboxes.end())
+		return;
+
+	std::erase_if(it->second.m_vMails, [](const CMailData& Mail) { return Mail.m_Readed; });
+}
+
+std::vector<std::string> CMailboxCache::ParseDescription(const std::string& Description)
+{
+	std::vector<std::string> vDescriptions {};
+	size_t start, end = 0;
+	while((start = Description.find_first_not_of("\n", end)) != std::string::npos)
+	{
+		end = Description.find("\n", start);
+		vDescriptions.push_back(Description.substr(start, end - start));
+	}
+	return vDescriptions;
+}
+
+void CMailboxCache::Insert(CMailbox& Mailbox, CMailData Mail)
+{
+	// keep the mails ordered by id
+	auto& vMails = Mailbox.m_vMails;
+	auto itPos = std::lower_bound(vMails.begin(), vMails.end(), Mail.m_ID, [](const CMailData& Other, int ID) { return Other.m_ID < ID; });
+	if(itPos != vMails.end() && itPos->m_ID == Mail.m_ID)
+		return;
+
+	if(!Mail.m_Readed)
+		Mailbox.m_UnreadCount++;
+	vMails.insert(itPos, std::move(Mail));
+}
@@ -0,0 +1,62 @@
+/* (c) Magnus Auvinen. See licence.txt in the root of the distribution for more information. */
+/* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#ifndef GAME_SERVER_CORE_COMPONENTS_MAILS_MAILBOX_DATA_H
+#define GAME_SERVER_CORE_COMPONENTS_MAILS_MAILBOX_DATA_H
+
+#include <game/server/core/components/inventory/item_data.h>
+
+constexpr auto TW_ACCOUNTS_MAILBOX_TABLE = "tw_accounts_mailbox";
+
+struct CMailData
+{
+	int m_ID {};
+	std::string m_Name {};
+	std::string m_Sender {};
+	std::vector<std::string> m_vDescriptions {};
+	CItemsContainer m_vAttachedItems {};
+	bool m_Readed {};
+};
+
+/*
+ * Mailboxes of online accounts, loaded asynchronously on login.
+ * Database callbacks fill it from SQL threads, so every access is locked
+ * and returns copies. The database stays the source of truth, all changes
+ * are written through by the mailbox manager.
+ */
+class CMailboxCache
+{
+	struct CMailbox
+	{
+		int m_ClientID {};
+		bool m_Loaded {};
+		int m_UnreadCount {};
+		std::vector<CMailData> m_vMails {};
+	};
+
+	static inline std::mutex m_Mutex {};
+	static inline ska::flat_hash_map<int, CMailbox> m_Mailboxes {};
+
+public:
+	static void Load(int ClientID, int AccountID);
+	static void Unload(int ClientID);
+
+	// adds the mail if the recipient is online, returns false otherwise
+	static bool Deliver(int AccountID, CMailData Mail);
+
+	static bool IsLoaded(int AccountID);
+	static int GetCount(int AccountID);
+	static int GetUnreadCount(int AccountID);
+	static std::vector<CMailData> GetMails(int AccountID);
+	static std::optional<CMailData> GetMail(int AccountID, int MailID);
+
+	static bool MarkReaded(int AccountID, int MailID);
+	static std::optional<CMailData> Take(int AccountID, int MailID);
+	static void RemoveReaded(int AccountID);
+
+	static std::vector<std::string> ParseDescription(const std::string& Description);
+
+private:
+	static void Insert(CMailbox& Mailbox, CMailData Mail);
+};
+
+#endif
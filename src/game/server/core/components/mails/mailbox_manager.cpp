@@ -2,9 +2,32 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "mailbox_manager.h"
 
+#include <engine/server/sql_id_allocator.h>
 #include <game/server/gamecontext.h>
 #include "mail_wrapper.h"
 
+void CMailboxManager::OnPreInit()
+{
+	IdAllocator->Register(TW_ACCOUNTS_MAILBOX_TABLE);
+}
+
+void CMailboxManager::OnPlayerLogin(CPlayer* pPlayer)
+{
+	CMailboxCache::Load(pPlayer->GetCID(), pPlayer->Account()->GetID());
+}
+
+void CMailboxManager::OnClientReset(int ClientID)
+{
+	CMailboxCache::Unload(ClientID);
+}
+
+void CMailboxManager::OnTick()
+{
+	// the queue is shared, one world retries it
+	if(GS()->GetWorldID() == INITIALIZER_WORLD_ID && Server()->Tick() % Server()->TickSpeed() == 0)
+		MailWrapper::SendQueued();
+}
+
 bool CMailboxManager::OnPlayerVoteCommand(CPlayer* pPlayer, const char* pCmd, const std::vector<std::any> &Extras, int ReasonNumber, const char* pReason)
 {
 	// accept mail by id
@@ -22,7 +45,7 @@ bool CMailboxManager::OnPlayerVoteCommand(CPlayer* pPlayer, const char* pCmd, co
 	if(PPSTR(pCmd, "MAIL_DELETE") == 0)
 	{
         const int MailID = GetIfExists<int>(Extras, 0, NOPE);
-		DeleteMail(MailID);
+		DeleteMail(pPlayer->Account()->GetID(), MailID);
 		pPlayer->m_VotesData.UpdateVotes(MENU_MAILBOX);
 		return true;
 	}
@@ -75,11 +98,14 @@ bool CMailboxManager::OnSendMenuVotes(CPlayer* pPlayer, int Menulist)
 }
 
 // check whether messages are available
-int CMailboxManager::GetMailCount(int AccountID)
+int CMailboxManager::GetMailCount(int AccountID) const
+{
+	return CMailboxCache::GetCount(AccountID);
+}
+
+int CMailboxManager::GetUnreadMailCount(int AccountID) const
 {
-	ResultPtr pRes = Database->Execute<DB::SELECT>("ID", "tw_accounts_mailbox", "WHERE UserID = '{}'", AccountID);
-	const int MailValue = (int)pRes->rowsCount();
-	return MailValue;
+	return CMailboxCache::GetUnreadCount(AccountID);
 }
 
 // show a list of mails
@@ -95,25 +121,27 @@ void CMailboxManager::ShowMailboxList(CPlayer *pPlayer)
 	std::vector<BasicMailInfo> vUnreadMails {};
 	std::vector<BasicMailInfo> vReadedMails {};
 
-	// collect by found from database
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_accounts_mailbox", "WHERE UserID = '{}'", pPlayer->Account()->GetID());
-	while(pRes->next())
+	// mailbox is still loading after login
+	const int ClientID = pPlayer->GetCID();
+	const int AccountID = pPlayer->Account()->GetID();
+	if(!CMailboxCache::IsLoaded(AccountID))
 	{
-		const bool Readed = pRes->getBoolean("Readed");
-
-		// add new element
-		BasicMailInfo Mail;
-		Mail.m_ID = pRes->getInt("ID");
-		Mail.m_Name = pRes->getString("Name").c_str();
-		Mail.m_Sender = pRes->getString("Sender").c_str();
-		if(Readed && vReadedMails.size() < MAIL_MAX_CAPACITY)
-			vReadedMails.push_back(Mail);
-		else if(vUnreadMails.size() < MAIL_MAX_CAPACITY)
-			vUnreadMails.push_back(Mail);
+		VoteWrapper(ClientID, VWF_SEPARATE | VWF_STYLE_STRICT_BOLD, "Mailbox").Add("Mailbox is loading, try again later.");
+		VoteWrapper::AddEmptyline(ClientID);
+		return;
+	}
+
+	// collect from the cached mailbox
+	for(const auto& Mail : CMailboxCache::GetMails(AccountID))
+	{
+		BasicMailInfo Info { Mail.m_ID, Mail.m_Name, Mail.m_Sender };
+		if(Mail.m_Readed && vReadedMails.size() < MAIL_MAX_CAPACITY)
+			vReadedMails.push_back(std::move(Info));
+		else if(!Mail.m_Readed && vUnreadMails.size() < MAIL_MAX_CAPACITY)
+			vUnreadMails.push_back(std::move(Info));
 	}
 
 	// information
-	const int ClientID = pPlayer->GetCID();
 	VoteWrapper VInfo(ClientID, VWF_SEPARATE | VWF_STYLE_STRICT_BOLD, "Mailbox help");
 	VInfo.Add("Open mail to read and claim items.");
 	VInfo.Add("Use Claim to get items, Delete to remove.");
@@ -142,31 +170,15 @@ void CMailboxManager::ShowMail(int MailID, CPlayer* pPlayer) const
 	const int ClientID = pPlayer->GetCID();
 	const int AccountID = pPlayer->Account()->GetID();
 
-	MarkReadedMail(MailID);
+	MarkReadedMail(AccountID, MailID);
 
-	// found from database by mail id
-	ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_accounts_mailbox", "WHERE ID = '{}' AND UserID = '{}'", MailID, AccountID);
-	if(pRes->next())
+	// found from cache by mail id
+	if(const auto Mail = CMailboxCache::GetMail(AccountID, MailID))
 	{
-		// get the information to create an object
-		std::string Name = pRes->getString("Name").c_str();
-		std::string Sender = pRes->getString("Sender").c_str();
-
-		// parse items
-		const auto attachedItemsJson = pRes->getJson("AttachedItems");
-		CItemsContainer vAttachedItems = attachedItemsJson.value("items", CItemsContainer {});
-
-		// parse description lines
-		std::string Descriptions = pRes->getString("Description").c_str();
-		std::vector<std::string> vDescriptions {};
-		{
-			size_t start, end = 0;
-			while((start = Descriptions.find_first_not_of("\n", end)) != std::string::npos)
-			{
-				end = Descriptions.find("\n", start);
-				vDescriptions.push_back(Descriptions.substr(start, end - start));
-			}
-		}
+		const auto& Name = Mail->m_Name;
+		const auto& Sender = Mail->m_Sender;
+		const auto& vAttachedItems = Mail->m_vAttachedItems;
+		const auto& vDescriptions = Mail->m_vDescriptions;
 
 		// show mail information
 		VoteWrapper VInfo(ClientID, VWF_SEPARATE | VWF_STYLE_STRICT_BOLD, "{}", Name);
@@ -194,13 +206,13 @@ void CMailboxManager::ShowMail(int MailID, CPlayer* pPlayer) const
 
 bool CMailboxManager::AcceptMail(CPlayer* pPlayer, int MailID)
 {
-	ResultPtr pRes = Database->Execute<DB::SELECT>("AttachedItems", "tw_accounts_mailbox", "WHERE ID = '{}' AND UserID = '{}'", MailID, pPlayer->Account()->GetID());
-	if(!pRes->next())
+	// take the mail out of the cache before giving anything
+	const int AccountID = pPlayer->Account()->GetID();
+	auto Mail = CMailboxCache::Take(AccountID, MailID);
+	if(!Mail)
 		return false;
 
-	// parse items
-	const auto attachedItemsJson = pRes->getJson("AttachedItems");
-	CItemsContainer vAttachedItems = attachedItemsJson.value("items", CItemsContainer {});
+	const auto& vAttachedItems = Mail->m_vAttachedItems;
 
 	// accept attached items
 	CItemsContainer vCannotAcceptableItems {};
@@ -220,9 +232,12 @@ bool CMailboxManager::AcceptMail(CPlayer* pPlayer, int MailID)
 		}
 	}
 
-	// not one item can be accepted
+	// not one item can be accepted, put the mail back
 	if(vAttachedItems.size() == vCannotAcceptableItems.size())
+	{
+		CMailboxCache::Deliver(AccountID, std::move(*Mail));
 		return false;
+	}
 
 	// send mail only with unaccable items
 	if(!vCannotAcceptableItems.empty())
@@ -235,23 +250,26 @@ bool CMailboxManager::AcceptMail(CPlayer* pPlayer, int MailID)
 	}
 
 	// is empty letter
-	DeleteMail(MailID);
+	DeleteMail(AccountID, MailID);
 	return true;
 }
 
 void CMailboxManager::DeleteReadMails(int AccountID) const
 {
-	Database->Execute<DB::REMOVE>("tw_accounts_mailbox", "WHERE UserID = '{}' AND Readed = '1'", AccountID);
+	CMailboxCache::RemoveReaded(AccountID);
+	Database->Execute<DB::REMOVE>(TW_ACCOUNTS_MAILBOX_TABLE, "WHERE UserID = '{}' AND Readed = '1'", AccountID);
 }
 
-void CMailboxManager::MarkReadedMail(int MailID) const
+void CMailboxManager::MarkReadedMail(int AccountID, int MailID) const
 {
-	// mark readed mail
-	Database->Execute<DB::UPDATE>("tw_accounts_mailbox", "Readed = '1' WHERE ID = '{}'", MailID);
+	// mark readed mail, only written when it changed
+	if(CMailboxCache::MarkReaded(AccountID, MailID))
+		Database->Execute<DB::UPDATE>(TW_ACCOUNTS_MAILBOX_TABLE, "Readed = '1' WHERE ID = '{}'", MailID);
 }
 
-void CMailboxManager::DeleteMail(int MailID) const
+void CMailboxManager::DeleteMail(int AccountID, int MailID) const
 {
-	// remove from database
-	Database->Execute<DB::REMOVE>("tw_accounts_mailbox", "WHERE ID = '{}'", MailID);
+	// remove from cache and database
+	CMailboxCache::Take(AccountID, MailID);
+	Database->Execute<DB::REMOVE>(TW_ACCOUNTS_MAILBOX_TABLE, "WHERE ID = '{}' AND UserID = '{}'", MailID, AccountID);
 }
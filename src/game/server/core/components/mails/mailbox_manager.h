@@ -4,15 +4,21 @@
 #define GAME_SERVER_CORE_COMPONENTS_MAILS_MAILBOX_MANAGER_H
 
 #include <game/server/core/mmo_component.h>
+#include "mailbox_data.h"
 
 class CMailboxManager : public MmoComponent
 {
+	void OnPreInit() override;
+	void OnPlayerLogin(CPlayer* pPlayer) override;
+	void OnClientReset(int ClientID) override;
+	void OnTick() override;
 	bool OnPlayerVoteCommand(CPlayer* pPlayer, const char* pCmd, const std::vector<std::any> &Extras, int ReasonNumber, const char* pReason) override;
 	bool OnSendMenuVotes(CPlayer* pPlayer, int Menulist) override;
 
 public:
 	// get mail count
-	int GetMailCount(int AccountID);
+	int GetMailCount(int AccountID) const;
+	int GetUnreadMailCount(int AccountID) const;
 
 	// vote list's menus
 	void ShowMailboxList(CPlayer *pPlayer);
@@ -22,8 +28,8 @@ private:
 
 	bool AcceptMail(CPlayer* pPlayer, int MailID);
 	void DeleteReadMails(int AccountID) const;
-	void MarkReadedMail(int MailID) const;
-	void DeleteMail(int MailID) const;
+	void MarkReadedMail(int AccountID, int MailID) const;
+	void DeleteMail(int AccountID, int MailID) const;
 };
 
 #endif
\ No newline at end of file
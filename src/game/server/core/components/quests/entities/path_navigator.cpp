@@ -41,7 +41,7 @@ void CEntityPathNavigator::Tick()
 	{
 		if(m_TickLastIdle < Server()->Tick() && distance(PlayerPos, m_PosTo) > 240.f)
 		{
-			GS()->PathFinder()->RequestPath(m_PathHandle, PlayerPos, m_PosTo);
+			GS()->PathFinder()->RequestFlowPath(m_PathHandle, PlayerPos, m_PosTo);
 			m_StepPos = 0;
 		}
 		m_PathHandle.TryGetPath();
@@ -2,6 +2,7 @@
 
 #include <base/format.h>
 #include <base/hash.h>
+#include <base/hash_ctxt.h>
 #include <engine/shared/datafile.h>
 #include <generated/server_data.h>
 #include <game/gamecore.h>
@@ -64,7 +65,7 @@ namespace
 		return Out;
 	}
 
-	static std::string MakePreparedPath(const char* pMapName)
+	static std::string MakePreparedPath(const char* pMapName, const SHA256_DIGEST& Key)
 	{
 		std::string_view s(pMapName ? pMapName : "");
 		const auto slash = s.find_last_of("/\\");
@@ -74,7 +75,57 @@ namespace
 
 		auto base = std::string(s.substr(nameStart, nameEnd - nameStart));
 		auto ext = (nameEnd < s.size()) ? std::string(s.substr(nameEnd)) : ".map";
-		return "maps/" + base + "_prepared" + ext;
+
+		char aKey[SHA256_MAXSTRSIZE];
+		sha256_str(Key, aKey, sizeof(aKey));
+		return "maps/" + base + "_prepared_" + std::string(aKey, 16) + ext;
+	}
+
+	// prepared maps used by this process, source maps in different folders can share a base name
+	std::mutex s_PreparedMutex;
+	std::set<std::string> s_UsedPrepared;
+
+	// removes '<base>_prepared_<16 hex><ext>' files of older bakes next to PreparedPath
+	static void RemoveStalePreparedMaps(IStorageEngine* pStorage, const std::string& PreparedPath)
+	{
+		const auto MarkerPos = PreparedPath.rfind("_prepared_");
+		const auto NameStart = PreparedPath.find_last_of('/') + 1;
+		if(MarkerPos == std::string::npos || MarkerPos < NameStart)
+			return;
+
+		struct CListData
+		{
+			std::string m_Prefix;
+			std::string m_Ext;
+			std::vector<std::string> m_vFiles;
+		} Data;
+		Data.m_Prefix = PreparedPath.substr(NameStart, MarkerPos + str_length("_prepared_") - NameStart);
+		Data.m_Ext = PreparedPath.substr(MarkerPos + str_length("_prepared_") + 16);
+
+		pStorage->ListDirectory(IStorageEngine::TYPE_SAVE, "maps", [](const char* pName, int IsDir, int, void* pUser)
+		{
+			auto* pData = static_cast<CListData*>(pUser);
+			const std::string_view Name(pName);
+			if(IsDir || Name.size() != pData->m_Prefix.size() + 16 + pData->m_Ext.size()
+				|| !Name.starts_with(pData->m_Prefix) || !Name.ends_with(pData->m_Ext))
+				return 0;
+
+			const auto Key = Name.substr(pData->m_Prefix.size(), 16);
+			if(std::all_of(Key.begin(), Key.end(), [](char c) { return std::isxdigit((unsigned char)c); }))
+				pData->m_vFiles.emplace_back(Name);
+			return 0;
+		}, &Data);
+
+		std::scoped_lock Lock(s_PreparedMutex);
+		for(const auto& File : Data.m_vFiles)
+		{
+			const std::string Path = "maps/" + File;
+			if(s_UsedPrepared.contains(Path))
+				continue;
+
+			if(pStorage->RemoveFile(Path.c_str(), IStorageEngine::TYPE_SAVE))
+				dbg_msg("tune_baker", "Removed stale prepared map '%s'", Path.c_str());
+		}
 	}
 
 	static std::vector<std::string> BuildTuneCommands(const CTuneZoneManager& Mgr)
@@ -111,30 +162,6 @@ namespace
 
 		return std::string(p, sz);
 	}
-
-	static std::optional<std::string> ExtractSourceSha256(const char* pData, int DataSize)
-	{
-		if(!pData || DataSize <= 0)
-			return std::nullopt;
-
-		const std::string_view Prefix = "# sha256 ";
-		const char* pCur = pData;
-		const char* pEnd = pData + DataSize;
-		while(pCur < pEnd)
-		{
-			const char* pStart = pCur;
-			while(pCur < pEnd && *pCur)
-				++pCur;
-
-			std::string_view Entry(pStart, pCur - pStart);
-			if(Entry.size() >= Prefix.size() && Entry.compare(0, Prefix.size(), Prefix) == 0)
-				return std::string(Entry.substr(Prefix.size()));
-
-			++pCur;
-		}
-
-		return std::nullopt;
-	}
 }
 
 CTuneZoneManager& CTuneZoneManager::GetInstance()
@@ -306,6 +333,33 @@ std::optional<std::string> CTuneZoneManager::BakePreparedMap(const char* pMapNam
 	const std::vector<char> Delta = SerializeZeroSeparated({}, DeltaBody);
 	const bool HasDelta = !Delta.empty();
 
+	// 3. the prepared map is named by the hash of everything it is built from
+	SHA256_CTX KeyCtx;
+	sha256_init(&KeyCtx);
+	sha256_update(&KeyCtx, SourceSha256Str.data(), SourceSha256Str.size());
+	sha256_update(&KeyCtx, Delta.data(), Delta.size());
+	for(const auto& Sound : vNewSounds)
+	{
+		const unsigned Size = (unsigned)Sound.m_pData->size();
+		sha256_update(&KeyCtx, Sound.m_Name.c_str(), Sound.m_Name.size() + 1);
+		sha256_update(&KeyCtx, &Size, sizeof(Size));
+		sha256_update(&KeyCtx, Sound.m_pData->data(), Size);
+	}
+
+	const std::string PreparedPath = MakePreparedPath(pMapName, sha256_finish(&KeyCtx));
+	{
+		// before the file exists, a parallel bake of another map with this base name must keep it
+		std::scoped_lock Lock(s_PreparedMutex);
+		s_UsedPrepared.insert(PreparedPath);
+	}
+	if(pStorage->FileExists(PreparedPath.c_str(), IStorageEngine::TYPE_ALL))
+	{
+		dbg_msg("tune_baker", "Prepared is up-to-date: '%s'", PreparedPath.c_str());
+		Reader.Close();
+		RemoveStalePreparedMaps(pStorage, PreparedPath);
+		return PreparedPath;
+	}
+
 	bool HadSettingsOriginally = false;
 	int SettingsIndex = -1;
 	std::vector<char> SettingsCombined;
@@ -401,157 +455,16 @@ std::optional<std::string> CTuneZoneManager::BakePreparedMap(const char* pMapNam
 		SettingsCombined = Delta;
 	}
 
-	// 4. check is prepared map is updated.
-	const std::string PreparedPath = MakePreparedPath(pMapName);
-	auto PreparedIsUpToDate = [&](const std::string& Path) -> bool
-	{
-		CDataFileReader Prep;
-		if(!Prep.Open(pStorage, Path.c_str(), IStorageEngine::TYPE_ALL))
-			return false;
-
-		// check settings
-		int PrepSettingsIndex = -1;
-		for(int i = 0; i < Prep.NumItems(); ++i)
-		{
-			int TypeId, ItemId;
-			void* pItem = Prep.GetItem(i, &TypeId, &ItemId);
-			if(TypeId == MAPITEMTYPE_INFO && ItemId == 0)
-			{
-				if(Prep.GetItemSize(i) >= (int)sizeof(CMapItemInfoSettings))
-					PrepSettingsIndex = ((CMapItemInfoSettings*)pItem)->m_Settings;
-				break;
-			}
-		}
-
-		if(PrepSettingsIndex < 0)
-		{
-			Prep.Close();
-			return false;
-		}
-
-		const char* pPrepSettings = (const char*)Prep.GetData(PrepSettingsIndex);
-		const int PrepSettingsSize = Prep.GetDataSize(PrepSettingsIndex);
-		const auto PrepSha256 = ExtractSourceSha256(pPrepSettings, PrepSettingsSize);
-		if(!PrepSha256 || *PrepSha256 != SourceSha256Str)
-		{
-			Prep.Close();
-			return false;
-		}
-
-		if(!SettingsCombined.empty())
-		{
-			if(PrepSettingsSize != (int)SettingsCombined.size() ||
-				(PrepSettingsSize > 0 && mem_comp(pPrepSettings, SettingsCombined.data(), PrepSettingsSize) != 0))
-			{
-				Prep.Close();
-				return false;
-			}
-		}
-		else
-		{
-			if(PrepSettingsSize != 0)
-			{
-				Prep.Close();
-				return false;
-			}
-		}
-
-		// check sounds
-		std::vector<std::pair<int, const CMapItemSound*>> vPrepSounds;
-		vPrepSounds.reserve(NewCount + (int)vOrigSnaps.size());
-		for(int i = 0; i < Prep.NumItems(); ++i)
-		{
-			int TypeId, ItemId;
-			void* pItem = Prep.GetItem(i, &TypeId, &ItemId);
-			if(TypeId == MAPITEMTYPE_SOUND)
-			{
-				if(Prep.GetItemSize(i) < (int)sizeof(CMapItemSound))
-				{
-					Prep.Close();
-					return false;
-				}
-				vPrepSounds.emplace_back(ItemId, (const CMapItemSound*)pItem);
-			}
-		}
-		std::sort(vPrepSounds.begin(), vPrepSounds.end(),
-			[](const auto& a, const auto& b) { return a.first < b.first; });
-
-		if((int)vPrepSounds.size() != NewCount + (int)vOrigSnaps.size())
-		{
-			Prep.Close();
-			return false;
-		}
-
-		// first sounds from manifest.
-		for(int i = 0; i < NewCount; ++i)
-		{
-			const auto* pS = vPrepSounds[i].second;
-
-			const std::string Name = DataToString(Prep, pS->m_SoundName);
-			if(Name != vNewSounds[i].m_Name)
-			{
-				Prep.Close();
-				return false;
-			}
-
-			const void* pBuf = Prep.GetData(pS->m_SoundData);
-			const int BufSize = Prep.GetDataSize(pS->m_SoundData);
-			const auto& Need = *vNewSounds[i].m_pData;
-
-			if(BufSize != (int)Need.size() ||
-				(BufSize > 0 && mem_comp(pBuf, Need.data(), BufSize) != 0) ||
-				pS->m_External != 0)
-			{
-				Prep.Close();
-				return false;
-			}
-		}
-
-		// other map sounds.
-		for(size_t j = 0; j < vOrigSnaps.size(); ++j)
-		{
-			const auto* pS = vPrepSounds[NewCount + (int)j].second;
-
-			if(DataToString(Prep, pS->m_SoundName) != vOrigSnaps[j].m_Name ||
-				pS->m_External != vOrigSnaps[j].m_External)
-			{
-				Prep.Close();
-				return false;
-			}
-
-			if(vOrigSnaps[j].m_External == 0)
-			{
-				const void* pBuf = Prep.GetData(pS->m_SoundData);
-				const int BufSize = Prep.GetDataSize(pS->m_SoundData);
-				const auto& Need = vOrigSnaps[j].m_Data;
-
-				if(BufSize != (int)Need.size() ||
-					(BufSize > 0 && mem_comp(pBuf, Need.data(), BufSize) != 0))
-				{
-					Prep.Close();
-					return false;
-				}
-			}
-		}
-
-		Prep.Close();
-		return true;
-	};
-
-	if(PreparedIsUpToDate(PreparedPath))
-	{
-		dbg_msg("tune_baker", "Prepared is up-to-date: '%s'", PreparedPath.c_str());
-		Reader.Close();
-		return PreparedPath;
-	}
-
-	// 5. write new map
+	// 4. write new map, under a temporary name so other worlds never see it half written
 	pStorage->CreateFolder("maps", IStorageEngine::TYPE_SAVE);
 
+	static std::atomic<int> s_TempCounter = 0;
+	const std::string TempPath = fmt_default("{}.{}.tmp", PreparedPath, s_TempCounter++);
+
 	CDataFileWriter Writer;
-	if(!Writer.Open(pStorage, PreparedPath.c_str(), IStorageEngine::TYPE_SAVE))
+	if(!Writer.Open(pStorage, TempPath.c_str(), IStorageEngine::TYPE_SAVE))
 	{
-		dbg_msg("tune_baker", "Failed to open prepared for write: '%s'", PreparedPath.c_str());
+		dbg_msg("tune_baker", "Failed to open prepared for write: '%s'", TempPath.c_str());
 		Reader.Close();
 		return std::nullopt;
 	}
@@ -652,6 +565,14 @@ std::optional<std::string> CTuneZoneManager::BakePreparedMap(const char* pMapNam
 	Writer.Finish();
 	Reader.Close();
 
+	if(!pStorage->RenameFile(TempPath.c_str(), PreparedPath.c_str(), IStorageEngine::TYPE_SAVE))
+	{
+		dbg_msg("tune_baker", "Failed to move prepared into place: '%s'", PreparedPath.c_str());
+		pStorage->RemoveFile(TempPath.c_str(), IStorageEngine::TYPE_SAVE);
+		return std::nullopt;
+	}
+
 	dbg_msg("tune_baker", "Prepared map written: '%s' (sounds: manifest first, settings appended)", PreparedPath.c_str());
+	RemoveStalePreparedMaps(pStorage, PreparedPath);
 	return PreparedPath;
 }
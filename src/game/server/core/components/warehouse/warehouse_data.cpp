@@ -15,6 +15,7 @@ void CWarehouse::Init(const std::string& Name, const DBSet& Type, const std::str
 	m_Pos = Pos;
 	m_Currency = Currency;
 	m_WorldID = WorldID;
+	m_IndexByPos.Insert(WorldID, Pos, this);
 	m_Storage.Init(this);
 	InitData(Type, TradesStr, StorageData);
 }
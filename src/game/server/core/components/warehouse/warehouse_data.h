@@ -112,6 +112,7 @@ public:
 	{
 		auto pData = new CWarehouse;
 		pData->m_ID = WarehouseID;
+		m_IndexByID.Insert(WarehouseID, pData);
 		return m_pData.emplace_back(pData);
 	}
 
@@ -595,21 +595,11 @@ bool CWarehouseManager::SellItem(CPlayer* pPlayer, CWarehouse* pWarehouse, int T
 
 CWarehouse* CWarehouseManager::GetWarehouse(vec2 Pos) const
 {
-	const auto iter = std::ranges::find_if(CWarehouse::Data(), [Pos](const CWarehouse* pItem)
-	{
-		return distance(pItem->GetPos(), Pos) < 320;
-	});
-
-	return iter != CWarehouse::Data().end() ? *iter : nullptr;
+	return CWarehouse::FindByPos(GS()->GetWorldID(), Pos, 320.f);
 }
 
 
 CWarehouse* CWarehouseManager::GetWarehouse(int WarehouseID) const
 {
-	const auto iter = std::ranges::find_if(CWarehouse::Data(), [WarehouseID](const CWarehouse* pItem)
-	{
-		return pItem->GetID() == WarehouseID;
-	});
-
-	return iter != CWarehouse::Data().end() ? *iter : nullptr;
+	return CWarehouse::FindByID(WarehouseID);
 }
@@ -9,6 +9,7 @@ class CWarehouseManager : public MmoComponent
 	~CWarehouseManager() override
 	{
 		mystd::freeContainer(CWarehouse::Data());
+		CWarehouse::ClearIndexes();
 	}
 
 	void OnPreInit() override;
@@ -10,6 +10,7 @@ CWorldManager::~CWorldManager()
 {
 	mystd::freeContainer(CWorldData::Data());
 	m_PathFinderBFS.clear();
+	m_vNextWorldID.clear();
 }
 
 void CWorldManager::OnInitWorld(const std::string& SqlQueryWhereWorld)
@@ -61,6 +62,21 @@ void CWorldManager::OnPostInit()
 			m_PathFinderBFS.addEdge(p.GetFirstWorldID(), p.GetSecondWorldID());
 		}
 	}
+
+	// the worlds don't change after init, so the next step of every route is known ahead
+	const int NumWorlds = (int)CWorldData::Data().size();
+	m_vNextWorldID.assign((size_t)NumWorlds * NumWorlds, -1);
+	for(int From = 0; From < NumWorlds; From++)
+	{
+		for(int To = 0; To < NumWorlds; To++)
+		{
+			if(From == To)
+				continue;
+
+			if(const auto vNodeSteps = m_PathFinderBFS.findPath(From, To); vNodeSteps.size() >= 2)
+				m_vNextWorldID[(size_t)From * NumWorlds + To] = vNodeSteps[1];
+		}
+	}
 }
 
 std::optional<vec2> CWorldManager::FindPosition(int WorldID, vec2 Pos) const
@@ -71,10 +87,12 @@ std::optional<vec2> CWorldManager::FindPosition(int WorldID, vec2 Pos) const
 		return Pos;
 
 	// search path between worlds
-	const auto vNodeSteps = m_PathFinderBFS.findPath(CurrentWorldID, WorldID);
-	if(vNodeSteps.size() >= 2)
+	const int NumWorlds = (int)CWorldData::Data().size();
+	if(CurrentWorldID < 0 || CurrentWorldID >= NumWorlds || WorldID < 0 || WorldID >= NumWorlds)
+		return std::nullopt;
+
+	if(const int NextRightWorldID = m_vNextWorldID[(size_t)CurrentWorldID * NumWorlds + WorldID]; NextRightWorldID != -1)
 	{
-		const int NextRightWorldID = vNodeSteps[1];
 		auto& rSwappers = CWorldData::Data()[CurrentWorldID]->GetSwappers();
 
 		// search path
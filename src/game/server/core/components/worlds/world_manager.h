@@ -11,6 +11,7 @@
 class CWorldManager : public MmoComponent
 {
 	inline static PathFinderVertex m_PathFinderBFS {};
+	inline static std::vector<int> m_vNextWorldID {}; // [from * worlds + to], -1 when there is no way
 
 	~CWorldManager() override;
 
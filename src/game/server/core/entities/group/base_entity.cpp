@@ -20,9 +20,13 @@ CBaseEntity::CBaseEntity(CGameWorld* pGameWorld, const std::shared_ptr<CEntityGr
 
 CBaseEntity::~CBaseEntity()
 {
-	for(const int& ID : m_vIDs)
+	if(!m_vIDs.empty())
 	{
-		Server()->SnapFreeID(ID);
+		Server()->SnapFreeIDs(GS()->GetWorldID(), m_vIDs.front(), (int)m_vIDs.size());
+	}
+	if(m_NumSnapIDs > 0)
+	{
+		Server()->SnapFreeIDs(GS()->GetWorldID(), m_FirstSnapID, m_NumSnapIDs);
 	}
 
 	TriggerEvent(EventDestroy);
@@ -58,16 +62,39 @@ void CBaseEntity::RegisterEvent(EventType Type, int NumIDs, const std::function<
 {
 	if(Type == EventSnap)
 	{
+		if(!m_vIDs.empty())
+		{
+			Server()->SnapFreeIDs(GS()->GetWorldID(), m_vIDs.front(), (int)m_vIDs.size());
+		}
+
+		// one block, ids follow the first one
+		const int FirstID = NumIDs > 0 ? Server()->SnapNewIDs(GS()->GetWorldID(), NumIDs) : -1;
 		m_vIDs.resize(NumIDs);
 		for(int i = 0; i < NumIDs; i++)
 		{
-			m_vIDs[i] = Server()->SnapNewID();
+			m_vIDs[i] = FirstID >= 0 ? FirstID + i : -1;
 		}
 
 		m_SnapCallback = Callback;
 	}
 }
 
+bool CBaseEntity::IsMaskedFor(int SnappingClient) const
+{
+	return m_Mask == CmaskAll() || CmaskIsSet(m_Mask, SnappingClient);
+}
+
+void CBaseEntity::ReserveSnapIDs(int Num)
+{
+	if(m_NumSnapIDs > 0)
+	{
+		Server()->SnapFreeIDs(GS()->GetWorldID(), m_FirstSnapID, m_NumSnapIDs);
+	}
+
+	m_FirstSnapID = Num > 0 ? Server()->SnapNewIDs(GS()->GetWorldID(), Num) : -1;
+	m_NumSnapIDs = m_FirstSnapID >= 0 ? Num : 0;
+}
+
 CPlayer* CBaseEntity::GetPlayer() const
 {
 	return GS()->GetPlayer(m_ClientID, false, true);
@@ -96,6 +123,6 @@ void CBaseEntity::TickDeferred()
 
 void CBaseEntity::Snap(int SnappingClient)
 {
-	if(m_Mask == CmaskAll() || CmaskIsSet(m_Mask, SnappingClient))
+	if(IsMaskedFor(SnappingClient))
 		TriggerEvent(EventSnap, SnappingClient, m_vIDs);
 }
\ No newline at end of file
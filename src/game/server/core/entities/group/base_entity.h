@@ -8,6 +8,9 @@ class CEntityGroup;
 
 class CBaseEntity : public CEntity, public mystd::CConfigurable
 {
+	MACRO_ALLOC_FREELIST(CBaseEntity, 256)
+	friend class CEntityGroup;
+
 public:
 	enum EventType
 	{
@@ -91,9 +94,22 @@ protected:
 	std::function<void(CBaseEntity*)> m_DestroyCallback{};
 	std::function<void(CBaseEntity*, int, const std::vector<int>&)> m_SnapCallback{};
 
+	bool IsMaskedFor(int SnappingClient) const;
+
+	// one block of consecutive snap ids without the vector, freed with the entity
+	void ReserveSnapIDs(int Num);
+
 	int64_t m_Mask{};
 	std::weak_ptr<CEntityGroup> m_GroupPtr{};
 	std::vector<int> m_vIDs{};
+	int m_FirstSnapID{ -1 };
+	int m_NumSnapIDs{};
+
+private:
+	// links of the group entity list
+	CBaseEntity* m_pGroupPrev{};
+	CBaseEntity* m_pGroupNext{};
+	bool m_InGroupList{};
 };
 
 #endif
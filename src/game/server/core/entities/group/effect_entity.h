@@ -0,0 +1,50 @@
+#ifndef GAME_SERVER_ENTITIES_EVENT_EFFECT_ENTITY_H
+#define GAME_SERVER_ENTITIES_EVENT_EFFECT_ENTITY_H
+
+#include "base_entity.h"
+
+/*
+ * Group entity with a typed state instead of string keyed config and callbacks.
+ * TEffect describes the effect at compile time:
+ *   NUM_SNAP_IDS  - extra snap ids, reserved as one block
+ *   State         - per entity data
+ *   Tick(pEnt)    - called every tick while the entity is alive
+ *   Snap(pEnt, SnappingClient) - snaps the entity and its extra ids
+ */
+template<typename TEffect>
+class CEffectEntity final : public CBaseEntity
+{
+	MACRO_ALLOC_FREELIST(CEffectEntity, 128)
+
+	typename TEffect::State m_State;
+
+public:
+	CEffectEntity(CGameWorld* pGameWorld, const std::shared_ptr<CEntityGroup>& group, int EnttypeID, vec2 Pos, int Owner, const typename TEffect::State& State)
+		: CBaseEntity(pGameWorld, group, EnttypeID, Pos, Owner), m_State(State)
+	{
+		if constexpr(TEffect::NUM_SNAP_IDS > 0)
+			ReserveSnapIDs(TEffect::NUM_SNAP_IDS);
+	}
+
+	void Tick() override
+	{
+		CBaseEntity::Tick();
+		if(!IsMarkedForDestroy())
+			TEffect::Tick(this);
+	}
+
+	void Snap(int SnappingClient) override
+	{
+		if(m_GroupPtr.expired() || !IsMaskedFor(SnappingClient))
+			return;
+
+		TEffect::Snap(this, SnappingClient);
+	}
+
+	typename TEffect::State& GetState() { return m_State; }
+	int GetMainSnapID() const { return GetID(); }
+	int GetExtraSnapID(int Index) const { return m_FirstSnapID >= 0 ? m_FirstSnapID + Index : -1; }
+	int GetNumExtraSnapIDs() const { return m_NumSnapIDs; }
+};
+
+#endif
@@ -2,7 +2,7 @@
 
 #include <game/server/gamecontext.h>
 
-CEntityGroup::CEntityGroup(CGameWorld* pWorld, int DefaultEnttypeID, int ClientID)
+CEntityGroup::CEntityGroup(CPrivateTag, CGameWorld* pWorld, int DefaultEnttypeID, int ClientID)
 	: m_DefaultEnttypeID(DefaultEnttypeID), m_pWorld(pWorld), m_ClientID(ClientID) {}
 
 void CEntityGroup::RemoveFromWorld()
@@ -14,20 +14,46 @@ void CEntityGroup::RemoveFromWorld()
 
 CEntityGroup::~CEntityGroup()
 {
-	RemoveFromWorld();
-	m_vEntities.clear();
+	Clear();
 }
 
 void CEntityGroup::AddEntity(CBaseEntity* pEnt)
 {
-	m_vEntities.push_back(pEnt);
+	if(pEnt->m_InGroupList)
+		return;
+
+	pEnt->m_pGroupPrev = m_pLastEntity;
+	pEnt->m_pGroupNext = nullptr;
+	if(m_pLastEntity)
+		m_pLastEntity->m_pGroupNext = pEnt;
+	else
+		m_pFirstEntity = pEnt;
+	m_pLastEntity = pEnt;
+	pEnt->m_InGroupList = true;
+	m_NumEntities++;
 }
 
 void CEntityGroup::RemoveEntity(CBaseEntity* pEnt)
 {
-	m_vEntities.erase(std::ranges::remove(m_vEntities, pEnt).begin(), m_vEntities.end());
+	if(pEnt->m_InGroupList)
+	{
+		if(m_pIterNext == pEnt)
+			m_pIterNext = pEnt->m_pGroupNext;
+		if(pEnt->m_pGroupPrev)
+			pEnt->m_pGroupPrev->m_pGroupNext = pEnt->m_pGroupNext;
+		else
+			m_pFirstEntity = pEnt->m_pGroupNext;
+		if(pEnt->m_pGroupNext)
+			pEnt->m_pGroupNext->m_pGroupPrev = pEnt->m_pGroupPrev;
+		else
+			m_pLastEntity = pEnt->m_pGroupPrev;
 
-	if(m_vEntities.empty())
+		pEnt->m_pGroupPrev = pEnt->m_pGroupNext = nullptr;
+		pEnt->m_InGroupList = false;
+		m_NumEntities--;
+	}
+
+	if(m_NumEntities == 0)
 	{
 		RemoveFromWorld();
 	}
@@ -36,7 +62,15 @@ void CEntityGroup::RemoveEntity(CBaseEntity* pEnt)
 void CEntityGroup::Clear()
 {
 	RemoveFromWorld();
-	m_vEntities.clear();
+	for(auto* pEnt = m_pFirstEntity; pEnt;)
+	{
+		auto* pNext = pEnt->m_pGroupNext;
+		pEnt->m_pGroupPrev = pEnt->m_pGroupNext = nullptr;
+		pEnt->m_InGroupList = false;
+		pEnt = pNext;
+	}
+	m_pFirstEntity = m_pLastEntity = m_pIterNext = nullptr;
+	m_NumEntities = 0;
 }
 
 CBaseEntity* CEntityGroup::CreateBase(vec2 Pos, std::optional<int> EnttypeID)
@@ -48,10 +82,13 @@ CBaseEntity* CEntityGroup::CreateBase(vec2 Pos, std::optional<int> EnttypeID)
 
 void CEntityGroup::ForEachEntity(const std::function<void(CBaseEntity*)>& func) const
 {
-	for(auto& entity : m_vEntities)
+	auto* pOuterNext = m_pIterNext;
+	for(auto* pEnt = m_pFirstEntity; pEnt; pEnt = m_pIterNext)
 	{
-		func(entity);
+		m_pIterNext = pEnt->m_pGroupNext;
+		func(pEnt);
 	}
+	m_pIterNext = pOuterNext;
 }
 
 CLaserEntity* CEntityGroup::CreateLaser(vec2 Pos, vec2 PosTo, int LaserType, std::optional<int> EnttypeID)
@@ -1,6 +1,7 @@
 #ifndef GAME_SERVER_ENTITIES_EVENT_ENTITY_GROUP_H
 #define GAME_SERVER_ENTITIES_EVENT_ENTITY_GROUP_H
 
+#include "effect_entity.h"
 #include "laser_entity.h"
 #include "pickup_entity.h"
 
@@ -13,22 +14,35 @@ class CEntityGroup : public std::enable_shared_from_this<CEntityGroup>, public m
 	int m_DefaultEnttypeID {};
 	CGameWorld* m_pWorld{};
 	int m_ClientID{};
+	CBaseEntity* m_pFirstEntity{};
+	CBaseEntity* m_pLastEntity{};
+	// next entity of a running ForEachEntity, moved on when the callback removes it
+	mutable CBaseEntity* m_pIterNext{};
+	int m_NumEntities{};
+
+	// only NewGroup can construct, allocate_shared needs a public constructor
+	struct CPrivateTag
+	{
+		explicit CPrivateTag() = default;
+	};
 
 public:
+	// groups and their control blocks are reused, skills create them all the time
 	static std::shared_ptr<CEntityGroup> NewGroup(CGameWorld* pWorld, int DefaultEnttypeID, int ClientID = -1)
 	{
-		auto groupPtr = std::shared_ptr<CEntityGroup>(new CEntityGroup(pWorld, DefaultEnttypeID, ClientID));
+		auto groupPtr = std::allocate_shared<CEntityGroup>(CFreeListAllocator<CEntityGroup>{}, CPrivateTag{}, pWorld, DefaultEnttypeID, ClientID);
 		pWorld->m_EntityGroups.insert(groupPtr);
 		return groupPtr;
 	}
+	CEntityGroup(CPrivateTag, CGameWorld* pWorld, int DefaultEnttypeID, int ClientID);
 	~CEntityGroup();
 
 private:
-	CEntityGroup(CGameWorld* pWorld, int DefaultEnttypeID, int ClientID);
 	void RemoveFromWorld();
 
 public:
 	void AddEntity(CBaseEntity* pEnt);
+	// the callback may remove any entity of the group, except from inside a nested loop over the same group
 	void ForEachEntity(const std::function<void(CBaseEntity*)>& func) const;
 	void RemoveEntity(CBaseEntity* pEnt);
 	void Clear();
@@ -37,10 +51,14 @@ public:
 	CLaserEntity* CreateLaser(vec2 Pos, vec2 PosTo, int LaserType = LASERTYPE_RIFLE, std::optional<int> EnttypeID = std::nullopt);
 	CPickupEntity* CreatePickup(vec2 Pos, int Type = POWERUP_HEALTH, int Subtype = 0, std::optional<int> EnttypeID = std::nullopt);
 
-	bool IsActive() const { return (int)m_vEntities.size() > 0; }
+	template<typename TEffect>
+	CEffectEntity<TEffect>* CreateEffect(vec2 Pos, const typename TEffect::State& State, std::optional<int> EnttypeID = std::nullopt)
+	{
+		const int currentEnttypeID = EnttypeID.value_or(m_DefaultEnttypeID);
+		return new CEffectEntity<TEffect>(m_pWorld, shared_from_this(), currentEnttypeID, Pos, m_ClientID, State);
+	}
 
-private:
-	std::vector<CBaseEntity*> m_vEntities;
+	bool IsActive() const { return m_NumEntities > 0; }
 };
 
 #endif
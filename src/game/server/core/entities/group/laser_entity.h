@@ -13,6 +13,7 @@ struct LaserOptions
 
 class CLaserEntity final : public CBaseEntity
 {
+	MACRO_ALLOC_FREELIST(CLaserEntity, 256)
 	LaserOptions m_Options;
 
 public:
@@ -11,6 +11,7 @@ struct PickupOptions
 
 class CPickupEntity final : public CBaseEntity
 {
+	MACRO_ALLOC_FREELIST(CPickupEntity, 256)
 	PickupOptions m_Options;
 
 public:
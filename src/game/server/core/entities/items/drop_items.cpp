@@ -60,6 +60,17 @@ bool CEntityDropItem::TakeItem(int ClientID)
 	return true;
 }
 
+bool CEntityDropItem::TryMerge(int OwnerID, const CItem& Item)
+{
+	if(IsMarkedForDestroy() || m_ClientID != OwnerID || m_DropItem.GetID() != Item.GetID() ||
+		m_DropItem.GetEnchant() != Item.GetEnchant() || !m_DropItem.Info()->IsStackable())
+		return false;
+
+	m_DropItem.SetValue(m_DropItem.GetValue() + Item.GetValue());
+	m_LifeSpan = maximum(m_LifeSpan, Server()->TickSpeed() * g_Config.m_SvDroppedItemLifetime);
+	return true;
+}
+
 void CEntityDropItem::Tick()
 {
 	m_LifeSpan--;
@@ -86,8 +97,20 @@ void CEntityDropItem::Tick()
 			m_ClientID = -1;
 	}
 
+	// owned drops are only for the owner, so there is no need to scan for other characters
+	CCharacter* pChar = nullptr;
+	if(m_ClientID != -1)
+	{
+		auto* pOwnerChar = GS()->GetPlayerChar(m_ClientID);
+		if(pOwnerChar && distance(pOwnerChar->m_Core.m_Pos, m_Pos) < 32.0f + pOwnerChar->GetRadius())
+			pChar = pOwnerChar;
+	}
+	else
+	{
+		pChar = (CCharacter*)GameWorld()->ClosestEntity(m_Pos, 32.0f, CGameWorld::ENTTYPE_CHARACTER, nullptr);
+	}
+
 	// information
-	auto *pChar = (CCharacter*)GameWorld()->ClosestEntity(m_Pos, 32.0f, CGameWorld::ENTTYPE_CHARACTER, nullptr);
 	if(pChar && !pChar->GetPlayer()->IsBot())
 	{
 		bool CanPick = m_ClientID == -1 || m_ClientID == pChar->GetClientID();
@@ -131,6 +154,10 @@ void CEntityDropItem::Tick()
 
 void CEntityDropItem::Snap(int SnappingClient)
 {
+	// owned drops are instanced for the owner
+	if(m_ClientID != -1 && SnappingClient != -1 && SnappingClient != m_ClientID && Server()->GetSpectatorID(SnappingClient) != m_ClientID)
+		return;
+
 	if(m_Flash.IsFlashing() || NetworkClipped(SnappingClient))
 		return;
 
@@ -25,6 +25,9 @@ public:
 		m_LifeSpan = Lifetime;
 	};
 	bool TakeItem(int ClientID);
+
+	// adds a stackable drop of the same item and owner to this stack
+	bool TryMerge(int OwnerID, const CItem& Item);
 };
 
 #endif
@@ -16,6 +16,16 @@ CEntityDropPickup::CEntityDropPickup(CGameWorld *pGameWorld, vec2 Pos, vec2 Vel,
 	GameWorld()->InsertEntity(this);
 }
 
+bool CEntityDropPickup::TryMerge(int Type, int Subtype, int Value)
+{
+	if(IsMarkedForDestroy() || m_Type != Type || m_Subtype != Subtype)
+		return false;
+
+	m_Value += Value;
+	m_LifeSpan = maximum(m_LifeSpan, Server()->TickSpeed() * 15);
+	return true;
+}
+
 void CEntityDropPickup::Tick()
 {
 	m_LifeSpan--;
@@ -18,6 +18,9 @@ public:
 
 	void Tick() override;
 	void Snap(int SnappingClient) override;
+
+	// adds the value of a pickup of the same kind to this one
+	bool TryMerge(int Type, int Subtype, int Value);
 };
 
 #endif
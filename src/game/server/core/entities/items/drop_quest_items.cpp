@@ -20,18 +20,16 @@ CDropQuestItem::CDropQuestItem(CGameWorld* pGameWorld, vec2 Pos, vec2 Vel, float
 	m_LifeSpan = Server()->TickSpeed() * 60;
 
 	GameWorld()->InsertEntity(this);
-	for (int& m_ID : m_IDs)
+	const int FirstID = Server()->SnapNewIDs(GS()->GetWorldID(), NUM_IDS);
+	for(int i = 0; i < NUM_IDS; i++)
 	{
-		m_ID = Server()->SnapNewID();
+		m_IDs[i] = FirstID >= 0 ? FirstID + i : -1;
 	}
 }
 
 CDropQuestItem::~CDropQuestItem()
 {
-	for(const int m_ID : m_IDs)
-	{
-		Server()->SnapFreeID(m_ID);
-	}
+	Server()->SnapFreeIDs(GS()->GetWorldID(), m_IDs[0], NUM_IDS);
 }
 
 void CDropQuestItem::Tick()
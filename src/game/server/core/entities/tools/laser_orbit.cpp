@@ -22,14 +22,15 @@ CEntityLaserOrbit::CEntityLaserOrbit(CGameWorld* pGameWorld, int ClientID, CEnti
 	GameWorld()->InsertEntity(this);
 
 	m_IDs.set_size(Amount);
+	const int FirstID = Amount > 0 ? Server()->SnapNewIDs(GS()->GetWorldID(), Amount) : -1;
 	for(int i = 0; i < m_IDs.size(); i++)
-		m_IDs[i] = Server()->SnapNewID();
+		m_IDs[i] = FirstID >= 0 ? FirstID + i : -1;
 }
 
 CEntityLaserOrbit::~CEntityLaserOrbit()
 {
-	for(int i = 0; i < m_IDs.size(); i++)
-		Server()->SnapFreeID(m_IDs[i]);
+	if(m_IDs.size() > 0)
+		Server()->SnapFreeIDs(GS()->GetWorldID(), m_IDs[0], m_IDs.size());
 	m_IDs.clear();
 }
 
@@ -14,7 +14,7 @@ CMultipleOrbit::CMultipleOrbit(CGameWorld* pGameWorld, CEntity* pParent)
 CMultipleOrbit::~CMultipleOrbit()
 {
 	for(const auto& pItems : m_Items)
-		Server()->SnapFreeID(pItems.m_ID);
+		Server()->SnapFreeID(GS()->GetWorldID(), pItems.m_ID);
 	m_Items.clear();
 }
 
@@ -25,7 +25,7 @@ void CMultipleOrbit::Add(bool Projectile, int Value, int Type, int Subtype, int
 	for(int i = 0; i < Value; i++)
 	{
 		SnapItem Item;
-		Item.m_ID = Server()->SnapNewID();
+		Item.m_ID = Server()->SnapNewID(GS()->GetWorldID());
 		Item.m_Type = Type;
 		Item.m_Subtype = Subtype;
 		Item.m_OrbitType = OrbitType;
@@ -56,7 +56,7 @@ void CMultipleOrbit::Remove(bool Projectile, int Value, int Type, int Subtype, i
 	// free snap ids
 	auto LastIt = m_Items.end();
 	for(auto itDel = LastIt - Count; itDel != LastIt; ++itDel)
-		Server()->SnapFreeID(itDel->m_ID);
+		Server()->SnapFreeID(GS()->GetWorldID(), itDel->m_ID);
 
 	// erase item's
 	m_Items.erase(LastIt - Count, LastIt);
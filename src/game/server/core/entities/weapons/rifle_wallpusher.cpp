@@ -9,7 +9,7 @@ CEntityRifleWallPusher::CEntityRifleWallPusher(CGameWorld* pGameWorld, int Owner
 	m_ClientID = OwnerCID;
 	m_Direction = Direction;
 	m_LifeTick = LifeTick;
-	m_ID2 = Server()->SnapNewID();
+	m_ID2 = Server()->SnapNewID(GS()->GetWorldID());
 
 	GS()->CreateSound(Pos, SOUND_SFX_WEAPON_PUSHER);
 	GameWorld()->InsertEntity(this);
@@ -17,7 +17,7 @@ CEntityRifleWallPusher::CEntityRifleWallPusher(CGameWorld* pGameWorld, int Owner
 
 CEntityRifleWallPusher::~CEntityRifleWallPusher()
 {
-	Server()->SnapFreeID(m_ID2);
+	Server()->SnapFreeID(GS()->GetWorldID(), m_ID2);
 }
 
 void CEntityRifleWallPusher::Tick()
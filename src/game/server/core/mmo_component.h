@@ -28,8 +28,9 @@ public:
 			m_vComponents.shrink_to_fit();
 		}
 
-		void add(MmoComponent* pComponent)
+		void add(MmoComponent* pComponent, const char* pName)
 		{
+			pComponent->m_pName = pName;
 			m_vComponents.push_back(pComponent);
 		}
 
@@ -45,6 +46,8 @@ protected:
 	class IConsole* m_pConsole{};
 	class IStorageEngine* m_pStorage{};
 	class CMmoController* m_Core{};
+	const char* m_pName{};
+	int m_ProfilePhase{ -1 };
 
 	CGS* GS() const { return m_GameServer; }
 	IServer* Server() const { return m_pServer; }
@@ -892,14 +892,153 @@ namespace detail
 	};
 }
 
+namespace detail
+{
+	template<typename T>
+	struct registry_element { using type = void; };
+	template<typename T>
+	struct registry_element<std::deque<T*>> { using type = T; };
+	template<typename T>
+	using registry_element_t = typename registry_element<T>::type;
+
+	// hash index by key, used to replace linear find_if over registries
+	template<typename TKey, typename TElement>
+	class CIdentifierIndex
+	{
+		ska::flat_hash_map<TKey, TElement*> m_Elements {};
+
+	public:
+		// the first inserted element keeps the key, like a linear search over Data()
+		void Insert(const TKey& Key, TElement* pElement) { m_Elements.emplace(Key, pElement); }
+		void Erase(const TKey& Key, TElement* pElement)
+		{
+			if(const auto it = m_Elements.find(Key); it != m_Elements.end() && it->second == pElement)
+				m_Elements.erase(it);
+		}
+		void Clear() { m_Elements.clear(); }
+
+		TElement* Find(const TKey& Key) const
+		{
+			const auto it = m_Elements.find(Key);
+			return it != m_Elements.end() ? it->second : nullptr;
+		}
+	};
+
+	// uniform grid index by position, separated by world
+	template<typename TElement>
+	class CWorldSpatialIndex
+	{
+		static constexpr float CELL_SIZE = 512.f;
+
+		struct CEntry
+		{
+			TElement* m_pElement;
+			vec2 m_Pos;
+			uint64_t m_Order;
+		};
+		struct CLocation
+		{
+			int m_WorldID;
+			int64_t m_CellKey;
+		};
+
+		ska::flat_hash_map<int, ska::flat_hash_map<int64_t, std::vector<CEntry>>> m_Worlds {};
+		ska::flat_hash_map<TElement*, CLocation> m_Locations {};
+		uint64_t m_NextOrder {};
+
+		static int CellCoord(float Value) { return (int)std::floor(Value / CELL_SIZE); }
+		static int64_t CellKey(int X, int Y) { return ((int64_t)X << 32) | (uint32_t)Y; }
+
+	public:
+		void Insert(int WorldID, vec2 Pos, TElement* pElement)
+		{
+			Erase(pElement);
+			const auto Key = CellKey(CellCoord(Pos.x), CellCoord(Pos.y));
+			m_Worlds[WorldID][Key].push_back({ pElement, Pos, m_NextOrder++ });
+			m_Locations[pElement] = { WorldID, Key };
+		}
+
+		void Erase(TElement* pElement)
+		{
+			const auto itLocation = m_Locations.find(pElement);
+			if(itLocation == m_Locations.end())
+				return;
+
+			auto& vCell = m_Worlds[itLocation->second.m_WorldID][itLocation->second.m_CellKey];
+			std::erase_if(vCell, [pElement](const CEntry& Entry) { return Entry.m_pElement == pElement; });
+			m_Locations.erase(itLocation);
+		}
+
+		void Clear()
+		{
+			m_Worlds.clear();
+			m_Locations.clear();
+			m_NextOrder = 0;
+		}
+
+		// first inserted element inside radius, like a linear search over Data(),
+		// only cells overlapping the radius are visited
+		TElement* FindFirst(int WorldID, vec2 Pos, float Radius) const
+		{
+			const auto itWorld = m_Worlds.find(WorldID);
+			if(itWorld == m_Worlds.end())
+				return nullptr;
+
+			TElement* pResult = nullptr;
+			uint64_t FirstOrder = UINT64_MAX;
+			for(int x = CellCoord(Pos.x - Radius); x <= CellCoord(Pos.x + Radius); x++)
+			{
+				for(int y = CellCoord(Pos.y - Radius); y <= CellCoord(Pos.y + Radius); y++)
+				{
+					const auto itCell = itWorld->second.find(CellKey(x, y));
+					if(itCell == itWorld->second.end())
+						continue;
+
+					for(const auto& Entry : itCell->second)
+					{
+						if(Entry.m_Order < FirstOrder && distance(Entry.m_Pos, Pos) < Radius)
+						{
+							FirstOrder = Entry.m_Order;
+							pResult = Entry.m_pElement;
+						}
+					}
+				}
+			}
+			return pResult;
+		}
+	};
+}
+
 template < typename T >
 class MultiworldIdentifiableData : public detail::_MultiworldIdentifiableData
 {
+	using element_type = detail::registry_element_t<T>;
+
 protected:
 	static inline T m_pData {};
 
+	// optional indexes, only instantiated for registries that use them
+	static inline detail::CIdentifierIndex<int, element_type> m_IndexByID {};
+	static inline detail::CWorldSpatialIndex<element_type> m_IndexByPos {};
+
 public:
 	static T& Data() { return m_pData; }
+
+	static element_type* FindByID(int ID) { return m_IndexByID.Find(ID); }
+	static element_type* FindByPos(int WorldID, vec2 Pos, float Radius) { return m_IndexByPos.FindFirst(WorldID, Pos, Radius); }
+
+	// must be called before the element is freed or erased from Data()
+	static void Unindex(int ID, element_type* pElement)
+	{
+		m_IndexByID.Erase(ID, pElement);
+		m_IndexByPos.Erase(pElement);
+	}
+
+	static void ClearIndexes()
+	{
+		m_IndexByID.Clear();
+		m_IndexByPos.Clear();
+	}
 };
 
 #endif
@@ -2,6 +2,7 @@
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
 #include "mmo_controller.h"
 
+#include <engine/server/tick_profiler.h>
 #include <game/server/gamecontext.h>
 
 #include "components/accounts/account_manager.h"
@@ -31,25 +32,25 @@
 CMmoController::CMmoController(CGS* pGameServer) : m_pGameServer(pGameServer)
 {
 	// order
-	m_System.add(m_pAchievementManager = new CAchievementManager);
-	m_System.add(m_pQuestManager = new CQuestManager);
-	m_System.add(m_pInventoryManager = new CInventoryManager);
-	m_System.add(m_pBotManager = new CBotManager);
-	m_System.add(m_pCraftManager = new CCraftManager);
-	m_System.add(m_pWarehouseManager = new CWarehouseManager);
-	m_System.add(new CAuctionManager);
-	m_System.add(m_pEidolonManager = new CEidolonManager);
-	m_System.add(m_pDutiesManager = new CDutiesManager);
-	m_System.add(new CAethernetManager);
-	m_System.add(m_pWorldManager = new CWorldManager);
-	m_System.add(m_pHouseManager = new CHouseManager);
-	m_System.add(m_pGuildManager = new CGuildManager);
-	m_System.add(m_pGroupManager = new CGroupManager);
-	m_System.add(m_pSkillManager = new CSkillManager);
-	m_System.add(m_pAccountManager = new CAccountManager);
-	m_System.add(m_pMailboxManager = new CMailboxManager);
-	m_System.add(new CWikiManager);
-	m_System.add(m_pMiniEventsManager = new CMiniEventsManager);
+	m_System.add(m_pAchievementManager = new CAchievementManager, "achievement");
+	m_System.add(m_pQuestManager = new CQuestManager, "quest");
+	m_System.add(m_pInventoryManager = new CInventoryManager, "inventory");
+	m_System.add(m_pBotManager = new CBotManager, "bot");
+	m_System.add(m_pCraftManager = new CCraftManager, "craft");
+	m_System.add(m_pWarehouseManager = new CWarehouseManager, "warehouse");
+	m_System.add(new CAuctionManager, "auction");
+	m_System.add(m_pEidolonManager = new CEidolonManager, "eidolon");
+	m_System.add(m_pDutiesManager = new CDutiesManager, "duties");
+	m_System.add(new CAethernetManager, "aethernet");
+	m_System.add(m_pWorldManager = new CWorldManager, "world");
+	m_System.add(m_pHouseManager = new CHouseManager, "house");
+	m_System.add(m_pGuildManager = new CGuildManager, "guild");
+	m_System.add(m_pGroupManager = new CGroupManager, "group");
+	m_System.add(m_pSkillManager = new CSkillManager, "skill");
+	m_System.add(m_pAccountManager = new CAccountManager, "account");
+	m_System.add(m_pMailboxManager = new CMailboxManager, "mailbox");
+	m_System.add(new CWikiManager, "wiki");
+	m_System.add(m_pMiniEventsManager = new CMiniEventsManager, "mini_events");
 
 }
 
@@ -65,6 +66,7 @@ void CMmoController::OnInit(IServer* pServer, IConsole* pConsole, IStorageEngine
 		pComponent->m_pServer = pServer;
 		pComponent->m_pConsole = pConsole;
 		pComponent->m_pStorage = pStorage;
+		pComponent->m_ProfilePhase = pServer->TickProfiler()->RegisterPhase(pComponent->m_pName);
 
 		if(m_pGameServer->GetWorldID() == INITIALIZER_WORLD_ID)
 			pComponent->OnPreInit();
@@ -97,8 +99,12 @@ void CMmoController::OnConsoleInit(IConsole* pConsole) const
 
 void CMmoController::OnTick() const
 {
+	auto* pProfiler = GS()->Server()->TickProfiler();
 	for(auto& pComponent : m_System.m_vComponents)
+	{
+		CTickProfiler::CScope Scope(pProfiler, GS()->GetWorldID(), pComponent->m_ProfilePhase);
 		pComponent->OnTick();
+	}
 
 	// check time period
 	if(GS()->GetWorldID() == INITIALIZER_WORLD_ID &&
@@ -407,12 +413,14 @@ void CMmoController::SaveAccount(CPlayer* pPlayer, int Table) const
 
 	CAccountData* pAccount = pPlayer->Account();
 	const auto AccountID = pAccount->GetID();
+	CSqlQueueScope QueueScope(std::nullopt, DBOrderKey::Account(AccountID));
 
 	// save account base
 	if(Table == SAVE_STATS)
 	{
 		const auto Bank = pAccount->GetBankManager().to_string();
 		Database->Execute<DB::UPDATE>("tw_accounts_data", "Bank = '{}' WHERE ID = '{}'", Bank, AccountID);
+		TopLists().PlayerWealthy.Set(AccountID, Instance::Server()->GetAccountNickname(AccountID), pAccount->GetBankManager());
 	}
 
 	// save social
@@ -533,56 +541,54 @@ void CMmoController::ShowTopList(VoteWrapper* pWrapper, int ClientID, ToplistTyp
 }
 
 
+CMmoController::CTopLists& CMmoController::TopLists()
+{
+	static CTopLists s_TopLists;
+	return s_TopLists;
+}
+
 std::map<int, CMmoController::TempTopData> CMmoController::GetTopList(ToplistType Type, int Rows) const
 {
 	std::map<int, TempTopData> vResult {};
 
 	if(Type == ToplistType::GuildLeveling)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_guilds", "ORDER BY Level DESC, Exp DESC LIMIT {}", Rows);
-		while(pRes->next())
+		TopLists().GuildLeveling.ForEachTop(Rows, [&](int Rank, int, const std::string& Name, const std::pair<int, uint64_t>& Score)
 		{
-			const auto Rank = pRes->getRow();
 			auto& field = vResult[Rank];
-			field.Name = pRes->getString("Name");
-			field.Data["Level"] = pRes->getInt("Level");
-			field.Data["Exp"] = pRes->getUInt64("Exp");
-		}
+			field.Name = Name;
+			field.Data["Level"] = Score.first;
+			field.Data["Exp"] = Score.second;
+		});
 	}
 	else if(Type == ToplistType::GuildWealthy)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_guilds", "ORDER BY Bank + 0 DESC LIMIT {}", Rows);
-		while(pRes->next())
+		TopLists().GuildWealthy.ForEachTop(Rows, [&](int Rank, int, const std::string& Name, const BigInt& Bank)
 		{
-			const auto Rank = pRes->getRow();
 			auto& field = vResult[Rank];
-			field.Name = pRes->getString("Name");
-			field.Data["Bank"] = pRes->getBigInt("Bank");
-		}
+			field.Name = Name;
+			field.Data["Bank"] = Bank;
+		});
 	}
 	else if(Type == ToplistType::PlayerRating)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_accounts_data", "ORDER BY Rating DESC LIMIT {}", Rows);
-		while(pRes->next())
+		TopLists().PlayerRating.ForEachTop(Rows, [&](int Rank, int AccountID, const std::string& Name, int Rating)
 		{
-			const auto Rank = pRes->getRow();
 			auto& field = vResult[Rank];
-			field.Name = pRes->getString("Nick");
-			field.Data["ID"] = pRes->getInt("ID");
-			field.Data["Rating"] = pRes->getInt("Rating");
-		}
+			field.Name = Name;
+			field.Data["ID"] = AccountID;
+			field.Data["Rating"] = Rating;
+		});
 	}
 	else if(Type == ToplistType::PlayerWealthy)
 	{
-		ResultPtr pRes = Database->Execute<DB::SELECT>("*", "tw_accounts_data", "ORDER BY Bank + 0 DESC LIMIT {}", Rows);
-		while(pRes->next())
+		TopLists().PlayerWealthy.ForEachTop(Rows, [&](int Rank, int AccountID, const std::string& Name, const BigInt& Bank)
 		{
-			const auto Rank = pRes->getRow();
 			auto& field = vResult[Rank];
-			field.Name = pRes->getString("Nick");
-			field.Data["ID"] = pRes->getInt("ID");
-			field.Data["Bank"] = pRes->getBigInt("Bank");
-		}
+			field.Name = Name;
+			field.Data["ID"] = AccountID;
+			field.Data["Bank"] = Bank;
+		});
 	}
 	else if(Type == ToplistType::PlayerExpert)
 	{
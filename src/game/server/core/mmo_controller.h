@@ -4,6 +4,7 @@
 #define GAME_SERVER_CORE_MMO_CONTROLLER_H
 
 #include "mmo_component.h"
+#include "tools/leaderboard.h"
 
 #include <any>
 
@@ -79,6 +80,16 @@ public:
 		std::string Name;
 		std::map<std::string, BigInt> Data;
 	};
+
+	// top lists shared by all worlds, seeded at startup and kept by the change points
+	struct CTopLists
+	{
+		CLeaderboard<std::pair<int, uint64_t>> GuildLeveling;
+		CLeaderboard<BigInt> GuildWealthy;
+		CLeaderboard<int> PlayerRating;
+		CLeaderboard<BigInt> PlayerWealthy;
+	};
+	static CTopLists& TopLists();
 	std::map<int, TempTopData> GetTopList(ToplistType Type, int Rows) const;
 	std::map<int, TempTopData> GetDungeonTopList(int DungeonID, int Rows) const;
 	std::map<int, TempTopData> GetRhythmTopList(int WorldID, const std::string& Difficulty, int Rows) const;
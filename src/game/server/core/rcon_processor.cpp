@@ -39,6 +39,7 @@ void RconProcessor::Init(IConsole* pConsole, IServer* pServer)
 	pConsole->Register("position", "?i[cid]", CFGFLAG_SERVER, ConPosition, pServer, "Get position by client (default self position)");
 	pConsole->Register("quest", "s[action] i[quest_id] ?i[step]", CFGFLAG_SERVER, ConQuest, pServer,
 		"Force accept or deny a quest for tests: quest <accept|deny> <cid> <quest_id> [step]");
+	pConsole->Register("event_stats", "", CFGFLAG_SERVER, ConEventStats, pServer, "List events with their listeners and notify counts");
 
 	// chain's
 	pConsole->Chain("sv_motd", ConchainSpecialMotdupdate, pServer);
@@ -592,6 +593,20 @@ void RconProcessor::ConQuest(IConsole::IResult* pResult, void* pUser)
 
 
 
+void RconProcessor::ConEventStats(IConsole::IResult* pResult, void* pUserData)
+{
+	const auto pServer = (IServer*)pUserData;
+	auto pSelf = (CGS*)pServer->GameServer();
+
+	for(int i = 0; i < IEventListener::NUM_EVENTS; ++i)
+	{
+		const auto Event = (IEventListener::Type)i;
+		pSelf->Console()->PrintFormat(IConsole::OUTPUT_LEVEL_STANDARD, "events", "%s listeners=%zu notified=%llu",
+			CEventListenerManager::GetEventName(Event), g_EventListenerManager.GetListenersCount(Event),
+			(unsigned long long)g_EventListenerManager.GetNotifyCount(Event));
+	}
+}
+
 void RconProcessor::ConchainSpecialMotdupdate(IConsole::IResult* pResult, void* pUserData, IConsole::FCommandCallback pfnCallback, void* pCallbackUserData)
 {
 	pfnCallback(pResult, pCallbackUserData);
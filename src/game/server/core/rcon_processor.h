@@ -33,6 +33,7 @@ class RconProcessor
 	static void ConUnrainbow(IConsole::IResult* pResult, void* pUserData);
 
 	static void ConQuest(IConsole::IResult* pResult, void* pUserData);
+	static void ConEventStats(IConsole::IResult* pResult, void* pUserData);
 
 	// chain's
 	static void ConchainSpecialMotdupdate(IConsole::IResult* pResult, void* pUserData, IConsole::FCommandCallback pfnCallback, void* pCallbackUserData);
@@ -14,7 +14,7 @@ class ComponentRegistry
 	ComponentRegistry& operator=(const ComponentRegistry&) = delete;
 
 public:
-	using FactoryFunc = std::function<std::unique_ptr<IStepComponent>(const nlohmann::json&)>;
+	using FactoryFunc = std::unique_ptr<IStepComponent> (*)(const nlohmann::json&);
 	static ComponentRegistry& GetInstance()
 	{
 		static ComponentRegistry Instance;
@@ -30,25 +30,14 @@ public:
 		};
 	}
 
-	std::unique_ptr<IStepComponent> Create(std::string_view name, const nlohmann::json& j, ScenarioBase* pScenario) const
+	FactoryFunc Find(std::string_view name) const
 	{
-		auto it = m_Factories.find(std::string(name));
-		if(it != m_Factories.end())
-		{
-			auto pComponent = it->second(j);
-			if(pComponent)
-			{
-				pComponent->Init(pScenario);
-			}
-
-			return pComponent;
-		}
-
-		return nullptr;
+		auto it = m_Factories.find(name);
+		return it != m_Factories.end() ? it->second : nullptr;
 	}
 
 private:
-	std::map<std::string, FactoryFunc> m_Factories;
+	std::map<std::string, FactoryFunc, std::less<>> m_Factories;
 };
 
 template<IsComponent T>
@@ -1,5 +1,5 @@
-﻿#include "component_registry.h"
-#include "scenario_base.h"
+﻿#include "scenario_base.h"
+#include "scenario_graph.h"
 
 #include <scenarios/base/scenario_base_player.h>
 #include <scenarios/base/scenario_base_group.h>
@@ -263,29 +263,19 @@ void ScenarioBase::AdvanceStep()
 CGS* ScenarioBase::GS() const { return m_pGS; }
 IServer* ScenarioBase::Server() const { return GS()->Server(); }
 
-void ScenarioBase::SetupStep(Step& NewStep, const nlohmann::json& StepJson)
+void ScenarioBase::SetupGraph(const ScenarioGraph& Graph)
 {
-	if(!StepJson.is_object())
-		return;
-
-	if(const auto logic = StepJson.value("completion_logic", "all_of"); logic == "any_of")
-		NewStep.m_CompletionLogic = StepCompletionLogic::ANY_OF;
-	else if(logic == "sequential")
-		NewStep.m_CompletionLogic = StepCompletionLogic::SEQUENTIAL;
-
-	if(StepJson.contains("components") && StepJson["components"].is_array())
+	m_StartStepId = Graph.GetStartStepId();
+	for(const auto& CompiledStep : Graph.GetSteps())
 	{
-		for(const auto& CompJson : StepJson["components"])
+		auto& NewStep = AddStep(CompiledStep.m_ID, CompiledStep.m_MsgInfo, CompiledStep.m_DelayTick);
+		NewStep.m_CompletionLogic = CompiledStep.m_CompletionLogic;
+		NewStep.m_vComponents.reserve(NewStep.m_vComponents.size() + CompiledStep.m_vComponents.size());
+		for(const auto& [pFactory, Json] : CompiledStep.m_vComponents)
 		{
-			if(!CompJson.is_object())
-				continue;
-
-			const auto Type = CompJson.value("type", "");
-			if(Type.empty())
-				continue;
-
-			if(auto pComponent = ComponentRegistry::GetInstance().Create(Type, CompJson, this))
+			if(auto pComponent = pFactory(Json))
 			{
+				pComponent->Init(this);
 				NewStep.AddComponent(std::move(pComponent));
 			}
 		}
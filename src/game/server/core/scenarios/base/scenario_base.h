@@ -4,6 +4,8 @@
 #include <base/types.h>
 #include "component.h"
 
+class ScenarioGraph;
+
 class CGS;
 class IServer;
 class CPlayer;
@@ -61,7 +63,7 @@ protected:
 	void ExecuteStepActiveActions();
 	void ExecuteStepEndActions();
 	void TryAdvanceSequentialComponent();
-	void SetupStep(Step& NewStep, const nlohmann::json& StepJson);
+	void SetupGraph(const ScenarioGraph& Graph);
 
 	[[nodiscard]] Step& AddStep(StepId id, std::string MsgInfo = "", int delayTick = -1);
 
@@ -0,0 +1,86 @@
+#include "scenario_graph.h"
+
+ScenarioGraphPtr ScenarioGraph::Compile(const nlohmann::json& Json)
+{
+	if(!Json.is_object() || !Json.contains("steps") || !Json["steps"].is_array() || Json["steps"].empty())
+		return nullptr;
+
+	auto pGraph = std::make_shared<ScenarioGraph>();
+	const auto& Steps = Json["steps"];
+	if(Steps[0].is_object())
+		pGraph->m_StartStepId = Steps[0].value("id", "");
+
+	// steps with the same id are merged, like AddStep does
+	std::unordered_map<StepId, size_t> vStepIndexes {};
+	for(const auto& StepJson : Steps)
+	{
+		if(!StepJson.is_object())
+			continue;
+
+		StepId ID = StepJson.value("id", "");
+		if(ID.empty() || !StepJson.contains("components") || !StepJson["components"].is_array())
+			continue;
+
+		auto [It, Inserted] = vStepIndexes.try_emplace(ID, pGraph->m_vSteps.size());
+		if(Inserted)
+		{
+			auto& NewStep = pGraph->m_vSteps.emplace_back();
+			NewStep.m_ID = std::move(ID);
+			NewStep.m_MsgInfo = StepJson.value("msg_info", "");
+			NewStep.m_DelayTick = StepJson.value("delay", -1);
+		}
+
+		auto& Step = pGraph->m_vSteps[It->second];
+		if(const auto Logic = StepJson.value("completion_logic", "all_of"); Logic == "any_of")
+			Step.m_CompletionLogic = StepCompletionLogic::ANY_OF;
+		else if(Logic == "sequential")
+			Step.m_CompletionLogic = StepCompletionLogic::SEQUENTIAL;
+
+		for(const auto& CompJson : StepJson["components"])
+		{
+			if(!CompJson.is_object())
+				continue;
+
+			const auto Type = CompJson.value("type", "");
+			if(Type.empty())
+				continue;
+
+			const auto pFactory = ComponentRegistry::GetInstance().Find(Type);
+			if(!pFactory)
+			{
+				dbg_msg("scenario", "unknown component type '%s'", Type.c_str());
+				continue;
+			}
+
+			Step.m_vComponents.push_back({ pFactory, CompJson });
+		}
+	}
+
+	if(pGraph->m_vSteps.empty())
+		return nullptr;
+
+	return pGraph;
+}
+
+ScenarioGraphPtr ScenarioGraph::Get(const std::string& ScenarioData, std::string_view Block)
+{
+	static std::unordered_map<std::string, std::map<std::string, ScenarioGraphPtr, std::less<>>> s_vCache {};
+
+	auto& vBlocks = s_vCache[ScenarioData];
+	if(const auto It = vBlocks.find(Block); It != vBlocks.end())
+		return It->second;
+
+	nlohmann::json JsonData;
+	mystd::json::parse(ScenarioData, [&Block, &JsonData](const nlohmann::json& Json)
+	{
+		if(Block.empty())
+			JsonData = Json;
+		else if(const auto It = Json.find(Block); It != Json.end() && !It->is_null())
+			JsonData = *It;
+	});
+
+	// invalid data is cached too, so it is not parsed again
+	ScenarioGraphPtr pGraph = JsonData.is_null() || JsonData.empty() ? nullptr : Compile(JsonData);
+	vBlocks.emplace(Block, pGraph);
+	return pGraph;
+}
@@ -0,0 +1,47 @@
+#ifndef GAME_SERVER_CORE_SCENARIOS_BASE_SCENARIO_GRAPH_H
+#define GAME_SERVER_CORE_SCENARIOS_BASE_SCENARIO_GRAPH_H
+
+#include "component_registry.h"
+
+class ScenarioGraph;
+using ScenarioGraphPtr = std::shared_ptr<const ScenarioGraph>;
+
+/*
+ * Scenario JSON compiled once into steps with resolved component factories.
+ * The graph is immutable and shared, every running scenario only creates its
+ * own steps and components from it.
+ */
+class ScenarioGraph
+{
+public:
+	struct CompiledComponent
+	{
+		ComponentRegistry::FactoryFunc m_pFactory {};
+		nlohmann::json m_Json {};
+	};
+
+	struct CompiledStep
+	{
+		StepId m_ID {};
+		std::string m_MsgInfo {};
+		int m_DelayTick {};
+		StepCompletionLogic m_CompletionLogic { StepCompletionLogic::ALL_OF };
+		std::vector<CompiledComponent> m_vComponents {};
+	};
+
+private:
+	StepId m_StartStepId {};
+	std::vector<CompiledStep> m_vSteps {};
+
+public:
+	// returns nullptr when the json has no steps
+	static ScenarioGraphPtr Compile(const nlohmann::json& Json);
+
+	// compiles the block of a scenario data string, results are cached by the data
+	static ScenarioGraphPtr Get(const std::string& ScenarioData, std::string_view Block);
+
+	const StepId& GetStartStepId() const { return m_StartStepId; }
+	const std::vector<CompiledStep>& GetSteps() const { return m_vSteps; }
+};
+
+#endif
@@ -173,23 +173,14 @@ private:
 };
 template struct ComponentRegistrar<CompleteDungeonComponent>;
 
-CDungeonScenario::CDungeonScenario(const nlohmann::json& jsonData) : GroupScenarioBase(), m_JsonData(jsonData)
+CDungeonScenario::CDungeonScenario(ScenarioGraphPtr pGraph) : GroupScenarioBase(), m_pGraph(std::move(pGraph))
 {
 }
 
 void CDungeonScenario::OnSetupScenario()
 {
-	if(!m_JsonData.is_object() || !m_JsonData.contains("steps") || !m_JsonData["steps"].is_array())
-		return;
-
-	// start step by first
-	const auto& steps = m_JsonData["steps"];
-	if(!steps.empty())
-		m_StartStepId = steps[0].value("id", "");
-
-	// setup all steps
-	for(const auto& step : steps)
-		ProcessStep(step);
+	if(m_pGraph)
+		SetupGraph(*m_pGraph);
 }
 
 void CDungeonScenario::OnScenarioStart()
@@ -201,18 +192,3 @@ void CDungeonScenario::OnScenarioEnd()
 	m_EventListener.Unregister();
 	GroupScenarioBase::OnScenarioEnd();
 }
-
-void CDungeonScenario::ProcessStep(const nlohmann::json& stepJson)
-{
-	if(!stepJson.is_object())
-		return;
-
-	StepId id = stepJson.value("id", "");
-	if(id.empty() || !stepJson.contains("components") || !stepJson["components"].is_array())
-		return;
-
-	auto& newStep = AddStep(id,
-		stepJson.value("msg_info", ""),
-		stepJson.value("delay", -1));
-	SetupStep(newStep, stepJson);
-}
@@ -2,13 +2,14 @@
 #define GAME_SERVER_CORE_SCENARIOS_SCENARIO_DUNGEON_H
 
 #include <scenarios/base/scenario_base_group.h>
+#include <scenarios/base/scenario_graph.h>
 
 #include <game/server/core/entities/logic/base_door.h>
 #include <game/server/core/tools/event_listener.h>
 
 class CDungeonScenario final : public GroupScenarioBase
 {
-	nlohmann::json m_JsonData {};
+	ScenarioGraphPtr m_pGraph {};
 	ScopedEventListener m_EventListener {};
 
 public:
@@ -20,12 +21,11 @@ public:
 	std::map<std::string, GroupDoor> m_vpDoors {};
 
 
-	explicit CDungeonScenario(const nlohmann::json& jsonData);
+	explicit CDungeonScenario(ScenarioGraphPtr pGraph);
 	~CDungeonScenario() override = default;
 
 protected:
 	void OnSetupScenario() override;
-	void ProcessStep(const nlohmann::json& step);
 	void OnScenarioStart() override;
 	void OnScenarioEnd() override;
 };
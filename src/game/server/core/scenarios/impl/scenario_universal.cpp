@@ -195,10 +195,9 @@ template struct ComponentRegistrar<UniversalConditionItemComponent>;
 template struct ComponentRegistrar<UniversalPickItemTaskComponent>;
 template struct ComponentRegistrar<UniversalShootmarkersComponent>;
 
-CUniversalScenario::CUniversalScenario(const nlohmann::json& jsonData)
-	: PlayerScenarioBase()
+CUniversalScenario::CUniversalScenario(ScenarioGraphPtr pGraph)
+	: PlayerScenarioBase(), m_pGraph(std::move(pGraph))
 {
-	m_JsonData = jsonData;
 }
 
 CUniversalScenario::~CUniversalScenario()
@@ -214,32 +213,8 @@ bool CUniversalScenario::OnStopConditions()
 
 void CUniversalScenario::OnSetupScenario()
 {
-	if(!m_JsonData.is_object() || !m_JsonData.contains("steps") || !m_JsonData["steps"].is_array())
-		return;
-
-	// start step by first
-	const auto& steps = m_JsonData["steps"];
-	if(!steps.empty())
-		m_StartStepId = steps[0].value("id", "");
-
-	// setup all steps
-	for(const auto& step : steps)
-		ProcessStep(step);
-}
-
-void CUniversalScenario::ProcessStep(const nlohmann::json& stepJson)
-{
-	if(!stepJson.is_object())
-		return;
-
-	StepId id = stepJson.value("id", "");
-	if(id.empty() || !stepJson.contains("components") || !stepJson["components"].is_array())
-		return;
-
-	auto& newStep = AddStep(id,
-		stepJson.value("msg_info", ""),
-		stepJson.value("delay", -1));
-	SetupStep(newStep, stepJson);
+	if(m_pGraph)
+		SetupGraph(*m_pGraph);
 }
 
 void CUniversalScenario::CreatePersonalDoor(const std::string& key, const vec2& pos)
@@ -3,6 +3,7 @@
 
 #include <scenarios/base/scenario_base.h>
 #include <scenarios/base/scenario_base_player.h>
+#include <scenarios/base/scenario_graph.h>
 #include <scenarios/entities/personal_door.h>
 
 #include <game/server/core/tools/event_listener.h>
@@ -13,7 +14,7 @@ class CEntityPersonalDoor;
 
 class CUniversalScenario : public PlayerScenarioBase, public IEventListener
 {
-	nlohmann::json m_JsonData {};
+	ScenarioGraphPtr m_pGraph {};
 
 	struct PersonalDoor
 	{
@@ -24,7 +25,7 @@ class CUniversalScenario : public PlayerScenarioBase, public IEventListener
 	std::vector<std::weak_ptr<CEntityGroup>> m_vpShootmarkers {};
 
 public:
-	CUniversalScenario(const nlohmann::json& jsonData);
+	CUniversalScenario(ScenarioGraphPtr pGraph);
 	~CUniversalScenario();
 
 	void CreatePersonalDoor(const std::string& key, const vec2& pos);
@@ -36,7 +37,6 @@ public:
 protected:
 	bool OnStopConditions() override;
 	void OnSetupScenario() override;
-	void ProcessStep(const nlohmann::json& step);
 };
 
 #endif
@@ -2,6 +2,7 @@
 #define GAME_SERVER_CORE_SCENARIOS_IMPL_SCENARIO_WORLD_H
 
 #include <scenarios/base/scenario_base_world.h>
+#include <scenarios/base/scenario_graph.h>
 #include <game/server/core/tools/event_listener.h>
 
 class CWorldScenario : public WorldScenarioBase, public IEventListener
@@ -15,18 +16,17 @@ public:
 	};
 
 private:
-	nlohmann::json m_JsonData {};
+	ScenarioGraphPtr m_pGraph {};
 	ScopedEventListener m_EventListener {};
 	std::vector<RewardEntry> m_vRewards {};
 
 public:
-	explicit CWorldScenario(const nlohmann::json& jsonData);
+	explicit CWorldScenario(ScenarioGraphPtr pGraph);
 	void SetContextRewards(const std::vector<RewardEntry>& vRewards) { m_vRewards = vRewards; }
 	const std::vector<RewardEntry>& GetContextRewards() const { return m_vRewards; }
 
 protected:
 	void OnSetupScenario() override;
-	void ProcessStep(const nlohmann::json& step);
 	void OnScenarioStart() override;
 	void OnScenarioEnd() override;
 	void OnCharacterDeath(CPlayer* pVictim, CPlayer* pKiller, int Weapon) override;
@@ -1,6 +1,8 @@
 ﻿#ifndef GAME_SERVER_CORE_TOOLS_EVENT_LISTENER_H
 #define GAME_SERVER_CORE_TOOLS_EVENT_LISTENER_H
 
+#include "event_listener_table.h"
+
 // forward
 class CGS;
 class IServer;
@@ -42,6 +44,7 @@ public:
 #define XDEF(name, func, ...) name,
 		LIST_OF_ALL_EVENTS(XDEF)
 #undef XDEF
+		NUM_EVENTS
 	};
 
 #define XDEF(name, func, ...) virtual void func(__VA_ARGS__) {}
@@ -51,34 +54,41 @@ public:
 
 class CEventListenerManager
 {
-	std::mutex m_Mutex;
-	std::unordered_map<IEventListener::Type, std::unordered_set<IEventListener*>> m_Listeners;
+	CEventListenerTable<IEventListener, IEventListener::NUM_EVENTS> m_Table;
 
 public:
 	void RegisterListener(IEventListener::Type event, IEventListener* listener)
 	{
-		std::unique_lock lock(m_Mutex);
-		m_Listeners[event].insert(listener);
+		m_Table.Add(event, listener);
 	}
 
 	void UnregisterListener(IEventListener::Type event, IEventListener* listener)
 	{
-		std::unique_lock lock(m_Mutex);
-		if(auto it = m_Listeners.find(event); it != m_Listeners.end())
-		{
-			it->second.erase(listener);
-			if(it->second.empty())
-				m_Listeners.erase(it);
-		}
+		m_Table.Remove(event, listener);
 	}
 
-	void LogRegisteredEvents()
+	static const char* GetEventName(IEventListener::Type event)
 	{
-		dbg_msg("EventListenerManager", "Registered events and their listeners:");
+		static constexpr const char* s_apNames[] = {
+#define XDEF(name, func, ...) #name,
+			LIST_OF_ALL_EVENTS(XDEF)
+#undef XDEF
+		};
+		return s_apNames[event];
+	}
 
-		std::unique_lock lock(m_Mutex);
-		for(const auto& [event, listeners] : m_Listeners)
-			dbg_msg("EventListenerManager", "Event: %d, Listeners count: %zu", event, listeners.size());
+	size_t GetListenersCount(IEventListener::Type event) const { return m_Table.GetListenersCount(event); }
+	uint64_t GetNotifyCount(IEventListener::Type event) const { return m_Table.GetNotificationsCount(event); }
+
+	void LogRegisteredEvents() const
+	{
+		dbg_msg("EventListenerManager", "Registered events and their listeners:");
+		for(int i = 0; i < IEventListener::NUM_EVENTS; i++)
+		{
+			const auto event = (IEventListener::Type)i;
+			if(const auto Count = GetListenersCount(event))
+				dbg_msg("EventListenerManager", "Event: %s, Listeners count: %zu", GetEventName(event), Count);
+		}
 	}
 
 	template <IEventListener::Type event, typename... Ts>
@@ -90,17 +100,12 @@ public:
 #undef XDEF
 		};
 
-		std::unique_lock lock(m_Mutex);
-		if(const auto it = m_Listeners.find(event); it != m_Listeners.end())
+		// listeners that change during the dispatch take effect from the next notify
+		const auto pfnMember = std::get<static_cast<size_t>(event)>(EventDispatchTable);
+		m_Table.ForEach(event, [&](IEventListener* pListener)
 		{
-			// safety copy listeners / e.g. in cases where the event call is recursive, or in cases where the subscriber unsubscribe in time.
-			const auto pfnMember = std::get<static_cast<size_t>(event)>(EventDispatchTable);
-			auto listenersCopy = it->second;
-			lock.unlock();
-
-			for(auto* pListener : listenersCopy)
-				(pListener->*pfnMember)(std::forward<Ts>(args)...);
-		}
+			(pListener->*pfnMember)(std::forward<Ts>(args)...);
+		});
 	}
 };
 
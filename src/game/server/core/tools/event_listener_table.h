@@ -0,0 +1,110 @@
+#ifndef GAME_SERVER_CORE_TOOLS_EVENT_LISTENER_TABLE_H
+#define GAME_SERVER_CORE_TOOLS_EVENT_LISTENER_TABLE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Listener lists per event type, read without locks or copies. A change
+ * builds a new list and publishes it, running dispatches keep walking the
+ * list they started with. Replaced lists are freed by a later change once
+ * no dispatch of that event is running.
+ */
+template<typename TListener, size_t NumTypes>
+class CEventListenerTable
+{
+	using ListenerList = std::vector<TListener*>;
+
+	struct CBucket
+	{
+		// readers are counted before the list is loaded, both seq_cst, so a
+		// writer that sees no readers after publishing can free retired lists
+		std::atomic<const ListenerList*> m_pList {};
+		std::atomic<int> m_Readers {};
+		std::atomic<size_t> m_NumListeners {};
+		std::atomic<uint64_t> m_NumNotifications {};
+
+		// writer side, guarded by m_WriteMutex
+		std::unique_ptr<const ListenerList> m_pOwned {};
+		std::vector<std::unique_ptr<const ListenerList>> m_vRetired {};
+	};
+
+	std::mutex m_WriteMutex;
+	std::array<CBucket, NumTypes> m_aBuckets {};
+
+	void Publish(CBucket& Bucket, std::unique_ptr<const ListenerList> pNewList)
+	{
+		Bucket.m_NumListeners = pNewList ? pNewList->size() : 0;
+		Bucket.m_pList = pNewList.get();
+		if(Bucket.m_pOwned)
+			Bucket.m_vRetired.push_back(std::move(Bucket.m_pOwned));
+		Bucket.m_pOwned = std::move(pNewList);
+
+		if(Bucket.m_Readers == 0)
+			Bucket.m_vRetired.clear();
+	}
+
+public:
+	bool Add(size_t Type, TListener* pListener)
+	{
+		std::scoped_lock Lock(m_WriteMutex);
+		auto& Bucket = m_aBuckets[Type];
+		if(Bucket.m_pOwned && std::ranges::find(*Bucket.m_pOwned, pListener) != Bucket.m_pOwned->end())
+			return false;
+
+		auto pNewList = Bucket.m_pOwned ? std::make_unique<ListenerList>(*Bucket.m_pOwned) : std::make_unique<ListenerList>();
+		pNewList->push_back(pListener);
+		Publish(Bucket, std::move(pNewList));
+		return true;
+	}
+
+	bool Remove(size_t Type, TListener* pListener)
+	{
+		std::scoped_lock Lock(m_WriteMutex);
+		auto& Bucket = m_aBuckets[Type];
+		if(!Bucket.m_pOwned || std::ranges::find(*Bucket.m_pOwned, pListener) == Bucket.m_pOwned->end())
+			return false;
+
+		std::unique_ptr<ListenerList> pNewList;
+		if(Bucket.m_pOwned->size() > 1)
+		{
+			pNewList = std::make_unique<ListenerList>();
+			pNewList->reserve(Bucket.m_pOwned->size() - 1);
+			std::ranges::copy_if(*Bucket.m_pOwned, std::back_inserter(*pNewList), [pListener](TListener* p) { return p != pListener; });
+		}
+		Publish(Bucket, std::move(pNewList));
+		return true;
+	}
+
+	template<typename F>
+	void ForEach(size_t Type, F&& Func)
+	{
+		struct CReadGuard
+		{
+			std::atomic<int>& m_Readers;
+			explicit CReadGuard(std::atomic<int>& Readers) : m_Readers(Readers) { ++m_Readers; }
+			~CReadGuard() { --m_Readers; }
+		};
+
+		auto& Bucket = m_aBuckets[Type];
+		Bucket.m_NumNotifications.fetch_add(1, std::memory_order_relaxed);
+
+		CReadGuard Guard(Bucket.m_Readers);
+		if(const auto* pList = Bucket.m_pList.load())
+		{
+			for(auto* pListener : *pList)
+				Func(pListener);
+		}
+	}
+
+	size_t GetListenersCount(size_t Type) const { return m_aBuckets[Type].m_NumListeners; }
+	uint64_t GetNotificationsCount(size_t Type) const { return m_aBuckets[Type].m_NumNotifications.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef GAME_SERVER_CORE_TOOLS_LEADERBOARD_H
+#define GAME_SERVER_CORE_TOOLS_LEADERBOARD_H
+
+#include <set>
+#include <string>
+#include <unordered_map>
+
+/*
+ * Ranking kept in memory and reordered on every change, so reading the
+ * top N is a walk over the first N entries. Higher scores rank first,
+ * equal scores are ordered by the lower ID.
+ */
+template<typename TScore>
+class CLeaderboard
+{
+	struct CRank
+	{
+		TScore m_Score;
+		int m_ID;
+
+		bool operator<(const CRank& Other) const
+		{
+			if(Other.m_Score < m_Score)
+				return true;
+			if(m_Score < Other.m_Score)
+				return false;
+			return m_ID < Other.m_ID;
+		}
+	};
+
+	struct CEntry
+	{
+		TScore m_Score;
+		std::string m_Name;
+	};
+
+	std::set<CRank> m_Ranking {};
+	std::unordered_map<int, CEntry> m_vEntries {};
+
+public:
+	// the name is only taken for a new entry, renames go through Rename
+	void Set(int ID, const std::string& Name, const TScore& Score)
+	{
+		auto It = m_vEntries.find(ID);
+		if(It == m_vEntries.end())
+		{
+			m_vEntries.emplace(ID, CEntry { Score, Name });
+			m_Ranking.insert(CRank { Score, ID });
+			return;
+		}
+
+		if(!(It->second.m_Score < Score) && !(Score < It->second.m_Score))
+			return;
+
+		m_Ranking.erase(CRank { It->second.m_Score, ID });
+		It->second.m_Score = Score;
+		m_Ranking.insert(CRank { Score, ID });
+	}
+
+	void Rename(int ID, const std::string& Name)
+	{
+		if(auto It = m_vEntries.find(ID); It != m_vEntries.end())
+			It->second.m_Name = Name;
+	}
+
+	void Remove(int ID)
+	{
+		auto It = m_vEntries.find(ID);
+		if(It == m_vEntries.end())
+			return;
+
+		m_Ranking.erase(CRank { It->second.m_Score, ID });
+		m_vEntries.erase(It);
+	}
+
+	void Clear()
+	{
+		m_Ranking.clear();
+		m_vEntries.clear();
+	}
+
+	size_t Size() const { return m_vEntries.size(); }
+
+	// callback receives (rank starting from 1, id, name, score)
+	template<typename F>
+	void ForEachTop(int Rows, F&& Callback) const
+	{
+		int Rank = 1;
+		for(auto It = m_Ranking.begin(); It != m_Ranking.end() && Rank <= Rows; ++It, ++Rank)
+			Callback(Rank, It->m_ID, m_vEntries.at(It->m_ID).m_Name, It->m_Score);
+	}
+};
+
+#endif
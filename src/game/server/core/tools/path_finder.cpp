@@ -1,5 +1,6 @@
 #include "path_finder.h"
 
+#include <engine/server/tick_profiler.h>
 #include <game/collision.h>
 #include <game/mapitems.h>
 #include <game/layers.h>
@@ -10,16 +11,15 @@ struct std::hash<ivec2>
 	std::size_t operator()(const ivec2& v) const noexcept { return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1); }
 };
 
-CPathFinder::CPathFinder(CCollision* pCollision)
-	: m_pLayers(pCollision->GetLayers()), m_pCollision(pCollision)
+CPathFinder::CPathFinder(CCollision* pCollision, CTickProfiler* pProfiler, int WorldID)
+	: m_pLayers(pCollision->GetLayers()), m_pCollision(pCollision), m_pProfiler(pProfiler), m_WorldID(WorldID)
 {
 	m_Height = m_pLayers->GameLayer()->m_Height;
 	m_Width = m_pLayers->GameLayer()->m_Width;
+	m_pMapData = GetSharedMapData(pCollision);
 
-	m_MapData = MapData(m_Width, m_Height);
-	m_vCostSoFar.resize(m_Width * m_Height, std::numeric_limits<int>::max());
-	m_vCameFrom.resize(m_Width * m_Height, ivec2 { -1, -1 });
-	Initialize();
+	const size_t FieldSize = (size_t)m_Width * m_Height * sizeof(uint16_t);
+	m_MaxFlowFields = (int)clamp<size_t>(FLOW_FIELDS_BUDGET / FieldSize, 1, MAX_FLOW_FIELDS);
 }
 
 CPathFinder::~CPathFinder()
@@ -35,26 +35,45 @@ CPathFinder::~CPathFinder()
 	}
 }
 
-void CPathFinder::Initialize()
+std::shared_ptr<const MapData> CPathFinder::GetSharedMapData(CCollision* pCollision)
 {
-	for(int y = 0; y < m_Height; y++)
+	// worlds built from the same map file share the map, so they share the path graph too
+	static std::mutex s_Mutex;
+	static std::map<const IMap*, std::weak_ptr<const MapData>> s_Cache;
+
+	const IMap* pMap = pCollision->GetLayers()->Map();
+	std::lock_guard Lock(s_Mutex);
+	if(auto pData = s_Cache[pMap].lock())
+		return pData;
+
+	const int Width = pCollision->GetWidth();
+	const int Height = pCollision->GetHeight();
+	auto pData = std::make_shared<MapData>(Width, Height);
+	for(int y = 0; y < Height; y++)
 	{
-		for(int x = 0; x < m_Width; x++)
+		for(int x = 0; x < Width; x++)
 		{
 			// initialize collides
 			const vec2 Position(static_cast<float>(x) * 32.f + 16.f, static_cast<float>(y) * 32.f + 16.f);
-			m_MapData.SetCollide(x, y, m_pCollision->CheckPoint(Position));
+			pData->SetCollide(x, y, pCollision->CheckPoint(Position));
 
 			// initialize teleports
-			if(const auto& optTeleValue = m_pCollision->TryGetTeleportOut(Position))
+			if(const auto& optTeleValue = pCollision->TryGetTeleportOut(Position))
 			{
-				const int Nx = clamp(round_to_int(optTeleValue->x) / 32, 0, m_Width - 1);
-				const int Ny = clamp(round_to_int(optTeleValue->y) / 32, 0, m_Height - 1);
-				m_MapData.SetTeleport(x, y, Nx, Ny);
+				const int Nx = clamp(round_to_int(optTeleValue->x) / 32, 0, Width - 1);
+				const int Ny = clamp(round_to_int(optTeleValue->y) / 32, 0, Height - 1);
+				pData->SetTeleport(x, y, Nx, Ny);
 			}
 		}
 	}
 
+	s_Cache[pMap] = pData;
+	return pData;
+}
+
+void CPathFinder::StartThread()
+{
+	// the worker and its search buffers only exist once the world asks for a path
 	m_Running = true;
 	m_WorkerThread = std::thread(&CPathFinder::PathfindingThread, this);
 }
@@ -71,12 +90,31 @@ void CPathFinder::RequestPath(PathRequestHandle& Handle, const vec2& Start, cons
 	request.Start = istart;
 	request.End = iend;
 	Handle.Future = request.Promise.get_future();
+	QueueRequest(std::move(request));
+}
+
+void CPathFinder::RequestFlowPath(PathRequestHandle& Handle, const vec2& Start, const vec2& End)
+{
+	if(Handle.IsValid())
+		return;
+
+	PathRequest request;
+	request.Start = ivec2((int)Start.x / 32, (int)Start.y / 32);
+	request.End = ivec2((int)End.x / 32, (int)End.y / 32);
+	request.FlowField = true;
+	Handle.Future = request.Promise.get_future();
+	QueueRequest(std::move(request));
+}
 
+void CPathFinder::QueueRequest(PathRequest&& request)
+{
 	{
 		std::lock_guard lock(m_QueueMutex);
 		m_vRequestQueue.push(std::move(request));
 	}
 
+	if(!m_WorkerThread.joinable())
+		StartThread();
 	m_Condition.notify_one();
 }
 
@@ -108,7 +146,12 @@ void CPathFinder::PathfindingThread()
 
 		for(auto& request : currentRequestsBatch)
 		{
-			std::vector<vec2> vPath = FindPath(request.Start, request.End);
+			std::vector<vec2> vPath;
+			{
+				// runs on the worker thread, each request is one sample
+				CTickProfiler::CScope Scope(m_pProfiler, m_WorldID, CTickProfiler::PHASE_PATHFINDING);
+				vPath = request.FlowField ? FindFlowPath(request.Start, request.End) : FindPath(request.Start, request.End);
+			}
 			const bool bSuccess = !vPath.empty();
 			auto resultPtr = std::make_unique<PathResult>(PathResult { std::move(vPath), bSuccess });
 
@@ -140,7 +183,7 @@ std::vector<vec2> CPathFinder::FindPath(const ivec2& Start, const ivec2& End)
 		return vPath;
 	}
 
-	if(m_MapData.IsCollide(Start.x, Start.y) || m_MapData.IsCollide(End.x, End.y))
+	if(m_pMapData->IsCollide(Start.x, Start.y) || m_pMapData->IsCollide(End.x, End.y))
 		return vPath;
 
 	// skip same
@@ -151,6 +194,11 @@ std::vector<vec2> CPathFinder::FindPath(const ivec2& Start, const ivec2& End)
 	}
 
 	// initialize variables
+	if(m_vCostSoFar.empty())
+	{
+		m_vCostSoFar.resize(m_Width * m_Height);
+		m_vCameFrom.resize(m_Width * m_Height, ivec2 { -1, -1 });
+	}
 	std::ranges::fill(m_vCostSoFar, std::numeric_limits<int>::max());
 
 	auto ToIndex = [this](const ivec2& pos)
@@ -180,10 +228,10 @@ std::vector<vec2> CPathFinder::FindPath(const ivec2& Start, const ivec2& End)
 		const int currentIndex = ToIndex(current);
 
 		// check if the current tile is a teleport
-		if(m_MapData.IsTeleport(current.x, current.y))
+		if(m_pMapData->IsTeleport(current.x, current.y))
 		{
 			// get the destination of the teleport
-			ivec2 teleportDest = m_MapData.GetTeleportDestination(current.x, current.y);
+			ivec2 teleportDest = m_pMapData->GetTeleportDestination(current.x, current.y);
 			const int teleportIndex = ToIndex(teleportDest);
 			const int teleportCost = m_vCostSoFar[currentIndex] + 1;
 
@@ -204,7 +252,7 @@ std::vector<vec2> CPathFinder::FindPath(const ivec2& Start, const ivec2& End)
 			if(next.x < 0 || next.x >= m_Width || next.y < 0 || next.y >= m_Height)
 				continue;
 
-			if(m_MapData.IsCollide(next.x, next.y))
+			if(m_pMapData->IsCollide(next.x, next.y))
 				continue;
 
 			const int nextIndex = ToIndex(next);
@@ -234,6 +282,137 @@ std::vector<vec2> CPathFinder::FindPath(const ivec2& Start, const ivec2& End)
 	return vPath;
 }
 
+const CPathFinder::CFlowField& CPathFinder::GetFlowField(const ivec2& Target)
+{
+	const int TargetIndex = Target.y * m_Width + Target.x;
+	if(const auto It = std::ranges::find(m_lFlowFields, TargetIndex, &CFlowField::m_Target); It != m_lFlowFields.end())
+	{
+		m_lFlowFields.splice(m_lFlowFields.begin(), m_lFlowFields, It);
+		return m_lFlowFields.front();
+	}
+
+	// reuse the least recently used field
+	if((int)m_lFlowFields.size() >= m_MaxFlowFields)
+		m_lFlowFields.splice(m_lFlowFields.begin(), m_lFlowFields, std::prev(m_lFlowFields.end()));
+	else
+		m_lFlowFields.emplace_front();
+
+	auto& Field = m_lFlowFields.front();
+	Field.m_Target = TargetIndex;
+	Field.m_vDistance.assign((size_t)m_Width * m_Height, FLOW_UNREACHABLE);
+
+	// teleports lead from a source to a destination, the search runs backwards so it needs them by destination
+	std::vector<std::pair<int, int>> vTeleportsByDest;
+	for(int y = 0; y < m_Height; y++)
+	{
+		for(int x = 0; x < m_Width; x++)
+		{
+			if(m_pMapData->IsTeleport(x, y))
+			{
+				const ivec2 Dest = m_pMapData->GetTeleportDestination(x, y);
+				vTeleportsByDest.emplace_back(Dest.y * m_Width + Dest.x, y * m_Width + x);
+			}
+		}
+	}
+	std::ranges::sort(vTeleportsByDest);
+
+	// breadth first from the target, every step costs the same like in FindPath
+	std::vector<int> vQueue;
+	vQueue.reserve((size_t)m_Width * m_Height / 4);
+	Field.m_vDistance[TargetIndex] = 0;
+	vQueue.push_back(TargetIndex);
+	constexpr std::array<ivec2, 4> directions = { {{-1, 0}, {1, 0}, {0, -1}, {0, 1}} };
+	for(size_t Head = 0; Head < vQueue.size(); Head++)
+	{
+		const int Current = vQueue[Head];
+		const int NextDistance = Field.m_vDistance[Current] + 1;
+		if(NextDistance >= FLOW_UNREACHABLE)
+			break;
+
+		const auto Visit = [&](int Index)
+		{
+			if(Field.m_vDistance[Index] == FLOW_UNREACHABLE && !m_pMapData->IsCollide(Index % m_Width, Index / m_Width))
+			{
+				Field.m_vDistance[Index] = (uint16_t)NextDistance;
+				vQueue.push_back(Index);
+			}
+		};
+
+		// neighbors that can step onto the current tile
+		if(!m_pMapData->IsCollide(Current % m_Width, Current / m_Width))
+		{
+			for(const auto& dir : directions)
+			{
+				const int x = Current % m_Width + dir.x;
+				const int y = Current / m_Width + dir.y;
+				if(x >= 0 && x < m_Width && y >= 0 && y < m_Height)
+					Visit(y * m_Width + x);
+			}
+		}
+
+		// teleports that lead onto the current tile
+		const auto Range = std::ranges::equal_range(vTeleportsByDest, std::make_pair(Current, 0),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+		for(const auto& [Dest, Source] : Range)
+			Visit(Source);
+	}
+
+	return Field;
+}
+
+std::vector<vec2> CPathFinder::FindFlowPath(const ivec2& Start, const ivec2& End)
+{
+	std::vector<vec2> vPath;
+
+	if(Start.x < 0 || Start.x >= m_Width || Start.y < 0 || Start.y >= m_Height ||
+		End.x < 0 || End.x >= m_Width || End.y < 0 || End.y >= m_Height)
+	{
+		dbg_msg("path_finder", "invalid start/end coordinates.");
+		return vPath;
+	}
+
+	if(m_pMapData->IsCollide(Start.x, Start.y) || m_pMapData->IsCollide(End.x, End.y))
+		return vPath;
+
+	const auto& Field = GetFlowField(End);
+	if(Field.m_vDistance[Start.y * m_Width + Start.x] == FLOW_UNREACHABLE)
+		return vPath;
+
+	// walk down the distances, any tile one step closer is on a shortest path
+	constexpr std::array<ivec2, 4> directions = { {{-1, 0}, {1, 0}, {0, -1}, {0, 1}} };
+	ivec2 current = Start;
+	int distance = Field.m_vDistance[Start.y * m_Width + Start.x];
+	vPath.reserve(distance + 1);
+	vPath.emplace_back(static_cast<float>(current.x) * 32.f + 16.f, static_cast<float>(current.y) * 32.f + 16.f);
+	while(distance > 0)
+	{
+		ivec2 next = current;
+		if(m_pMapData->IsTeleport(current.x, current.y))
+		{
+			const ivec2 teleportDest = m_pMapData->GetTeleportDestination(current.x, current.y);
+			if(Field.m_vDistance[teleportDest.y * m_Width + teleportDest.x] == distance - 1)
+				next = teleportDest;
+		}
+
+		for(int i = 0; i < (int)directions.size() && next == current; i++)
+		{
+			const ivec2 neighbor = { current.x + directions[i].x, current.y + directions[i].y };
+			if(neighbor.x >= 0 && neighbor.x < m_Width && neighbor.y >= 0 && neighbor.y < m_Height &&
+				!m_pMapData->IsCollide(neighbor.x, neighbor.y) && Field.m_vDistance[neighbor.y * m_Width + neighbor.x] == distance - 1)
+				next = neighbor;
+		}
+
+		if(next == current)
+			return {};
+
+		current = next;
+		distance--;
+		vPath.emplace_back(static_cast<float>(current.x) * 32.f + 16.f, static_cast<float>(current.y) * 32.f + 16.f);
+	}
+
+	return vPath;
+}
+
 vec2 CPathFinder::GetRandomWaypointRadius(const vec2& Pos, float Radius) const
 {
 	const float RadiusSquared = Radius * Radius;
@@ -253,7 +432,7 @@ vec2 CPathFinder::GetRandomWaypointRadius(const vec2& Pos, float Radius) const
 
 		for(int x = StartX; x <= EndX; ++x)
 		{
-			if(!m_MapData.IsCollide(x, y))
+			if(!m_pMapData->IsCollide(x, y))
 			{
 				const float xCenter = x * 32.0f + 16.0f;
 				const float deltaX = Pos.x - xCenter;
@@ -66,23 +66,47 @@ private:
 class CPathFinder
 {
 public:
-	CPathFinder(class CCollision* pCollision);
+	CPathFinder(class CCollision* pCollision, class CTickProfiler* pProfiler, int WorldID);
 	~CPathFinder();
 
-	void Initialize();
 	void RequestPath(PathRequestHandle& Handle, const vec2& Start, const vec2& End);
 	void RequestRandomPath(PathRequestHandle& Handle, const vec2& Start, float Radius);
 
+	// for fixed targets, the distances toward the target are built once and every
+	// later request to the same target only walks down the distances
+	void RequestFlowPath(PathRequestHandle& Handle, const vec2& Start, const vec2& End);
+
 private:
+	enum
+	{
+		// a field takes 2 bytes per tile, a 1000x1000 map fits 4 fields and a 300x200 map the maximum
+		FLOW_FIELDS_BUDGET = 8 * 1024 * 1024,
+		MAX_FLOW_FIELDS = 32,
+		FLOW_UNREACHABLE = 0xffff,
+	};
+
+	struct CFlowField
+	{
+		int m_Target {};
+		std::vector<uint16_t> m_vDistance {};
+	};
+
+	static std::shared_ptr<const MapData> GetSharedMapData(CCollision* pCollision);
+	void StartThread();
+	void QueueRequest(PathRequest&& request);
 	void PathfindingThread();
 	std::vector<vec2> FindPath(const ivec2& Start, const ivec2& End);
+	std::vector<vec2> FindFlowPath(const ivec2& Start, const ivec2& End);
+	const CFlowField& GetFlowField(const ivec2& Target);
 	vec2 GetRandomWaypointRadius(const vec2& Pos, float Radius) const;
 
 	int m_Width{};
 	int m_Height{};
-	MapData m_MapData{};
+	std::shared_ptr<const MapData> m_pMapData{};
 	std::vector<int> m_vCostSoFar{};
 	std::vector<ivec2> m_vCameFrom{};
+	std::list<CFlowField> m_lFlowFields{}; // worker thread only, most recently used first
+	int m_MaxFlowFields{};
 
 	std::queue<PathRequest> m_vRequestQueue{};
 	std::condition_variable m_Condition{};
@@ -90,8 +114,10 @@ private:
 	std::thread m_WorkerThread{};
 	std::mutex m_QueueMutex{};
 
-	CLayers* m_pLayers{};
+	class CLayers* m_pLayers{};
 	CCollision* m_pCollision{};
+	CTickProfiler* m_pProfiler{};
+	int m_WorldID{};
 };
 
 #endif
\ No newline at end of file
@@ -11,6 +11,7 @@ struct PathRequest
 {
 	ivec2 Start;
 	ivec2 End;
+	bool FlowField {};
 	std::promise<std::unique_ptr<PathResult>> Promise;
 };
 
@@ -5,14 +5,6 @@
 #include <game/collision.h>
 #include <game/server/entities/character.h>
 
-namespace
-{
-	bool IsPosInActionZone(CCollision* pCollision, vec2 Pos, std::string_view ActionZoneName)
-	{
-		return pCollision->IsActiveActionZone(ActionZoneName, Pos);
-	}
-}
-
 void CTileHandler::Handle(int Index)
 {
 	// initialize variables
@@ -40,15 +32,15 @@ void CTileHandler::Handle(int Index)
 	}
 
 	// handle action zone
-	m_aActionZonePrevPos[(int)EActionZonePosition::PLAYER] = m_aActionZonePos[(int)EActionZonePosition::PLAYER];
-	m_aActionZonePrevPos[(int)EActionZonePosition::MOUSE] = m_aActionZonePos[(int)EActionZonePosition::MOUSE];
-	m_aActionZonePos[(int)EActionZonePosition::PLAYER] = m_pCharacter->GetPos();
-	m_aActionZonePos[(int)EActionZonePosition::MOUSE] = m_pCharacter->GetMousePos();
-	if(!m_ActionZonePosInitialized)
+	m_aPrevActionZones[(int)EActionZonePosition::PLAYER] = m_aActionZones[(int)EActionZonePosition::PLAYER];
+	m_aPrevActionZones[(int)EActionZonePosition::MOUSE] = m_aActionZones[(int)EActionZonePosition::MOUSE];
+	m_aActionZones[(int)EActionZonePosition::PLAYER] = m_pCollision->GetActionZoneID(m_pCharacter->GetPos());
+	m_aActionZones[(int)EActionZonePosition::MOUSE] = m_pCollision->GetActionZoneID(m_pCharacter->GetMousePos());
+	if(!m_ActionZonesInitialized)
 	{
-		m_aActionZonePrevPos[(int)EActionZonePosition::PLAYER] = m_aActionZonePos[(int)EActionZonePosition::PLAYER];
-		m_aActionZonePrevPos[(int)EActionZonePosition::MOUSE] = m_aActionZonePos[(int)EActionZonePosition::MOUSE];
-		m_ActionZonePosInitialized = true;
+		m_aPrevActionZones[(int)EActionZonePosition::PLAYER] = m_aActionZones[(int)EActionZonePosition::PLAYER];
+		m_aPrevActionZones[(int)EActionZonePosition::MOUSE] = m_aActionZones[(int)EActionZonePosition::MOUSE];
+		m_ActionZonesInitialized = true;
 	}
 }
 
@@ -80,23 +72,26 @@ bool CTileHandler::IsExit(int TileIndex)
 	return Exited;
 }
 
+// zone ids are interned by name, so the name is only compared when the zone changed or is active
+
 bool CTileHandler::IsEnterActionZone(std::string_view ActionZoneName, EActionZonePosition Position) const
 {
-	const int PositionIndex = (int)Position;
-	const bool IsCurrent = IsPosInActionZone(m_pCollision, m_aActionZonePos[PositionIndex], ActionZoneName);
-	const bool IsPrev = IsPosInActionZone(m_pCollision, m_aActionZonePrevPos[PositionIndex], ActionZoneName);
-	return IsCurrent && !IsPrev;
+	const int Current = m_aActionZones[(int)Position];
+	if(!Current || Current == m_aPrevActionZones[(int)Position])
+		return false;
+	return m_pCollision->GetActionZoneName(Current) == ActionZoneName;
 }
 
 bool CTileHandler::IsLeaveActionZone(std::string_view ActionZoneName, EActionZonePosition Position) const
 {
-	const int PositionIndex = (int)Position;
-	const bool IsCurrent = IsPosInActionZone(m_pCollision, m_aActionZonePos[PositionIndex], ActionZoneName);
-	const bool IsPrev = IsPosInActionZone(m_pCollision, m_aActionZonePrevPos[PositionIndex], ActionZoneName);
-	return !IsCurrent && IsPrev;
+	const int Prev = m_aPrevActionZones[(int)Position];
+	if(!Prev || Prev == m_aActionZones[(int)Position])
+		return false;
+	return m_pCollision->GetActionZoneName(Prev) == ActionZoneName;
 }
 
 bool CTileHandler::IsActiveActionZone(std::string_view ActionZoneName, EActionZonePosition Position) const
 {
-	return IsPosInActionZone(m_pCollision, m_aActionZonePos[(int)Position], ActionZoneName);
+	const int Current = m_aActionZones[(int)Position];
+	return Current && m_pCollision->GetActionZoneName(Current) == ActionZoneName;
 }
\ No newline at end of file
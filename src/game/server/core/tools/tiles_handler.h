@@ -56,9 +56,9 @@ class CTileHandler
 	int m_MarkedTiles[TILES_LAYER_NUM] {};
 	int m_MarkEnter[TILES_LAYER_NUM] {};
 	int m_MarkExit[TILES_LAYER_NUM] {};
-	vec2 m_aActionZonePos[(int)EActionZonePosition::NUM_POSITIONS] {};
-	vec2 m_aActionZonePrevPos[(int)EActionZonePosition::NUM_POSITIONS] {};
-	bool m_ActionZonePosInitialized {};
+	int m_aActionZones[(int)EActionZonePosition::NUM_POSITIONS] {};
+	int m_aPrevActionZones[(int)EActionZonePosition::NUM_POSITIONS] {};
+	bool m_ActionZonesInitialized {};
 	int m_MoveRestrictions {};
 
 public:
@@ -51,7 +51,7 @@ CCharacter::~CCharacter()
 {
 	delete m_pTilesHandler;
 	m_pMultipleOrbit = nullptr;
-	GS()->m_World.m_Core.m_apCharacters[m_pPlayer->GetCID()] = nullptr;
+	GS()->m_World.m_Core.RemoveCore(m_pPlayer->GetCID());
 }
 
 bool CCharacter::Spawn(CPlayer* pPlayer, vec2 Pos)
@@ -81,7 +81,7 @@ bool CCharacter::Spawn(CPlayer* pPlayer, vec2 Pos)
 	m_AutoFishingEnabled = false;
 	m_SendCore = {};
 	m_NumInputs = 0;
-	GS()->m_World.m_Core.m_apCharacters[m_ClientID] = &m_Core;
+	GS()->m_World.m_Core.InsertCore(m_ClientID, &m_Core);
 	GS()->m_World.InsertEntity(this);
 	m_Alive = true;
 
@@ -433,6 +433,7 @@ void CCharacter::HandleNinja()
 		// Set velocity
 		m_Core.m_Vel = m_Ninja.m_ActivationDir * g_pData->m_Weapons.m_Ninja.m_Velocity;
 		GS()->Collision()->MoveBox(&m_Core.m_Pos, &m_Core.m_Vel, vec2(GetRadius(), GetRadius()), 0.f);
+		GS()->m_World.m_Core.UpdateCore(&m_Core);
 
 		// reset velocity so the client doesn't predict stuff
 		m_Core.m_Vel = vec2(0.f, 0.f);
@@ -685,7 +686,7 @@ void CCharacter::OnDirectInput(CNetObj_PlayerInput* pNewInput)
 
 	if(Server()->Input()->IsBlockedInputGroup(m_pPlayer->GetCID(), BLOCK_INPUT_HOOK))
 	{
-		CTuningParams* pTuningParams = &m_pPlayer->m_NextTuningParams;
+		CTuningParams* pTuningParams = m_pPlayer->OverrideTuning(CPlayer::TUNING_LAYER_HOOK_BLOCKED);
 		pTuningParams->m_HookLength = 0.0f;
 		pTuningParams->m_HookFireSpeed = 0.0f;
 		pTuningParams->m_HookDragSpeed = 0.0f;
@@ -897,7 +898,7 @@ int CCharacter::GetMaxWaterAir() const
 	return pBreathingReed->IsEquipped() ? 16 : 8;
 }
 
-void CCharacter::HandleWater(CTuningParams* pTuningParams)
+void CCharacter::HandleWater()
 {
 	if(!m_pTilesHandler->IsActive(TILE_WATER))
 	{
@@ -914,8 +915,10 @@ void CCharacter::HandleWater(CTuningParams* pTuningParams)
 	// apply physics
 	bool hasDriverKit = m_pPlayer->GetItem(itDiversKit)->IsEquipped();
 	bool isKeptAfloat = m_pPlayer->GetItem(itLifePreserver)->IsEquipped() || hasDriverKit;
+	CTuningParams* pTuningParams = m_pPlayer->OverrideTuning(CPlayer::TUNING_LAYER_WATER);
 	pTuningParams->ApplyDiff(CTuneZoneManager::GetInstance().GetParams(ETuneZone::WATER));
-	pTuningParams->m_Gravity = isKeptAfloat ? -0.05f : pTuningParams->m_Gravity;
+	if(isKeptAfloat)
+		m_pPlayer->OverrideTuning(CPlayer::TUNING_LAYER_AFLOAT)->m_Gravity = -0.05f;
 	m_TuneZoneOverride = static_cast<int>(ETuneZone::WATER);
 	SetEmote(EMOTE_BLINK, 1, false);
 
@@ -982,7 +985,7 @@ void CCharacter::Die(int Killer, int Weapon)
 
 	// remove from world
 	GS()->m_World.RemoveEntity(this);
-	GS()->m_World.m_Core.m_apCharacters[m_ClientID] = nullptr;
+	GS()->m_World.m_Core.RemoveCore(m_ClientID);
 	GS()->CreateDeath(m_Pos, m_ClientID);
 	GS()->CreateSound(m_Pos, SOUND_PLAYER_DIE);
 }
@@ -1340,21 +1343,21 @@ void CCharacter::PostSnap()
 
 bool CCharacter::HandleTiles()
 {
-	// handle Anti-Skip tiles
-	int CurrentIndex = GS()->Collision()->GetMapIndex(m_Pos);
-	std::vector<int> vIndices = GS()->Collision()->GetMapIndices(m_PrevPos, m_Pos);
-	if(!vIndices.empty())
+	// handle Anti-Skip tiles, only tiles with something on them are visited
+	bool Handled = false;
+	GS()->Collision()->ForEachSpecialTile(m_PrevPos, m_Pos, [this, &Handled](int Index)
 	{
-		for(int& Index : vIndices)
-		{
-			HandleTilesImpl(Index);
-			if(!m_Alive)
-				return false;
-		}
-	}
-	else
+		Handled = true;
+		HandleTilesImpl(Index);
+		return m_Alive;
+	});
+	if(!m_Alive)
+		return false;
+
+	// nothing special on the way, still update the move restrictions and tile states
+	if(!Handled)
 	{
-		HandleTilesImpl(CurrentIndex);
+		HandleTilesImpl(GS()->Collision()->GetMapIndex(m_Pos));
 		if(!m_Alive)
 			return false;
 	}
@@ -1504,7 +1507,7 @@ void CCharacter::HandleTilesImpl(int Index)
 		// zone information
 		if(m_pTilesHandler->IsActive(TILE_SW_ZONE))
 		{
-			const auto pZone = GS()->Collision()->GetZonedetail(m_Pos);
+			const auto* pZone = GS()->Collision()->GetZoneDetail(m_Pos);
 			if(pZone && ((Server()->Tick() % Server()->TickSpeed() == 0) || m_Zonename != pZone->Name))
 			{
 				m_Zonename = pZone->Name;
@@ -1609,11 +1612,10 @@ void CCharacter::MovingDisable(bool State)
 
 void CCharacter::HandleIndependentTuning()
 {
-	CTuningParams* pTuningParams = &m_pPlayer->m_NextTuningParams;
-
 	// freeze moving
 	if(m_Core.m_MovingDisabled)
 	{
+		CTuningParams* pTuningParams = m_pPlayer->OverrideTuning(CPlayer::TUNING_LAYER_MOVING_DISABLED);
 		pTuningParams->m_GroundFriction = 1.0f;
 		pTuningParams->m_GroundControlSpeed = 0.0f;
 		pTuningParams->m_GroundControlAccel = 0.0f;
@@ -1627,16 +1629,17 @@ void CCharacter::HandleIndependentTuning()
 	}
 
 	// handle water
-	HandleWater(pTuningParams);
+	HandleWater();
 
 	// potions and buffs are different
-	HandleBuff(pTuningParams);
+	HandleBuff();
 }
 
-void CCharacter::HandleBuff(CTuningParams* TuningParams)
+void CCharacter::HandleBuff()
 {
 	if(m_pPlayer->m_Effects.IsActive(EFFECT_NAME_SLOWNESS))
 	{
+		CTuningParams* TuningParams = m_pPlayer->OverrideTuning(CPlayer::TUNING_LAYER_SLOWNESS);
 		TuningParams->m_Gravity = 0.35f;
 		TuningParams->m_GroundFriction = 0.45f;
 		TuningParams->m_GroundControlSpeed = 100.0f / Server()->TickSpeed();
@@ -1651,6 +1654,7 @@ void CCharacter::HandleBuff(CTuningParams* TuningParams)
 
 	if(m_pPlayer->m_Effects.IsActive(EFFECT_NAME_STUN))
 	{
+		CTuningParams* TuningParams = m_pPlayer->OverrideTuning(CPlayer::TUNING_LAYER_STUN);
 		TuningParams->m_Gravity = 0.25f;
 		TuningParams->m_GroundFriction = 0.45f;
 		TuningParams->m_GroundControlSpeed = 30.0f / Server()->TickSpeed();
@@ -1954,6 +1958,7 @@ void CCharacter::ChangePosition(vec2 NewPos)
 	GS()->CreateDeath(m_Core.m_Pos, m_pPlayer->GetCID());
 	GS()->CreatePlayerSpawn(NewPos);
 	m_Core.m_Pos = NewPos;
+	GS()->m_World.m_Core.UpdateCore(&m_Core);
 	m_Pos = NewPos;
 	ResetHook();
 }
@@ -46,7 +46,7 @@ class CCharacter : public CEntity
 	CCharacterCore m_ReckoningCore {}; // the dead reckoning core
 
 	int GetMaxWaterAir() const;
-	void HandleWater(CTuningParams* TuningParams);
+	void HandleWater();
 
 	void HandleReload();
 	void HandleWeaponSwitch();
@@ -55,7 +55,7 @@ class CCharacter : public CEntity
 
 	void HandleHookActions();
 	bool HandleHammerActions(vec2 Direction, vec2 ProjStartPos);
-	void HandleBuff(CTuningParams* TuningParams);
+	void HandleBuff();
 	void HandlePlayer();
 	bool CanAccessWorld() const;
 
@@ -1,5 +1,6 @@
 /* (c) Alexandre Díaz. See licence.txt in the root of the distribution for more information. */
 /* If you are missing that file, acquire a complete release at teeworlds.com.                */
+#include <engine/server/tick_profiler.h>
 #include <game/collision.h>
 #include <game/server/core/tools/path_finder.h>
 #include "character_bot.h"
@@ -387,7 +388,10 @@ void CCharacterBotAI::ProcessBot()
 	if(!m_pAI->GetTarget()->IsEmpty())
 		m_pAI->GetTarget()->Tick();
 
-	m_pAI->Process();
+	{
+		CTickProfiler::CAccumulateScope Scope(Server()->TickProfiler(), GS()->GetWorldID(), CTickProfiler::PHASE_BOT_AI);
+		m_pAI->Process();
+	}
 
 	if(m_Input.m_Direction)
 	{
@@ -401,7 +405,7 @@ void CCharacterBotAI::ProcessBot()
 void CCharacterBotAI::HandleTuning()
 {
 	m_TuneZoneOverride = -1;
-	CTuningParams* pTuningParams = &m_pBotPlayer->m_NextTuningParams;
+	CTuningParams* pTuningParams = m_pBotPlayer->OverrideTuning(CPlayer::TUNING_LAYER_AI);
 	m_pAI->OnHandleTunning(pTuningParams);
 	HandleIndependentTuning();
 }
@@ -14,18 +14,18 @@ CEntity::CEntity(CGameWorld* pGameWorld, int ObjType, vec2 Pos, int Radius, int
 	m_MarkedForDestroy = false;
 	m_HasPlayersInView = true;
 	m_NextCheckSnappingPriority = ESnappingPriority::High;
-	m_ID = Server()->SnapNewID();
+	m_ID = Server()->SnapNewID(GS()->GetWorldID());
 	m_Pos = Pos;
 	m_PosTo = Pos;
 }
 
 CEntity::~CEntity()
 {
-	Server()->SnapFreeID(m_ID);
+	Server()->SnapFreeID(GS()->GetWorldID(), m_ID);
 	for(auto const& [GroupID, vIds] : m_vGroupIds)
 	{
-		for(const auto& id : vIds)
-			Server()->SnapFreeID(id);
+		if(!vIds.empty())
+			Server()->SnapFreeIDs(GS()->GetWorldID(), vIds.front(), (int)vIds.size());
 	}
 	m_vGroupIds.clear();
 	GameWorld()->RemoveEntity(this);
@@ -107,17 +107,24 @@ CCharacter* CEntity::GetOwnerChar() const
 
 void CEntity::AddSnappingGroupIds(int GroupID, int NumIds)
 {
-	m_vGroupIds[GroupID].resize(NumIds);
-	for(auto& id : m_vGroupIds[GroupID])
-		id = Server()->SnapNewID();
+	auto& vIds = m_vGroupIds[GroupID];
+	if(!vIds.empty())
+		Server()->SnapFreeIDs(GS()->GetWorldID(), vIds.front(), (int)vIds.size());
+
+	// one block, ids follow the first one
+	const int FirstID = Server()->SnapNewIDs(GS()->GetWorldID(), NumIds);
+	vIds.resize(NumIds);
+	for(int i = 0; i < NumIds; i++)
+		vIds[i] = FirstID >= 0 ? FirstID + i : -1;
 }
 
 void CEntity::RemoveSnappingGroupIds(int GroupID)
 {
 	if(m_vGroupIds.contains(GroupID))
 	{
-		for(const auto& id : m_vGroupIds.at(GroupID))
-			Server()->SnapFreeID(id);
+		const auto& vIds = m_vGroupIds.at(GroupID);
+		if(!vIds.empty())
+			Server()->SnapFreeIDs(GS()->GetWorldID(), vIds.front(), (int)vIds.size());
 		m_vGroupIds.erase(GroupID);
 	}
 }
\ No newline at end of file
@@ -16,6 +16,140 @@
 #include "core/components/skills/entities/heart_healer.h"
 #include "core/entities/weapons/rifle_tesla_serpent.h"
 
+// drops of the same kind closer than this are stacked into one entity
+constexpr float DROP_MERGE_RADIUS = 64.0f;
+constexpr int MAX_DROP_MERGE_CANDIDATES = 8;
+
+namespace
+{
+	struct CGravityDisruptionEffect
+	{
+		static constexpr int NUM_SNAP_IDS = 12;
+		struct State
+		{
+			float m_Radius;
+			int m_LifetimeTick;
+			int m_Damage;
+		};
+		using Entity = CEffectEntity<CGravityDisruptionEffect>;
+
+		static void Tick(Entity* pBase)
+		{
+			auto& State = pBase->GetState();
+			const vec2 BasePos = pBase->GetPos();
+
+			// life time
+			if(State.m_LifetimeTick <= 0)
+			{
+				pBase->GS()->CreateCircleExplosion(12, State.m_Radius, BasePos, pBase->GetClientID(), WEAPON_GAME, State.m_Damage);
+				pBase->MarkForDestroy();
+				return;
+			}
+			State.m_LifetimeTick--;
+
+			// magnetism
+			for(auto* pChar = (CCharacter*)pBase->GameWorld()->FindFirst(CGameWorld::ENTTYPE_CHARACTER); pChar; pChar = (CCharacter*)pChar->TypeNext())
+			{
+				const float Dist = distance(BasePos, pChar->m_Core.m_Pos);
+				if(Dist > State.m_Radius || Dist < 24.0f)
+					continue;
+
+				if(!pBase->GetPlayer() || (pBase->GetClientID() != pChar->GetPlayer()->GetCID() && pChar->IsAllowedPVP(pBase->GetClientID())))
+				{
+					vec2 Dir = normalize(pChar->m_Core.m_Pos - BasePos);
+					pChar->AddVelocity(-Dir * 1.5f);
+				}
+			}
+		}
+
+		static void Snap(Entity* pBase, int SnappingClient)
+		{
+			if(pBase->NetworkClipped(SnappingClient))
+				return;
+
+			const vec2 BasePos = pBase->GetPos();
+			pBase->GS()->SnapPickup(SnappingClient, pBase->GetMainSnapID(), BasePos, POWERUP_ARMOR);
+
+			const float Radius = pBase->GetState().m_Radius;
+			const float AngleStep = 2.0f * pi / static_cast<float>(NUM_SNAP_IDS);
+			for(int i = 0; i < pBase->GetNumExtraSnapIDs(); ++i)
+			{
+				float Angle = AngleStep * static_cast<float>(i);
+				vec2 VertexPos = BasePos + vec2(Radius * cos(Angle), Radius * sin(Angle));
+				pBase->GS()->SnapProjectile(SnappingClient, pBase->GetExtraSnapID(i), VertexPos, {}, pBase->Server()->Tick() - 1, WEAPON_HAMMER);
+			}
+		}
+	};
+
+	struct CHealthTurretEffect
+	{
+		static constexpr int NUM_SNAP_IDS = 4;
+		struct State
+		{
+			int m_HealthRestored;
+			int m_LifetimeTick;
+			int m_InitialReloadTick;
+			int m_CurrentReloadTick;
+		};
+		using Entity = CEffectEntity<CHealthTurretEffect>;
+
+		static void Tick(Entity* pBase)
+		{
+			auto& State = pBase->GetState();
+
+			// lifetime
+			if(State.m_LifetimeTick <= 0)
+			{
+				pBase->MarkForDestroy();
+				return;
+			}
+			State.m_LifetimeTick--;
+
+			// reload
+			if(State.m_CurrentReloadTick > 0)
+			{
+				State.m_CurrentReloadTick--;
+				return;
+			}
+			State.m_CurrentReloadTick = State.m_InitialReloadTick;
+
+			// restore health
+			bool ShowRestoreHealth = false;
+			for(auto* pChar = (CCharacter*)pBase->GameWorld()->FindFirst(CGameWorld::ENTTYPE_CHARACTER); pChar; pChar = (CCharacter*)pChar->TypeNext())
+			{
+				const float Distance = distance(pBase->GetPos(), pChar->m_Core.m_Pos);
+				if(Distance < 620.f &&
+					(!pBase->GetPlayer() || (pBase->GetClientID() == pChar->GetPlayer()->GetCID() || !pChar->IsAllowedPVP(pBase->GetClientID()))))
+				{
+					ShowRestoreHealth = true;
+					new CHeartHealer(pBase->GameWorld(), pBase->GetPos(), pChar->GetPlayer(), State.m_HealthRestored, pChar->m_Core.m_Vel / 2.f);
+				}
+			}
+
+			if(ShowRestoreHealth)
+			{
+				pBase->GS()->EntityManager()->Text(pBase->GetPos() + vec2(0, -96), 40, fmt_default("{}HP", State.m_HealthRestored).c_str());
+			}
+		}
+
+		static void Snap(Entity* pBase, int SnappingClient)
+		{
+			if(pBase->NetworkClipped(SnappingClient))
+				return;
+
+			pBase->GS()->SnapPickup(SnappingClient, pBase->GetMainSnapID(), pBase->GetPos(), POWERUP_ARMOR);
+
+			const float Radius = clamp(static_cast<float>(pBase->GetState().m_CurrentReloadTick), 0.0f, 32.0f);
+			const float AngleStep = 2.0f * pi / static_cast<float>(NUM_SNAP_IDS);
+			for(int i = 0; i < pBase->GetNumExtraSnapIDs(); ++i)
+			{
+				const vec2 VertexPos = pBase->GetPos() + vec2(Radius * cos(AngleStep * static_cast<float>(i)), Radius * sin(AngleStep * static_cast<float>(i)));
+				pBase->GS()->SnapPickup(SnappingClient, pBase->GetExtraSnapID(i), VertexPos, POWERUP_HEALTH);
+			}
+		}
+	};
+}
+
 IServer* CEntityManager::Server() const
 {
 	return Instance::Server();
@@ -37,6 +171,16 @@ void CEntityManager::DesignRandomDrop(int Amount, float Force, vec2 Pos, int Lif
 
 void CEntityManager::DropPickup(vec2 Pos, int Type, int Subtype, int Value, int NumDrop, vec2 Force) const
 {
+	// stack onto a pickup of the same kind lying close by
+	CEntity* apEnts[MAX_DROP_MERGE_CANDIDATES];
+	const int Num = GS()->m_World.FindEntities(Pos, DROP_MERGE_RADIUS, apEnts, MAX_DROP_MERGE_CANDIDATES, CGameWorld::ENTTYPE_PICKUP);
+	for(int i = 0; i < Num; i++)
+	{
+		auto* pPickup = dynamic_cast<CEntityDropPickup*>(apEnts[i]);
+		if(pPickup && pPickup->TryMerge(Type, Subtype, Value * NumDrop))
+			return;
+	}
+
 	for(int i = 0; i < NumDrop; i++)
 	{
 		vec2 Vel = Force;
@@ -48,11 +192,23 @@ void CEntityManager::DropPickup(vec2 Pos, int Type, int Subtype, int Value, int
 
 void CEntityManager::DropItem(vec2 Pos, int ClientID, const CItem& Item, vec2 Force) const
 {
-	if(Item.IsValid())
+	if(!Item.IsValid())
+		return;
+
+	// stack onto the same item of the same owner lying close by
+	if(Item.Info()->IsStackable())
 	{
-		const float Angle = angle(normalize(Force));
-		new CEntityDropItem(&GS()->m_World, Pos, Force, Angle, Item, ClientID);
+		CEntity* apEnts[MAX_DROP_MERGE_CANDIDATES];
+		const int Num = GS()->m_World.FindEntities(Pos, DROP_MERGE_RADIUS, apEnts, MAX_DROP_MERGE_CANDIDATES, CGameWorld::ENTTYPE_PICKUP_ITEM);
+		for(int i = 0; i < Num; i++)
+		{
+			if(static_cast<CEntityDropItem*>(apEnts[i])->TryMerge(ClientID, Item))
+				return;
+		}
 	}
+
+	const float Angle = angle(normalize(Force));
+	new CEntityDropItem(&GS()->m_World, Pos, Force, Angle, Item, ClientID);
 }
 
 void CEntityManager::RandomDropItem(vec2 Pos, int ClientID, float Chance, const CItem& Item, vec2 Force) const
@@ -125,61 +281,8 @@ void CEntityManager::LaserOrbit(CEntityLaserOrbit*& pOut, CEntity* pParent, int
 
 void CEntityManager::GravityDisruption(int ClientID, vec2 Position, float Radius, int Lifetime, int Damage, EntGroupWeakPtr* pPtr) const
 {
-	// initialize group & config
 	auto groupPtr = CEntityGroup::NewGroup(&GS()->m_World, CGameWorld::ENTTYPE_SKILL, ClientID);
-	groupPtr->SetConfig("radius", Radius);
-
-	// initialize element & config
-	auto pPickup = groupPtr->CreatePickup(Position, POWERUP_ARMOR);
-	pPickup->SetConfig("lifetimeTick", Lifetime);
-	pPickup->SetConfig("damage", Damage);
-
-	// register event tick
-	pPickup->RegisterEvent(CBaseEntity::EventTick, [](CBaseEntity* pBase)
-	{
-		int& LifeTime = pBase->GetRefConfig("lifetimeTick", 0);
-		const int Damage = pBase->GetConfig("damage", 0);
-		const float Radius = pBase->GetGroup()->GetConfig("radius", 0.f);
-		const vec2 BasePos = pBase->GetPos();
-
-		// life time
-		if(LifeTime <= 0)
-		{
-			pBase->GS()->CreateCircleExplosion(12, Radius, BasePos, pBase->GetClientID(), WEAPON_GAME, Damage);
-			pBase->MarkForDestroy();
-			return;
-		}
-		LifeTime--;
-
-		// magnetism
-		for(auto* pChar = (CCharacter*)pBase->GameWorld()->FindFirst(CGameWorld::ENTTYPE_CHARACTER); pChar; pChar = (CCharacter*)pChar->TypeNext())
-		{
-			const float Dist = distance(BasePos, pChar->m_Core.m_Pos);
-			if(Dist > Radius || Dist < 24.0f)
-				continue;
-
-			if(!pBase->GetPlayer() || (pBase->GetClientID() != pChar->GetPlayer()->GetCID() && pChar->IsAllowedPVP(pBase->GetClientID())))
-			{
-				vec2 Dir = normalize(pChar->m_Core.m_Pos - BasePos);
-				pChar->AddVelocity(-Dir * 1.5f);
-			}
-		}
-	});
-
-	// register event snap
-	pPickup->RegisterEvent(CBaseEntity::EventSnap, 12, [](CBaseEntity* pBase, int SnappingClient, const std::vector<int>& vIds)
-	{
-		const float Radius = pBase->GetGroup()->GetConfig("radius", 0.f);
-		const float AngleStep = 2.0f * pi / static_cast<float>(vIds.size());
-		const vec2 BasePos = pBase->GetPos();
-
-		for(size_t i = 0; i < vIds.size(); ++i)
-		{
-			float Angle = AngleStep * static_cast<float>(i);
-			vec2 VertexPos = BasePos + vec2(Radius * cos(Angle), Radius * sin(Angle));
-			pBase->GS()->SnapProjectile(SnappingClient, vIds[i], VertexPos, {}, pBase->Server()->Tick() - 1, WEAPON_HAMMER);
-		}
-	});
+	groupPtr->CreateEffect<CGravityDisruptionEffect>(Position, { Radius, Lifetime, Damage });
 
 	if(pPtr)
 		*pPtr = groupPtr;
@@ -187,72 +290,8 @@ void CEntityManager::GravityDisruption(int ClientID, vec2 Position, float Radius
 
 void CEntityManager::HealthTurret(int ClientID, vec2 Position, int RestoreHealth, int Lifetime, int InitialReloadTick, EntGroupWeakPtr* pPtr) const
 {
-	// initialize group & config
 	auto groupPtr = CEntityGroup::NewGroup(&GS()->m_World, CGameWorld::ENTTYPE_SKILL, ClientID);
-	groupPtr->SetConfig("healthRestored", RestoreHealth);
-
-	// initialize element & config
-	auto* pPickup = groupPtr->CreatePickup(Position, POWERUP_ARMOR);
-	pPickup->SetConfig("initialReloadTick", InitialReloadTick);
-	pPickup->SetConfig("lifetimeTick", Lifetime);
-	pPickup->SetConfig("currentReloadTick", InitialReloadTick);
-
-	// register event tick
-	pPickup->RegisterEvent(CBaseEntity::EventTick, [](CBaseEntity* pBase)
-	{
-		// lifetime
-		int& Lifetime = pBase->GetRefConfig("lifetimeTick", 0);
-		if(Lifetime <= 0)
-		{
-			pBase->MarkForDestroy();
-			return;
-		}
-		Lifetime--;
-
-		// reload
-		int& ReloadTick = pBase->GetRefConfig("currentReloadTick", 0);
-		if(ReloadTick > 0)
-		{
-			ReloadTick--;
-			return;
-		}
-		ReloadTick = pBase->GetConfig("initialReloadTick", 2 * pBase->Server()->TickSpeed());
-
-		// variables
-		bool ShowRestoreHealth = false;
-		const int HealthRestored = pBase->GetGroup()->GetConfig("healthRestored", 0);
-
-		// restore health
-		for(auto* pChar = (CCharacter*)pBase->GameWorld()->FindFirst(CGameWorld::ENTTYPE_CHARACTER); pChar; pChar = (CCharacter*)pChar->TypeNext())
-		{
-			const float Distance = distance(pBase->GetPos(), pChar->m_Core.m_Pos);
-			if(Distance < 620.f &&
-				(!pBase->GetPlayer() || (pBase->GetClientID() == pChar->GetPlayer()->GetCID() || !pChar->IsAllowedPVP(pBase->GetClientID()))))
-			{
-				ShowRestoreHealth = true;
-				new CHeartHealer(pBase->GameWorld(), pBase->GetPos(), pChar->GetPlayer(), HealthRestored, pChar->m_Core.m_Vel / 2.f);
-			}
-		}
-
-		if(ShowRestoreHealth)
-		{
-			pBase->GS()->EntityManager()->Text(pBase->GetPos() + vec2(0, -96), 40, fmt_default("{}HP", HealthRestored).c_str());
-		}
-	});
-
-	// register event snap
-	pPickup->RegisterEvent(CBaseEntity::EventSnap, 4, [](CBaseEntity* pBase, int SnappingClient, const std::vector<int>& vIds)
-	{
-		const int ReloadTick = pBase->GetConfig("currentReloadTick", 0);
-		const float Radius = clamp(static_cast<float>(ReloadTick), 0.0f, 32.0f);
-		const float AngleStep = 2.0f * pi / static_cast<float>(vIds.size());
-
-		for(size_t i = 0; i < vIds.size(); ++i)
-		{
-			const vec2 VertexPos = pBase->GetPos() + vec2(Radius * cos(AngleStep * static_cast<float>(i)), Radius * sin(AngleStep * static_cast<float>(i)));
-			pBase->GS()->SnapPickup(SnappingClient, vIds[i], VertexPos, POWERUP_HEALTH);
-		}
-	});
+	groupPtr->CreateEffect<CHealthTurretEffect>(Position, { RestoreHealth, Lifetime, InitialReloadTick, InitialReloadTick });
 
 	if(pPtr)
 		*pPtr = groupPtr;
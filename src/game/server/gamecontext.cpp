@@ -49,6 +49,9 @@ CGS::CGS()
 	m_pScenarioPlayerManager = nullptr;
 	m_pScenarioGroupManager = nullptr;
 	m_pScenarioWorldManager = nullptr;
+	m_IdleTicks = 0;
+	m_HibernateTick = 0;
+	m_Hibernated = false;
 	mem_zero(m_apPlayers, sizeof(m_apPlayers));
 	mem_zero(m_aBroadcastStates, sizeof(m_aBroadcastStates));
 }
@@ -707,6 +710,8 @@ void CGS::OnInit(int WorldID)
 	m_World.SetGameServer(this);
 	m_Events.SetGameServer(this);
 	m_WorldID = WorldID;
+	m_IdleTicks = 0;
+	m_Hibernated = false;
 
 	for(int i = 0; i < NUM_NETOBJTYPES; i++)
 		Server()->SnapSetStaticsize(i, m_NetObjHandler.GetObjSize(i));
@@ -735,7 +740,7 @@ void CGS::OnInit(int WorldID)
 
 	// initialize
 	m_pCommandProcessor = new CCommandProcessor(this);
-	m_pPathFinder = new CPathFinder(&m_Collision);
+	m_pPathFinder = new CPathFinder(&m_Collision, Server()->TickProfiler(), m_WorldID);
 	m_pScenarioPlayerManager = new CScenarioPlayerManager(this);
 	m_pScenarioGroupManager = new CScenarioGroupManager(this);
 	m_pScenarioWorldManager = new CScenarioWorldManager(this);
@@ -769,6 +774,12 @@ void CGS::OnDaytypeChange(int NewDaytype)
 
 void CGS::OnTick()
 {
+	if(UpdateHibernation())
+	{
+		TickHibernated();
+		return;
+	}
+
 	m_World.m_Core.m_Tuning = m_Tuning;
 	m_World.Tick();
 	m_pController->Tick();
@@ -805,6 +816,60 @@ void CGS::OnTick()
 	ScenarioWorldManager()->UpdateScenarios();
 }
 
+bool CGS::UpdateHibernation()
+{
+	// the main world also runs the work shared by all worlds
+	if(m_WorldID == INITIALIZER_WORLD_ID || !g_Config.m_SvHibernateDelay)
+	{
+		WakeUp();
+		return false;
+	}
+
+	for(int ClientID = 0; ClientID < MAX_PLAYERS; ++ClientID)
+	{
+		if(Server()->ClientIngame(ClientID) && IsPlayerInWorld(ClientID))
+		{
+			WakeUp();
+			return false;
+		}
+	}
+
+	if(m_Hibernated)
+		return true;
+
+	// give the world time to finish what players left behind (dungeon resets etc.)
+	if(++m_IdleTicks < g_Config.m_SvHibernateDelay * Server()->TickSpeed())
+		return false;
+
+	m_Hibernated = true;
+	m_HibernateTick = Server()->Tick();
+	dbg_msg("world", "%s hibernated", Server()->GetWorldName(m_WorldID));
+	return true;
+}
+
+void CGS::TickHibernated()
+{
+	const int TickRate = g_Config.m_SvHibernateTickRate;
+	if(!TickRate || Server()->Tick() % maximum(Server()->TickSpeed() / TickRate, 1) != 0)
+		return;
+
+	// bots, the world mode and scenarios stay suspended, so no path finder work is requested
+	m_World.TickHibernated();
+	Core()->OnTick();
+	m_Events.Clear();
+}
+
+void CGS::WakeUp()
+{
+	m_IdleTicks = 0;
+	if(!m_Hibernated)
+		return;
+
+	// timers are absolute ticks, everything that expired while sleeping fires on the next tick
+	m_Hibernated = false;
+	dbg_msg("world", "%s woke up after %d ticks", Server()->GetWorldName(m_WorldID), Server()->Tick() - m_HibernateTick);
+}
+
 void CGS::OnTickGlobal()
 {
 	// send chat messages with interval
@@ -1282,6 +1347,7 @@ void CGS::OnClientConnected(int ClientID)
 
 	Server()->SendMotd(ClientID, g_Config.m_SvMotd);
 	m_aBroadcastStates[ClientID] = {};
+	WakeUp();
 }
 
 void CGS::OnClientEnter(int ClientID, bool FirstEnter)
@@ -1290,6 +1356,7 @@ void CGS::OnClientEnter(int ClientID, bool FirstEnter)
 	if(!pPlayer || pPlayer->IsBot())
 		return;
 
+	WakeUp();
 	m_pController->OnPlayerConnect(pPlayer);
 	m_pCommandProcessor->SendClientCommandsInfo(this, ClientID);
 
@@ -1367,6 +1434,23 @@ void CGS::OnClientPredictedInput(int ClientID, void* pInput)
 	m_apPlayers[ClientID]->OnPredictedInput((CNetObj_PlayerInput*)pInput);
 }
 
+bool CGS::IsClientMessageRecordable(int MsgID, CUnpacker* pUnpacker, int ClientID)
+{
+	if(MsgID != NETMSGTYPE_CL_SAY)
+		return true;
+
+	// chat commands and motd field edits can carry credentials, logins are recorded separately
+	CUnpacker Unpacker = *pUnpacker;
+	const auto pMsg = (CNetMsg_Cl_Say*)m_NetObjHandler.SecureUnpackMsg(MsgID, &Unpacker);
+	const CPlayer* pPlayer = GetPlayer(ClientID);
+	return pMsg && pMsg->m_pMessage[0] != '/' && (!pPlayer || !pPlayer->m_pMotdMenu);
+}
+
+void CGS::OnClientReplayLogin(int ClientID, int AccountID)
+{
+	Core()->AccountManager()->LoginAccountByID(ClientID, AccountID);
+}
+
 void CGS::OnUpdateClientServerInfo(nlohmann::json* pJson, int ClientID)
 {
 	CPlayer* pPlayer = GetPlayer(ClientID);
@@ -1414,6 +1498,10 @@ void CGS::OnClientPrepareChangeWorld(int ClientID)
 	const int AllocMemoryCell = ClientID + m_WorldID * MAX_CLIENTS;
 	m_apPlayers[ClientID] = new(AllocMemoryCell) CPlayer(this, ClientID);
 	Core()->QuestManager()->Update(m_apPlayers[ClientID]);
+
+	// the world must be running before the player finished loading
+	if(IsPlayerInWorld(ClientID))
+		WakeUp();
 }
 
 bool CGS::IsClientReady(int ClientID) const
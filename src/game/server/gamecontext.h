@@ -49,6 +49,9 @@ class CGS : public IGameServer
 	bool m_AllowedPVP;
 	vec2 m_JailPosition;
 	int m_WorldID;
+	int m_IdleTicks;
+	int m_HibernateTick;
+	bool m_Hibernated;
 
 public:
 	IServer *Server() const { return m_pServer; }
@@ -125,9 +128,12 @@ public:
 	void OnClientDrop(int ClientID, const char *pReason) override;
 	void OnClientDirectInput(int ClientID, void *pInput) override;
 	void OnClientPredictedInput(int ClientID, void *pInput) override;
+	bool IsClientMessageRecordable(int MsgID, CUnpacker *pUnpacker, int ClientID) override;
+	void OnClientReplayLogin(int ClientID, int AccountID) override;
 	void OnUpdateClientServerInfo(nlohmann::json* pJson, int ClientID) override;
 	bool IsClientReady(int ClientID) const override;
 	bool IsClientPlayer(int ClientID) const override;
+	bool IsHibernated() const override { return m_Hibernated; }
 	bool IsClientCharacterExist(int ClientID) const override;
 	bool IsClientMRPG(int ClientID) const;
 	bool PlayerExists(int ClientID) const override { return m_apPlayers[ClientID]; }
@@ -161,6 +167,9 @@ private:
 	void ProcessNicknameChange(CPlayer* pPlayer, const char* pNewNickname) const;
 	void UpdateWorldMultipliers();
 	void ResetWorldMultipliers();
+	bool UpdateHibernation();
+	void TickHibernated();
+	void WakeUp();
 
 public:
 	template<typename... Ts> void Chat(int ClientID, const char* pText, const Ts&... args);
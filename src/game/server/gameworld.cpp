@@ -206,6 +206,25 @@ void CGameWorld::Tick()
 	UpdatePlayerMaps();
 }
 
+void CGameWorld::TickHibernated()
+{
+	// characters are skipped, so bots stay where they are
+	for(int i = 0; i < NUM_ENTTYPES; i++)
+	{
+		if(i == ENTTYPE_CHARACTER)
+			continue;
+
+		for(CEntity* pEnt = m_apFirstEntityTypes[i]; pEnt; )
+		{
+			m_pNextTraverseEntity = pEnt->m_pNextTypeEntity;
+			pEnt->Tick();
+			pEnt = m_pNextTraverseEntity;
+		}
+	}
+
+	RemoveEntities();
+}
+
 
 // TODO: should be more general
 CCharacter* CGameWorld::IntersectCharacter(vec2 Pos0, vec2 Pos1, float Radius, vec2& NewPos, CEntity* pNotThis)
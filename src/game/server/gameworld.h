@@ -89,6 +89,7 @@ public:
 	void Snap(int SnappingClient);
 	void PostSnap();
 	void Tick();
+	void TickHibernated();
 
 private:
 	void RemoveEntities();
@@ -46,8 +46,8 @@ CPlayer::CPlayer(CGS* pGS, int ClientID) : m_pGS(pGS), m_ClientID(ClientID)
 	m_LastInputInit = false;
 	m_LastPlaytime = 0;
 	m_MoodState = Mood::Normal;
-	m_PrevTuningParams = *pGS->Tuning();
-	m_NextTuningParams = m_PrevTuningParams;
+	m_SentTuningParams = *pGS->Tuning();
+	m_NextTuningParams = m_SentTuningParams;
 	m_Cooldown.Init(ClientID);
 	m_VotesData.Init(m_pGS, this);
 	m_Dialog.Init(this);
@@ -335,19 +335,34 @@ void CPlayer::HandlePeriodicActivityReward()
 
 void CPlayer::HandleTuningParams()
 {
-	if(!(m_PrevTuningParams == m_NextTuningParams))
+	// the same layers give the same params, so only a change of layers can change what the client has
+	if(m_TuningLayers != m_SentTuningLayers)
 	{
-		CMsgPacker Msg(NETMSGTYPE_SV_TUNEPARAMS);
-		const int* pParams = reinterpret_cast<int*>(&m_NextTuningParams);
-		for(unsigned i = 0; i < sizeof(m_NextTuningParams) / sizeof(int); i++)
+		m_SentTuningLayers = m_TuningLayers;
+		if(!(m_SentTuningParams == m_NextTuningParams))
 		{
-			Msg.AddInt(pParams[i]);
+			CMsgPacker Msg(NETMSGTYPE_SV_TUNEPARAMS);
+			const int* pParams = reinterpret_cast<int*>(&m_NextTuningParams);
+			for(unsigned i = 0; i < sizeof(m_NextTuningParams) / sizeof(int); i++)
+			{
+				Msg.AddInt(pParams[i]);
+			}
+			Server()->SendMsg(&Msg, MSGFLAG_VITAL, m_ClientID);
+			m_SentTuningParams = m_NextTuningParams;
 		}
-		Server()->SendMsg(&Msg, MSGFLAG_VITAL, m_ClientID);
-		m_PrevTuningParams = m_NextTuningParams;
 	}
 
-	m_NextTuningParams = *GS()->Tuning();
+	ResetTuningParams();
+}
+
+void CPlayer::ResetTuningParams()
+{
+	// without overrides the params are still the world tuning
+	if(m_TuningLayers)
+	{
+		m_NextTuningParams = *GS()->Tuning();
+		m_TuningLayers = 0;
+	}
 }
 
 void CPlayer::Snap(int SnappingClient)
@@ -689,9 +704,31 @@ void CPlayer::UpdateSharedCharacterData(int Health, int Mana)
 	TempData.m_Mana = Mana;
 }
 
-int CPlayer::GetTotalAttributeValue(AttributeIdentifier AttributeID) const
+void CPlayer::UpdateTotalAttributeValue(AttributeIdentifier AttributeID, int Value)
+{
+	const int Index = (int)AttributeID;
+	if(Index < 0 || Index >= (int)AttributeIdentifier::ATTRIBUTES_NUM || m_DerivedStats.m_aAttributes[Index] == Value)
+		return;
+
+	m_DerivedStats.m_aAttributes[Index] = Value;
+	m_DerivedStats.m_Version++;
+}
+
+void CPlayer::UpdateDerivedPools() const
 {
-	return m_aStats.contains(AttributeID) ? m_aStats.at(AttributeID) : 0;
+	const auto& BonusManager = Account()->GetBonusManager();
+	if(m_DerivedStats.m_PoolsVersion == m_DerivedStats.m_Version && m_DerivedStats.m_PoolsBonusVersion == BonusManager.GetVersion())
+		return;
+
+	auto MaxHP = Balance::Get().GetAttributeBase(AttributeIdentifier::HP) + GetTotalAttributeValue(AttributeIdentifier::HP);
+	BonusManager.ApplyBonuses(BONUS_TYPE_HP, &MaxHP);
+	auto MaxMP = Balance::Get().GetAttributeBase(AttributeIdentifier::MP) + GetTotalAttributeValue(AttributeIdentifier::MP);
+	BonusManager.ApplyBonuses(BONUS_TYPE_MP, &MaxMP);
+
+	m_DerivedStats.m_MaxHealth = MaxHP;
+	m_DerivedStats.m_MaxMana = MaxMP;
+	m_DerivedStats.m_PoolsVersion = m_DerivedStats.m_Version;
+	m_DerivedStats.m_PoolsBonusVersion = BonusManager.GetVersion();
 }
 
 bool CPlayer::IsAuthed() const
@@ -703,16 +740,14 @@ bool CPlayer::IsAuthed() const
 
 int CPlayer::GetMaxHealth() const
 {
-	auto DefaultHP = Balance::Get().GetAttributeBase(AttributeIdentifier::HP) + GetTotalAttributeValue(AttributeIdentifier::HP);
-	Account()->GetBonusManager().ApplyBonuses(BONUS_TYPE_HP, &DefaultHP);
-	return DefaultHP;
+	UpdateDerivedPools();
+	return m_DerivedStats.m_MaxHealth;
 }
 
 int CPlayer::GetMaxMana() const
 {
-	auto DefaultMP = Balance::Get().GetAttributeBase(AttributeIdentifier::MP) + GetTotalAttributeValue(AttributeIdentifier::MP);
-	Account()->GetBonusManager().ApplyBonuses(BONUS_TYPE_MP, &DefaultMP);
-	return DefaultMP;
+	UpdateDerivedPools();
+	return m_DerivedStats.m_MaxMana;
 }
 
 int64_t CPlayer::GetAfkTime() const
@@ -1034,30 +1069,12 @@ const CTeeInfo& CPlayer::GetTeeInfo() const
 
 void CPlayer::StartUniversalScenario(const std::string& ScenarioData, ScenarioBlock Block) const
 {
-	nlohmann::json JsonData;
-	mystd::json::parse(ScenarioData, [&Block, &JsonData](const nlohmann::json& Json)
-	{
-		if(Block.empty())
-			JsonData = Json;
-		else if(const auto It = Json.find(Block); It != Json.end() && !It->is_null())
-			JsonData = *It;
-	});
-
-	if(!JsonData.is_null() && !JsonData.empty())
-		GS()->ScenarioPlayerManager()->RegisterScenario<CUniversalScenario>(m_ClientID, JsonData);
+	if(auto pGraph = ScenarioGraph::Get(ScenarioData, Block))
+		GS()->ScenarioPlayerManager()->RegisterScenario<CUniversalScenario>(m_ClientID, pGraph);
 }
 
 void CPlayer::StartWorldScenario(const std::string& ScenarioData, ScenarioBlock Block, int WorldID, int Single, int DurationSeconds) const
 {
-	nlohmann::json JsonData;
-	mystd::json::parse(ScenarioData, [&](const nlohmann::json& Json)
-	{
-		if(Block.empty())
-			JsonData = Json;
-		else if(const auto It = Json.find(Block); It != Json.end() && !It->is_null())
-			JsonData = *It;
-	});
-
-	if(!JsonData.is_null() && !JsonData.empty())
-		GS()->ScenarioWorldManager()->RegisterScenario<CWorldScenario>(WorldID, m_ClientID, Single, DurationSeconds, JsonData);
+	if(auto pGraph = ScenarioGraph::Get(ScenarioData, Block))
+		GS()->ScenarioWorldManager()->RegisterScenario<CWorldScenario>(WorldID, m_ClientID, Single, DurationSeconds, pGraph);
 }
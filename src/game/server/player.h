@@ -50,7 +50,20 @@ protected:
 	bool m_LastInputInit {};
 	int64_t m_LastPlaytime {};
 	FixedViewCam m_FixedView {};
-	std::map<AttributeIdentifier, int> m_aStats {};
+
+	// attribute totals and the values derived from them, the totals are pushed by the
+	// inventory listener and max health and mana follow the attribute and bonus versions
+	struct CDerivedStats
+	{
+		std::array<int, (size_t)AttributeIdentifier::ATTRIBUTES_NUM> m_aAttributes {};
+		uint32_t m_Version {};
+		uint32_t m_PoolsVersion { ~0u };
+		uint32_t m_PoolsBonusVersion { ~0u };
+		int m_MaxHealth {};
+		int m_MaxMana {};
+	};
+	mutable CDerivedStats m_DerivedStats {};
+	void UpdateDerivedPools() const;
 
 public:
 	CGS* GS() const { return m_pGS; }
@@ -100,8 +113,27 @@ public:
 	CMotdPlayerData m_MotdData {};
 	CPlayerDialog m_Dialog;
 	CEffectManager m_Effects {};
-	CTuningParams m_PrevTuningParams;
+
+	// tuning overrides on top of the world tuning, a layer always sets the same values
+	enum
+	{
+		TUNING_LAYER_MOVING_DISABLED = 1 << 0,
+		TUNING_LAYER_WATER = 1 << 1,
+		TUNING_LAYER_AFLOAT = 1 << 2,
+		TUNING_LAYER_SLOWNESS = 1 << 3,
+		TUNING_LAYER_STUN = 1 << 4,
+		TUNING_LAYER_HOOK_BLOCKED = 1 << 5,
+		TUNING_LAYER_AI = 1 << 6,
+	};
+	CTuningParams m_SentTuningParams;
 	CTuningParams m_NextTuningParams;
+	int m_TuningLayers {};
+	int m_SentTuningLayers {};
+	CTuningParams* OverrideTuning(int Layer)
+	{
+		m_TuningLayers |= Layer;
+		return &m_NextTuningParams;
+	}
 
 	bool m_WantSpawn;
 	bool m_ActivatedGroupColour;
@@ -132,6 +164,7 @@ public:
 	virtual	int GetMana() const { return GetSharedData().m_Mana; }
 
 	virtual void HandleTuningParams();
+	void ResetTuningParams();
 	virtual int64_t GetMaskVisibleForClients() const { return -1; }
 	virtual ESnappingPriority IsActiveForClient(int ClientID) const { return ESnappingPriority::High; }
 	virtual std::optional<int> GetEquippedSlotItemID(ItemType EquipID) const;
@@ -140,8 +173,12 @@ public:
 	std::optional<float> GetTotalAttributeChance(AttributeIdentifier ID) const;
 	virtual void UpdateSharedCharacterData(int Health, int Mana);
 
-	int GetTotalAttributeValue(AttributeIdentifier AttributeID) const;
-	void UpdateTotalAttributeValue(AttributeIdentifier AttributeID, int Value) { m_aStats[AttributeID] = Value; }
+	int GetTotalAttributeValue(AttributeIdentifier AttributeID) const
+	{
+		const int Index = (int)AttributeID;
+		return Index >= 0 && Index < (int)AttributeIdentifier::ATTRIBUTES_NUM ? m_DerivedStats.m_aAttributes[Index] : 0;
+	}
+	void UpdateTotalAttributeValue(AttributeIdentifier AttributeID, int Value);
 	void FormatBroadcastBasicStats(char* pBuffer, int Size, const char* pAppendStr = "\0") const;
 
 	bool IsGuestLogin() const { return !GetSharedData().m_GuestLogin.empty(); }
@@ -395,10 +395,8 @@ ESnappingPriority CPlayerBot::IsActiveForClient(int ClientID) const
 
 void CPlayerBot::HandleTuningParams()
 {
-	if(!(m_PrevTuningParams == m_NextTuningParams))
-		m_PrevTuningParams = m_NextTuningParams;
-
-	m_NextTuningParams = *GS()->Tuning();
+	// bots have no client to update
+	ResetTuningParams();
 }
 
 void CPlayerBot::Snap(int SnappingClient)
@@ -36,7 +36,7 @@ CRhythmField::~CRhythmField()
 	m_vArrows.clear();
 
 	if(m_HitLineLaserId >= 0)
-		Server()->SnapFreeID(m_HitLineLaserId);
+		Server()->SnapFreeID(GS()->GetWorldID(), m_HitLineLaserId);
 }
 
 void CRhythmField::Reset()
@@ -93,7 +93,7 @@ void CRhythmField::SetHitZone(vec2 Pos)
 void CRhythmField::EnsureSnapIds()
 {
 	if(m_HitLineLaserId < 0)
-		m_HitLineLaserId = Server()->SnapNewID();
+		m_HitLineLaserId = Server()->SnapNewID(GS()->GetWorldID());
 }
 
 void CRhythmField::RegisterArrow(CRhythmArrow *pArrow)
@@ -23,7 +23,7 @@ void CGameControllerTutorial::OnInit()
 	const std::string jsonRawData = (char*)RawData.data();
 	bool hasError = mystd::json::parse(jsonRawData, [this](nlohmann::json& j)
 	{
-		m_JsonTutorialData = std::move(j);
+		m_pTutorialGraph = ScenarioGraph::Compile(j);
 	});
 
 	dbg_assert(!hasError, "scenario-tutorial: invalid JSON file.");
@@ -37,8 +37,8 @@ void CGameControllerTutorial::Tick()
 bool CGameControllerTutorial::OnCharacterSpawn(CCharacter* pChr)
 {
 	// start tutorial scenario
-	if(pChr->GetPlayer()->IsAuthed())
-		pChr->GetPlayer()->StartUniversalScenario(m_JsonTutorialData.dump(), {});
+	if(pChr->GetPlayer()->IsAuthed() && m_pTutorialGraph)
+		GS()->ScenarioPlayerManager()->RegisterScenario<CUniversalScenario>(pChr->GetPlayer()->GetCID(), m_pTutorialGraph);
 	return CGameControllerDefault::OnCharacterSpawn(pChr);
 }
 
@@ -5,9 +5,11 @@
 
 #include "default.h"
 
+#include <scenarios/base/scenario_graph.h>
+
 class CGameControllerTutorial : public CGameControllerDefault
 {
-	nlohmann::json m_JsonTutorialData{};
+	ScenarioGraphPtr m_pTutorialGraph {};
 
 public:
 	CGameControllerTutorial(class CGS* pGameServer);
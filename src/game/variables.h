@@ -227,6 +227,10 @@ MACRO_CONFIG_INT(SvMySqlPort, sv_sql_port, 3306, 0, 65000, CFGFLAG_SERVER, "MySQ
 MACRO_CONFIG_INT(SvMySqlPoolSize, sv_sql_pool_size, 3, 2, 12, CFGFLAG_SERVER, "MySQL Pool size");
 MACRO_CONFIG_INT(SvMySqlUseTls, sv_sql_use_tls, 0, 0, 1, CFGFLAG_SERVER, "Enable TLS/SSL for MySQL connection (0 = off, 1 = on)")
 
+// sqlite
+MACRO_CONFIG_STR(SvSqliteFile, sv_sqlite_file, 128, "", CFGFLAG_SERVER, "Use an embedded SQLite database file instead of MySQL (empty = MySQL)")
+MACRO_CONFIG_STR(SvSqliteSchema, sv_sqlite_schema, 128, "mmprpg_clean.sql", CFGFLAG_SERVER, "MySQL dump used to create a new SQLite database")
+
 // mysql retry and timeout tuning
 MACRO_CONFIG_INT(SvSqlSelectMaxRetries, sv_sql_select_max_retries, 3, 0, 10, CFGFLAG_SERVER, "MySQL max retries for SELECT tasks")
 MACRO_CONFIG_INT(SvSqlDmlMaxRetries, sv_sql_dml_max_retries, 1, 0, 10, CFGFLAG_SERVER, "MySQL max retries for INSERT/UPDATE/DELETE tasks")
@@ -240,6 +244,7 @@ MACRO_CONFIG_INT(SvSqlQueueWaitWarnMs, sv_sql_queue_wait_warn_ms, 200, 1, 10000,
 MACRO_CONFIG_INT(SvSqlQueueWarnSize, sv_sql_queue_warn_size, 50, 1, 10000, CFGFLAG_SERVER, "MySQL queue size warning threshold")
 MACRO_CONFIG_INT(SvSqlQueueMaxSize, sv_sql_queue_max_size, 500, 1, 100000, CFGFLAG_SERVER, "MySQL queue max size (enqueue waits when reached)")
 MACRO_CONFIG_STR(SvSqlFailedLogFile, sv_sql_failed_log_file, 128, "sql_failed_log.txt", CFGFLAG_SERVER, "Filename to log failed SQL queries")
+MACRO_CONFIG_INT(SvSqlIdBlockSize, sv_sql_id_block_size, 32, 2, 10000, CFGFLAG_SERVER, "Number of IDs reserved per table from the sequence table at once")
 
 
 // settings
@@ -250,6 +255,8 @@ MACRO_CONFIG_INT(ClNotifyWindow, cl_notify_window, 1, 0, 1, CFGFLAG_CLIENT | CFG
 MACRO_CONFIG_INT(ClInactiveRendering, cl_inactive_rendering, 1, 0, 2, CFGFLAG_CLIENT, "0 = Always render, 1 = Stop rendering when minimized, 2 = Stop rendering when window is inactive")
 MACRO_CONFIG_INT(SvMapDistanceActveBot, sv_map_distance_active_bot, 1000, 400, 10000, CFGFLAG_SERVER, "max distance for active bot")
 MACRO_CONFIG_INT(SvMapUpdateRate, sv_mapupdaterate, 5, 1, 100, CFGFLAG_SERVER, "64 player id <-> vanilla id players map update rate")
+MACRO_CONFIG_INT(SvHibernateDelay, sv_hibernate_delay, 30, 0, 3600, CFGFLAG_SERVER, "Seconds a world without players keeps ticking before it hibernates (0 = never hibernate)")
+MACRO_CONFIG_INT(SvHibernateTickRate, sv_hibernate_tick_rate, 0, 0, 50, CFGFLAG_SERVER, "Ticks per second of a hibernated world, bots stay suspended (0 = frozen)")
 MACRO_CONFIG_INT(SvJoinFloodTime, sv_join_flood_time, 8, 0, 60, CFGFLAG_SERVER, "Time window (seconds) used to detect join floods by IP subnet (0 to disable)")
 MACRO_CONFIG_INT(SvJoinFloodSubnetLimit, sv_join_flood_subnet_limit, 6, 0, 64, CFGFLAG_SERVER, "Maximum joins allowed per subnet in sv_join_flood_time before client is kicked (0 to disable)")
 
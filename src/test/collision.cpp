@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <benchmark/synthetic_map.h>
+
+#include <vector>
+
+namespace
+{
+	constexpr int MAP_WIDTH = 40;
+	constexpr int MAP_HEIGHT = 30;
+
+	// the tiles the old HandleTiles sampled, one point per pixel of the move
+	std::vector<int> SampledTiles(const CCollision &Collision, vec2 PrevPos, vec2 Pos)
+	{
+		std::vector<int> vIndices;
+		const float d = distance(PrevPos, Pos);
+		const int End(d + 1);
+		for(int i = 0; i < End; i++)
+		{
+			const vec2 Tmp = d > 0 ? mix(PrevPos, Pos, i / d) : Pos;
+			const int Nx = clamp((int)Tmp.x / 32, 0, Collision.GetWidth() - 1);
+			const int Ny = clamp((int)Tmp.y / 32, 0, Collision.GetHeight() - 1);
+			const int Index = Ny * Collision.GetWidth() + Nx;
+			if((vIndices.empty() || vIndices.back() != Index) && Collision.IsSpecialTile(Index))
+				vIndices.push_back(Index);
+		}
+		return vIndices;
+	}
+
+	std::vector<int> SweptTiles(const CCollision &Collision, vec2 PrevPos, vec2 Pos)
+	{
+		std::vector<int> vIndices;
+		Collision.ForEachSpecialTile(PrevPos, Pos, [&vIndices](int Index) {
+			vIndices.push_back(Index);
+			return true;
+		});
+		return vIndices;
+	}
+
+	// every sampled tile is swept, in the same order
+	void ExpectNoSkippedTile(const CCollision &Collision, vec2 PrevPos, vec2 Pos)
+	{
+		const auto vSampled = SampledTiles(Collision, PrevPos, Pos);
+		const auto vSwept = SweptTiles(Collision, PrevPos, Pos);
+		size_t Next = 0;
+		for(const int Index : vSampled)
+		{
+			while(Next < vSwept.size() && vSwept[Next] != Index)
+				Next++;
+			EXPECT_LT(Next, vSwept.size()) << "tile " << Index << " skipped from (" << PrevPos.x << ", " << PrevPos.y << ") to (" << Pos.x << ", " << Pos.y << ")";
+		}
+	}
+
+	int TileIndex(int x, int y) { return y * MAP_WIDTH + x; }
+
+	// death tiles everywhere inside the borders, every crossed tile is special
+	class CollisionSweep : public ::testing::Test
+	{
+	protected:
+		CSyntheticWorld m_World{MAP_WIDTH, MAP_HEIGHT, 1, [](CSyntheticMap &Map) {
+			for(int y = 1; y < MAP_HEIGHT - 1; y++)
+			{
+				for(int x = 1; x < MAP_WIDTH - 1; x++)
+					Map.SetTile(x, y, TILE_DEATH);
+			}
+		}};
+		const CCollision &Collision() { return *m_World.Collision(); }
+	};
+
+	struct CSweepCase
+	{
+		const char *m_pName;
+		vec2 m_From;
+		vec2 m_To;
+		std::vector<int> m_vTiles;
+	};
+}
+
+TEST_F(CollisionSweep, Sweep)
+{
+	const CSweepCase aCases[] = {
+		{"zero length", {80, 80}, {80, 80}, {TileIndex(2, 2)}},
+		{"inside one tile", {70, 70}, {90, 90}, {TileIndex(2, 2)}},
+		{"right", {48, 80}, {176, 80}, {TileIndex(1, 2), TileIndex(2, 2), TileIndex(3, 2), TileIndex(4, 2), TileIndex(5, 2)}},
+		{"left", {176, 80}, {48, 80}, {TileIndex(5, 2), TileIndex(4, 2), TileIndex(3, 2), TileIndex(2, 2), TileIndex(1, 2)}},
+		{"down", {80, 48}, {80, 112}, {TileIndex(2, 1), TileIndex(2, 2), TileIndex(2, 3)}},
+		{"up", {80, 112}, {80, 48}, {TileIndex(2, 3), TileIndex(2, 2), TileIndex(2, 1)}},
+		{"from a tile border", {64, 80}, {160, 80}, {TileIndex(2, 2), TileIndex(3, 2), TileIndex(4, 2), TileIndex(5, 2)}},
+		{"shallow diagonal", {40, 40}, {140, 70}, {TileIndex(1, 1), TileIndex(2, 1), TileIndex(3, 1), TileIndex(3, 2), TileIndex(4, 2)}},
+		{"through a corner", {40, 40}, {88, 88}, {TileIndex(1, 1), TileIndex(2, 1), TileIndex(2, 2)}},
+		{"through a corner backwards", {88, 88}, {40, 40}, {TileIndex(2, 2), TileIndex(1, 2), TileIndex(1, 1)}},
+		{"diagonal through corners", {40, 40}, {136, 136}, {TileIndex(1, 1), TileIndex(2, 1), TileIndex(2, 2), TileIndex(3, 2), TileIndex(3, 3), TileIndex(4, 3), TileIndex(4, 4)}},
+	};
+
+	for(const auto &Case : aCases)
+	{
+		EXPECT_EQ(SweptTiles(Collision(), Case.m_From, Case.m_To), Case.m_vTiles) << Case.m_pName;
+		ExpectNoSkippedTile(Collision(), Case.m_From, Case.m_To);
+	}
+}
+
+TEST_F(CollisionSweep, RandomMovesSkipNothing)
+{
+	unsigned State = 2;
+	for(int i = 0; i < 4096; i++)
+	{
+		const vec2 From(32.0f + NextRandom(State) % ((MAP_WIDTH - 2) * 32), 32.0f + NextRandom(State) % ((MAP_HEIGHT - 2) * 32));
+		const vec2 To = From + vec2((int)(NextRandom(State) % 257) - 128, (int)(NextRandom(State) % 257) - 128);
+		ExpectNoSkippedTile(Collision(), From, To);
+
+		// neighbouring tiles only, once each
+		const auto vSwept = SweptTiles(Collision(), From, To);
+		for(size_t t = 1; t < vSwept.size(); t++)
+		{
+			const int Dx = std::abs(vSwept[t] % MAP_WIDTH - vSwept[t - 1] % MAP_WIDTH);
+			const int Dy = std::abs(vSwept[t] / MAP_WIDTH - vSwept[t - 1] / MAP_WIDTH);
+			ASSERT_EQ(Dx + Dy, 1) << "move " << i;
+		}
+	}
+}
+
+TEST_F(CollisionSweep, StopsWhenAsked)
+{
+	int Visited = 0;
+	Collision().ForEachSpecialTile({48, 80}, {176, 80}, [&Visited](int Index) {
+		Visited++;
+		return Index != TileIndex(3, 2);
+	});
+	EXPECT_EQ(Visited, 3);
+}
+
+TEST(Collision, SweepSkipsPlainTiles)
+{
+	// only the death tile needs handling, air and solid ground are skipped
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 1, [](CSyntheticMap &Map) {
+		for(int y = 1; y < MAP_HEIGHT - 1; y++)
+		{
+			for(int x = 1; x < MAP_WIDTH - 1; x++)
+				Map.SetTile(x, y, TILE_AIR);
+		}
+		Map.SetTile(3, 2, TILE_DEATH);
+	});
+	EXPECT_EQ(SweptTiles(*World.Collision(), {48, 80}, {176, 80}), std::vector<int>{TileIndex(3, 2)});
+	EXPECT_TRUE(SweptTiles(*World.Collision(), {48, 48}, {176, 48}).empty());
+	ExpectNoSkippedTile(*World.Collision(), {48, 80}, {176, 80});
+}
@@ -121,3 +121,47 @@ TEST(EventListeners, RecursiveNotify)
     EXPECT_TRUE(listener.onCharacterDamageCalled);
     EXPECT_TRUE(listener.onCharacterDeathCalled);
 }
+
+CEventListenerManager unregisterManager;
+class MockUnregisterListener : public IEventListener
+{
+public:
+    int damageCalls = 0;
+
+    void OnCharacterDamage(int Damage) override
+    {
+        damageCalls++;
+        unregisterManager.UnregisterListener(IEventListener::CharacterDamage, this);
+    }
+};
+
+TEST(EventListeners, UnregisterDuringNotify)
+{
+    MockUnregisterListener listener1;
+    MockUnregisterListener listener2;
+    unregisterManager.RegisterListener(IEventListener::CharacterDamage, &listener1);
+    unregisterManager.RegisterListener(IEventListener::CharacterDamage, &listener2);
+
+    unregisterManager.Notify<IEventListener::CharacterDamage>(10);
+    unregisterManager.Notify<IEventListener::CharacterDamage>(10);
+
+    EXPECT_EQ(listener1.damageCalls, 1);
+    EXPECT_EQ(listener2.damageCalls, 1);
+    EXPECT_EQ(unregisterManager.GetListenersCount(IEventListener::CharacterDamage), 0u);
+}
+
+TEST(EventListeners, Counters)
+{
+    CEventListenerManager manager;
+    MockListener listener;
+
+    manager.RegisterListener(IEventListener::CharacterDamage, &listener);
+    manager.RegisterListener(IEventListener::CharacterDamage, &listener);
+    EXPECT_EQ(manager.GetListenersCount(IEventListener::CharacterDamage), 1u);
+
+    manager.Notify<IEventListener::CharacterDamage>(1);
+    manager.Notify<IEventListener::CharacterDamage>(2);
+    manager.Notify<IEventListener::CharacterDeath>(0);
+    EXPECT_EQ(manager.GetNotifyCount(IEventListener::CharacterDamage), 2u);
+    EXPECT_EQ(manager.GetNotifyCount(IEventListener::CharacterDeath), 1u);
+}
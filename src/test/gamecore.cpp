@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <base/big_int.h>
+#include <game/gamecore.h>
+
+#include <algorithm>
+#include <vector>
+
+static bool Inside(vec2 Pos, vec2 Min, vec2 Max)
+{
+	return Pos.x >= Min.x && Pos.x <= Max.x && Pos.y >= Min.y && Pos.y <= Max.y;
+}
+
+static void CheckQuery(const CWorldCore& World, vec2 Min, vec2 Max)
+{
+	int aIDs[MAX_CLIENTS];
+	const int Num = World.FindCores(Min, Max, aIDs);
+	ASSERT_TRUE(std::is_sorted(aIDs, aIDs + Num));
+	ASSERT_EQ(std::adjacent_find(aIDs, aIDs + Num), aIDs + Num);
+
+	// everything a full scan would accept has to be there
+	for(int i = 0; i < MAX_CLIENTS; i++)
+	{
+		const CCharacterCore* pCore = World.m_apCharacters[i];
+		if(pCore && Inside(pCore->m_Pos, Min, Max))
+		{
+			EXPECT_TRUE(std::binary_search(aIDs, aIDs + Num, i)) << "missing core " << i;
+		}
+	}
+}
+
+TEST(WorldCore, FindCoresMatchesScan)
+{
+	CWorldCore World;
+	std::vector<CCharacterCore> vCores(200);
+	unsigned Seed = 1;
+	auto Random = [&Seed](int Range) {
+		Seed = Seed * 1103515245u + 12345u;
+		return (int)((Seed >> 8) % (unsigned)Range);
+	};
+
+	for(int i = 0; i < (int)vCores.size(); i++)
+	{
+		vCores[i].m_Pos = vec2(Random(4000) - 500, Random(3000) - 500);
+		World.InsertCore(i * 2, &vCores[i]);
+	}
+
+	for(int Step = 0; Step < 2000; Step++)
+	{
+		const int Index = Random((int)vCores.size());
+		CCharacterCore& Core = vCores[Index];
+		switch(Random(4))
+		{
+			case 0:
+				World.RemoveCore(Index * 2);
+				break;
+			case 1:
+				World.InsertCore(Index * 2, &Core);
+				break;
+			default:
+				Core.m_Pos += vec2(Random(200) - 100, Random(200) - 100);
+				World.UpdateCore(&Core);
+				break;
+		}
+
+		const vec2 Center(Random(4000) - 500, Random(3000) - 500);
+		const vec2 Range(Random(300), Random(300));
+		CheckQuery(World, Center - Range, Center + Range);
+	}
+
+	// a box over the whole map falls back to the sorted list of every core
+	CheckQuery(World, vec2(-100000, -100000), vec2(100000, 100000));
+}
+
+TEST(WorldCore, ExternalPositionWrite)
+{
+	// like a ninja dash, the position is written outside of Move and the grid is told afterwards
+	CWorldCore World;
+	std::vector<CCharacterCore> vCores(16);
+	for(int i = 0; i < (int)vCores.size(); i++)
+	{
+		vCores[i].m_Pos = vec2(100.0f + i * 40.0f, 100.0f);
+		World.InsertCore(i, &vCores[i]);
+	}
+
+	CCharacterCore& Core = vCores[5];
+	const vec2 OldPos = Core.m_Pos;
+	for(const vec2 NewPos : { vec2(3000.0f, 2000.0f), vec2(310.0f, 140.0f), vec2(-400.0f, 100.0f) })
+	{
+		Core.m_Pos = NewPos;
+		World.UpdateCore(&Core);
+
+		CheckQuery(World, NewPos - vec2(50.0f, 50.0f), NewPos + vec2(50.0f, 50.0f));
+		CheckQuery(World, OldPos - vec2(50.0f, 50.0f), OldPos + vec2(50.0f, 50.0f));
+		int aIDs[MAX_CLIENTS];
+		const int Num = World.FindCores(NewPos - vec2(1.0f, 1.0f), NewPos + vec2(1.0f, 1.0f), aIDs);
+		EXPECT_TRUE(std::find(aIDs, aIDs + Num, 5) != aIDs + Num);
+	}
+}
+
+TEST(WorldCore, EmptyWorld)
+{
+	CWorldCore World;
+	int aIDs[MAX_CLIENTS];
+	EXPECT_EQ(World.FindCores(vec2(0, 0), vec2(100, 100), aIDs), 0);
+
+	CCharacterCore Core;
+	Core.m_Pos = vec2(50, 50);
+	World.InsertCore(3, &Core);
+	ASSERT_EQ(World.FindCores(vec2(0, 0), vec2(100, 100), aIDs), 1);
+	EXPECT_EQ(aIDs[0], 3);
+
+	World.RemoveCore(3);
+	EXPECT_EQ(World.FindCores(vec2(0, 0), vec2(100, 100), aIDs), 0);
+	EXPECT_EQ(World.m_apCharacters[3], nullptr);
+}
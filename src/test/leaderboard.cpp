@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <game/server/core/tools/leaderboard.h>
+
+#include <vector>
+
+namespace
+{
+	std::vector<int> TopIDs(const CLeaderboard<int>& Board, int Rows)
+	{
+		std::vector<int> vIDs;
+		Board.ForEachTop(Rows, [&](int, int ID, const std::string&, int) { vIDs.push_back(ID); });
+		return vIDs;
+	}
+}
+
+TEST(Leaderboard, OrdersByScore)
+{
+	CLeaderboard<int> Board;
+	Board.Set(1, "one", 100);
+	Board.Set(2, "two", 300);
+	Board.Set(3, "three", 200);
+	Board.Set(4, "four", 200);
+
+	EXPECT_EQ(TopIDs(Board, 10), (std::vector<int> { 2, 3, 4, 1 }));
+	EXPECT_EQ(TopIDs(Board, 2), (std::vector<int> { 2, 3 }));
+}
+
+TEST(Leaderboard, UpdateRenameRemove)
+{
+	CLeaderboard<int> Board;
+	Board.Set(1, "one", 100);
+	Board.Set(2, "two", 300);
+	Board.Set(1, "one", 500);
+	EXPECT_EQ(TopIDs(Board, 10), (std::vector<int> { 1, 2 }));
+	EXPECT_EQ(Board.Size(), 2u);
+
+	Board.Rename(2, "second");
+	Board.Remove(1);
+	Board.ForEachTop(10, [](int Rank, int ID, const std::string& Name, int Score)
+	{
+		EXPECT_EQ(Rank, 1);
+		EXPECT_EQ(ID, 2);
+		EXPECT_EQ(Name, "second");
+		EXPECT_EQ(Score, 300);
+	});
+	EXPECT_EQ(Board.Size(), 1u);
+}
+
+TEST(Leaderboard, SetKeepsRenamedName)
+{
+	// saves pass a possibly stale name, only a rename changes it
+	CLeaderboard<int> Board;
+	Board.Set(1, "old", 100);
+	Board.Rename(1, "new");
+	Board.Set(1, "old", 200);
+	Board.ForEachTop(10, [](int Rank, int ID, const std::string& Name, int Score)
+	{
+		EXPECT_EQ(Name, "new");
+		EXPECT_EQ(Score, 200);
+	});
+}
+
+TEST(Leaderboard, PairScore)
+{
+	CLeaderboard<std::pair<int, uint64_t>> Board;
+	Board.Set(1, "a", { 2, 10 });
+	Board.Set(2, "b", { 2, 50 });
+	Board.Set(3, "c", { 3, 0 });
+
+	std::vector<int> vIDs;
+	Board.ForEachTop(3, [&](int, int ID, const std::string&, const std::pair<int, uint64_t>&) { vIDs.push_back(ID); });
+	EXPECT_EQ(vIDs, (std::vector<int> { 3, 2, 1 }));
+}
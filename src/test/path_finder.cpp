@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <benchmark/synthetic_map.h>
+#include <engine/server/tick_profiler.h>
+#include <game/server/core/tools/path_finder.h>
+
+namespace
+{
+	constexpr int MAP_WIDTH = 80;
+	constexpr int MAP_HEIGHT = 50;
+	constexpr int NUM_ROUTES = 64;
+
+	std::vector<vec2> WaitForPath(CPathFinder &PathFinder, bool Flow, vec2 Start, vec2 End)
+	{
+		PathRequestHandle Handle;
+		if(Flow)
+			PathFinder.RequestFlowPath(Handle, Start, End);
+		else
+			PathFinder.RequestPath(Handle, Start, End);
+		Handle.Future.wait();
+		Handle.TryGetPath();
+		return Handle.vPath;
+	}
+
+	// every step goes to a neighbour tile or through the teleport it stands on
+	void ExpectWalkable(CSyntheticWorld &World, const std::vector<vec2> &vPath)
+	{
+		for(size_t i = 1; i < vPath.size(); i++)
+		{
+			const vec2 Delta = vPath[i] - vPath[i - 1];
+			const bool Neighbour = std::abs(Delta.x) + std::abs(Delta.y) == 32.0f;
+			const auto Teleport = World.Collision()->TryGetTeleportOut(vPath[i - 1]);
+			EXPECT_TRUE(Neighbour || (Teleport && *Teleport == vPath[i])) << "step " << i;
+			EXPECT_FALSE(World.Collision()->CheckPoint(vPath[i])) << "step " << i;
+		}
+	}
+
+	// free tele pair from (x1, y1) to (x2, y2)
+	void AddTeleport(CSyntheticMap &Map, int Number, int x1, int y1, int x2, int y2)
+	{
+		Map.SetTile(x1, y1, TILE_AIR);
+		Map.SetTile(x2, y2, TILE_AIR);
+		Map.SetTele(x1, y1, TILE_TELE_FROM, Number);
+		Map.SetTele(x2, y2, TILE_TELE_OUT, Number);
+	}
+}
+
+TEST(PathFinder, FlowPathAsShortAsPath)
+{
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 11);
+	CTickProfiler Profiler;
+	Profiler.AddWorld(0);
+	CPathFinder PathFinder(World.Collision(), &Profiler, 0);
+
+	unsigned State = 12;
+	const vec2 Target = World.RandomFreePos(State);
+	for(int i = 0; i < NUM_ROUTES; i++)
+	{
+		const vec2 Start = World.RandomFreePos(State);
+		const auto vPath = WaitForPath(PathFinder, false, Start, Target);
+		const auto vFlowPath = WaitForPath(PathFinder, true, Start, Target);
+		EXPECT_EQ(vFlowPath.size(), vPath.size()) << "route " << i;
+		ExpectWalkable(World, vFlowPath);
+	}
+}
+
+TEST(PathFinder, FlowPathAcrossTeleports)
+{
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 13, [](CSyntheticMap &Map) {
+		AddTeleport(Map, 1, 5, 5, MAP_WIDTH - 6, MAP_HEIGHT - 6);
+		AddTeleport(Map, 2, MAP_WIDTH - 6, 5, 5, MAP_HEIGHT - 6);
+		AddTeleport(Map, 3, MAP_WIDTH / 2, 3, MAP_WIDTH / 2, MAP_HEIGHT - 4);
+	});
+	CTickProfiler Profiler;
+	Profiler.AddWorld(0);
+	CPathFinder PathFinder(World.Collision(), &Profiler, 0);
+
+	// the distance heuristic of FindPath does not know teleports, the flow path is never longer
+	unsigned State = 14;
+	for(const vec2 Target : { World.RandomFreePos(State), World.RandomFreePos(State) })
+	{
+		for(int i = 0; i < NUM_ROUTES; i++)
+		{
+			const vec2 Start = World.RandomFreePos(State);
+			const auto vPath = WaitForPath(PathFinder, false, Start, Target);
+			const auto vFlowPath = WaitForPath(PathFinder, true, Start, Target);
+			EXPECT_EQ(vFlowPath.empty(), vPath.empty()) << "route " << i;
+			EXPECT_LE(vFlowPath.size(), vPath.size()) << "route " << i;
+			ExpectWalkable(World, vFlowPath);
+		}
+	}
+}
+
+TEST(PathFinder, FlowPathThroughTeleportOnly)
+{
+	// a wall splits the map, only the teleport leads to the right half
+	CSyntheticWorld World(MAP_WIDTH, MAP_HEIGHT, 15, [](CSyntheticMap &Map) {
+		for(int y = 1; y < MAP_HEIGHT - 1; y++)
+		{
+			for(int x = 1; x < MAP_WIDTH - 1; x++)
+				Map.SetTile(x, y, x == MAP_WIDTH / 2 ? TILE_SOLID : TILE_AIR);
+		}
+		AddTeleport(Map, 1, 10, 10, MAP_WIDTH - 10, MAP_HEIGHT - 10);
+	});
+	CTickProfiler Profiler;
+	Profiler.AddWorld(0);
+	CPathFinder PathFinder(World.Collision(), &Profiler, 0);
+
+	const vec2 Start(3 * 32.0f + 16.0f, 3 * 32.0f + 16.0f);
+	const vec2 End((MAP_WIDTH - 3) * 32.0f + 16.0f, 3 * 32.0f + 16.0f);
+	const auto vPath = WaitForPath(PathFinder, false, Start, End);
+	const auto vFlowPath = WaitForPath(PathFinder, true, Start, End);
+	ASSERT_FALSE(vFlowPath.empty());
+	EXPECT_EQ(vFlowPath.size(), vPath.size());
+	EXPECT_EQ(vFlowPath.front(), Start);
+	EXPECT_EQ(vFlowPath.back(), End);
+	ExpectWalkable(World, vFlowPath);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <base/system.h>
+#include <engine/shared/snapshot.h>
+
+static void FillSnap(char *pBuf, int Size, int Tick)
+{
+	for(int i = 0; i < Size; i++)
+		pBuf[i] = (char)(Tick + i);
+}
+
+static bool CheckSnap(const CSnapshot *pSnap, int Size, int Tick)
+{
+	const char *pBuf = (const char *)pSnap;
+	for(int i = 0; i < Size; i++)
+	{
+		if(pBuf[i] != (char)(Tick + i))
+			return false;
+	}
+	return true;
+}
+
+TEST(SnapshotStorage, AddGetPurge)
+{
+	CSnapshotStorage Storage;
+	char aBuf[256];
+	for(int Tick = 10; Tick < 20; Tick++)
+	{
+		FillSnap(aBuf, 64 + Tick, Tick);
+		Storage.Add(Tick, Tick * 100, 64 + Tick, aBuf, 0, nullptr);
+	}
+	EXPECT_EQ(Storage.NumSnapshots(), 10);
+
+	int64_t Tagtime = 0;
+	const CSnapshot *pSnap = nullptr;
+	const CSnapshot *pAltSnap = nullptr;
+	EXPECT_EQ(Storage.Get(15, &Tagtime, &pSnap, &pAltSnap), 79);
+	EXPECT_EQ(Tagtime, 1500);
+	EXPECT_TRUE(CheckSnap(pSnap, 79, 15));
+	EXPECT_EQ(pAltSnap, nullptr);
+	EXPECT_EQ(Storage.Get(9, nullptr, nullptr, nullptr), -1);
+	EXPECT_EQ(Storage.Get(20, nullptr, nullptr, nullptr), -1);
+
+	Storage.PurgeUntil(15);
+	EXPECT_EQ(Storage.NumSnapshots(), 5);
+	EXPECT_EQ(Storage.Get(14, nullptr, nullptr, nullptr), -1);
+	EXPECT_EQ(Storage.Get(15, nullptr, &pSnap, nullptr), 79);
+	EXPECT_TRUE(CheckSnap(pSnap, 79, 15));
+
+	Storage.PurgeAll();
+	EXPECT_EQ(Storage.NumSnapshots(), 0);
+	EXPECT_EQ(Storage.Get(15, nullptr, nullptr, nullptr), -1);
+}
+
+TEST(SnapshotStorage, GapsAndAltSnap)
+{
+	CSnapshotStorage Storage;
+	char aBuf[128];
+	char aAlt[32];
+	for(int Tick = 0; Tick < 40; Tick += 3)
+	{
+		FillSnap(aBuf, 100, Tick);
+		FillSnap(aAlt, 20, Tick + 1);
+		Storage.Add(Tick, 0, 100, aBuf, 20, aAlt);
+	}
+
+	const CSnapshot *pSnap = nullptr;
+	const CSnapshot *pAltSnap = nullptr;
+	EXPECT_EQ(Storage.Get(10, nullptr, nullptr, nullptr), -1);
+	ASSERT_EQ(Storage.Get(12, nullptr, &pSnap, &pAltSnap), 100);
+	EXPECT_TRUE(CheckSnap(pSnap, 100, 12));
+	EXPECT_TRUE(CheckSnap(pAltSnap, 20, 13));
+
+	Storage.PurgeUntil(13);
+	EXPECT_EQ(Storage.Get(12, nullptr, nullptr, nullptr), -1);
+	EXPECT_EQ(Storage.Get(15, nullptr, &pSnap, nullptr), 100);
+	EXPECT_TRUE(CheckSnap(pSnap, 100, 15));
+}
+
+TEST(SnapshotStorage, SteadyStateReusesBuffer)
+{
+	CSnapshotStorage Storage;
+	char aBuf[1024];
+	int Capacity = 0;
+	for(int Tick = 0; Tick < 2000; Tick++)
+	{
+		// sizes vary so the ring wraps at different offsets
+		const int Size = 256 + (Tick * 37) % 700;
+		Storage.PurgeUntil(Tick - 150);
+		FillSnap(aBuf, Size, Tick);
+		Storage.Add(Tick, Tick, Size, aBuf, 0, nullptr);
+
+		const CSnapshot *pSnap = nullptr;
+		const int Old = Tick - 100;
+		if(Old >= 0)
+		{
+			const int OldSize = 256 + (Old * 37) % 700;
+			ASSERT_EQ(Storage.Get(Old, nullptr, &pSnap, nullptr), OldSize);
+			ASSERT_TRUE(CheckSnap(pSnap, OldSize, Old));
+		}
+
+		if(Tick == 1000)
+			Capacity = Storage.DataCapacity();
+	}
+
+	// no growth once the window is filled
+	EXPECT_EQ(Storage.DataCapacity(), Capacity);
+	EXPECT_EQ(Storage.NumSnapshots(), 151);
+}
+
+TEST(SnapshotStorage, DropsOutsideRing)
+{
+	CSnapshotStorage Storage;
+	char aBuf[16] = {};
+	for(int Tick = 0; Tick < CSnapshotStorage::MAX_TICKS + 10; Tick++)
+		Storage.Add(Tick, 0, sizeof(aBuf), aBuf, 0, nullptr);
+
+	EXPECT_EQ(Storage.NumSnapshots(), (int)CSnapshotStorage::MAX_TICKS);
+	EXPECT_EQ(Storage.Get(9, nullptr, nullptr, nullptr), -1);
+	EXPECT_EQ(Storage.Get(10, nullptr, nullptr, nullptr), (int)sizeof(aBuf));
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <engine/server/snapshot_ids_pool.h>
+
+#include <set>
+#include <vector>
+
+namespace
+{
+	// later than the reuse delay of freed blocks
+	int64_t AfterTimeout(int64_t Now) { return Now + time_freq() * 6; }
+}
+
+TEST(SnapIDPool, BlocksDoNotOverlap)
+{
+	CSnapIDPool Pool;
+	std::set<int> Used;
+	for(int Num : { 1, 3, 4, 7, 12, 1, 2 })
+	{
+		const int First = Pool.NewIDs(Num, 0);
+		ASSERT_GE(First, 0);
+		for(int i = 0; i < Num; i++)
+			EXPECT_TRUE(Used.insert(First + i).second);
+	}
+	EXPECT_EQ(Pool.InUsage(), 30);
+}
+
+TEST(SnapIDPool, InvalidSizes)
+{
+	CSnapIDPool Pool;
+	EXPECT_EQ(Pool.NewIDs(0, 0), -1);
+	EXPECT_EQ(Pool.NewIDs(CSnapIDPool::MAX_BLOCK_IDS + 1, 0), -1);
+	EXPECT_GE(Pool.NewIDs(CSnapIDPool::MAX_BLOCK_IDS, 0), 0);
+}
+
+TEST(SnapIDPool, FreedBlocksWaitBeforeReuse)
+{
+	CSnapIDPool Pool;
+	const int First = Pool.NewIDs(4, 0);
+	Pool.FreeIDs(First, 4, 0);
+	EXPECT_EQ(Pool.InUsage(), 0);
+
+	// still in older snapshots of clients
+	EXPECT_NE(Pool.NewIDs(4, 1), First);
+	EXPECT_EQ(Pool.NewIDs(4, AfterTimeout(0)), First);
+}
+
+TEST(SnapIDPool, Exhaustion)
+{
+	CSnapIDPool Pool;
+	std::vector<int> vBlocks;
+	for(int i = 0; i < CSnapIDPool::MAX_IDS / CSnapIDPool::MAX_BLOCK_IDS; i++)
+		vBlocks.push_back(Pool.NewIDs(CSnapIDPool::MAX_BLOCK_IDS, 0));
+	for(int First : vBlocks)
+		EXPECT_GE(First, 0);
+
+	EXPECT_EQ(Pool.NewIDs(1, 0), -1);
+	EXPECT_EQ(Pool.InUsage(), CSnapIDPool::MAX_IDS);
+
+	// a freed big block serves small requests after the delay
+	Pool.FreeIDs(vBlocks.back(), CSnapIDPool::MAX_BLOCK_IDS, 0);
+	EXPECT_EQ(Pool.NewIDs(1, 0), -1);
+	const int First = Pool.NewIDs(1, AfterTimeout(0));
+	EXPECT_GE(First, vBlocks.back());
+	EXPECT_LT(First, vBlocks.back() + CSnapIDPool::MAX_BLOCK_IDS);
+}
+
+TEST(SnapIDPool, SmallFreedBlocksMergeForBigRequests)
+{
+	CSnapIDPool Pool;
+	std::vector<int> vIDs;
+	for(int i = 0; i < CSnapIDPool::MAX_IDS; i++)
+		vIDs.push_back(Pool.NewIDs(1, 0));
+	EXPECT_EQ(Pool.NewIDs(1, 0), -1);
+
+	// free single ids in a region, the big request needs them merged
+	const int Start = 1024;
+	for(int i = Start; i < Start + CSnapIDPool::MAX_BLOCK_IDS; i++)
+		Pool.FreeIDs(vIDs[i], 1, 0);
+
+	EXPECT_EQ(Pool.NewIDs(CSnapIDPool::MAX_BLOCK_IDS, 0), -1);
+	EXPECT_EQ(Pool.NewIDs(CSnapIDPool::MAX_BLOCK_IDS, AfterTimeout(0)), vIDs[Start]);
+	EXPECT_EQ(Pool.InUsage(), CSnapIDPool::MAX_IDS);
+}
+
+TEST(SnapIDPool, MixedSizesDoNotStarve)
+{
+	CSnapIDPool Pool;
+	int64_t Now = 0;
+	for(int Round = 0; Round < 8; Round++)
+	{
+		// fill with mixed sizes, then free everything
+		std::vector<std::pair<int, int>> vBlocks;
+		for(int Num = 1; ; Num = Num % 9 + 1)
+		{
+			const int First = Pool.NewIDs(Num, Now);
+			if(First < 0)
+				break;
+			vBlocks.emplace_back(First, Num);
+		}
+		for(const auto& [First, Num] : vBlocks)
+			Pool.FreeIDs(First, Num, Now);
+		Now = AfterTimeout(Now);
+
+		ASSERT_EQ(Pool.InUsage(), 0);
+		const int First = Pool.NewIDs(CSnapIDPool::MAX_BLOCK_IDS, Now);
+		ASSERT_GE(First, 0);
+		Pool.FreeIDs(First, CSnapIDPool::MAX_BLOCK_IDS, Now);
+	}
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <engine/server/sqlite3/sqlite_handler.h>
+
+namespace
+{
+	struct CTranslateCase
+	{
+		const char *m_pName;
+		const char *m_pQuery;
+		const char *m_pExpected;
+	};
+
+	void ExpectTranslations(std::initializer_list<CTranslateCase> Cases)
+	{
+		for(const auto &Case : Cases)
+			EXPECT_EQ(sqlitedb::Handler::TranslateQuery(Case.m_pQuery), Case.m_pExpected) << Case.m_pName;
+	}
+
+	// phpMyAdmin export with the keys added after the rows
+	constexpr const char *DUMP = R"(-- phpMyAdmin SQL Dump
+-- Server version: 10.6
+/*!40101 SET @OLD_CHARACTER_SET_CLIENT=@@CHARACTER_SET_CLIENT */;
+SET SQL_MODE = "NO_AUTO_VALUE_ON_ZERO";
+START TRANSACTION;
+
+/* accounts; one row per player */
+CREATE TABLE `tw_accounts` (
+  `ID` int(11) NOT NULL,
+  `Username` varchar(64) CHARACTER SET utf8mb4 COLLATE utf8mb4_general_ci NOT NULL COMMENT 'login; name',
+  `Password` varchar(64) COLLATE utf8mb4_bin NOT NULL,
+  `Level` int(11) unsigned NOT NULL DEFAULT '1',
+  `Class` enum('Tank','Healer','DPS') NOT NULL DEFAULT 'Tank',
+  `Updated` timestamp NOT NULL DEFAULT current_timestamp() ON UPDATE current_timestamp()
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_general_ci;
+
+INSERT INTO `tw_accounts` (`ID`, `Username`, `Password`, `Level`, `Class`, `Updated`) VALUES
+(1, 'kurosio', 'Secret', 5, 'Tank', '2024-01-01 00:00:00'),
+(2, 'it\'s; me', 'back\\slash', 1, 'DPS', '2024-01-01 00:00:00'),
+(3, "double ""quoted""", '-- not a comment', 2, 'Healer', '2024-01-01 00:00:00');
+
+CREATE TABLE `tw_accounts_items` (
+  `ID` int(11) NOT NULL,
+  `UserID` int(11) NOT NULL,
+  `ItemID` int(11) NOT NULL
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+INSERT INTO `tw_accounts_items` (`ID`, `UserID`, `ItemID`) VALUES
+(1, 1, 10),
+(2, 2, 20);
+
+ALTER TABLE `tw_accounts`
+  ADD PRIMARY KEY (`ID`),
+  ADD UNIQUE KEY `Username` (`Username`);
+
+ALTER TABLE `tw_accounts_items`
+  ADD PRIMARY KEY (`ID`),
+  ADD KEY `UserID` (`UserID`);
+
+ALTER TABLE `tw_accounts`
+  MODIFY `ID` int(11) NOT NULL AUTO_INCREMENT, AUTO_INCREMENT=4;
+
+ALTER TABLE `tw_accounts_items`
+  ADD CONSTRAINT `tw_accounts_items_ibfk_1` FOREIGN KEY (`UserID`) REFERENCES `tw_accounts` (`ID`) ON DELETE CASCADE ON UPDATE CASCADE;
+COMMIT;
+)";
+
+	class SqliteImport : public ::testing::Test
+	{
+	protected:
+		sqlitedb::Handler m_Handler{":memory:"};
+
+		void SetUp() override
+		{
+			ASSERT_TRUE(m_Handler.IsOpen());
+			ASSERT_TRUE(m_Handler.ImportMySqlDump(DUMP));
+		}
+
+		// the single value of a query, empty if there is no row
+		std::string Value(const std::string &Query, const char *pColumn)
+		{
+			const auto pResult = m_Handler.Select(Query);
+			EXPECT_TRUE(pResult) << Query << ": " << m_Handler.GetError();
+			return pResult && pResult->next() ? pResult->getString(pColumn) : std::string();
+		}
+	};
+}
+
+TEST(SqliteTranslate, Upsert)
+{
+	ExpectTranslations({
+		{"values", "INSERT INTO t (a, b) VALUES (1, 2) ON DUPLICATE KEY UPDATE b = VALUES(b)",
+			"INSERT INTO t (a, b) VALUES (1, 2) ON CONFLICT DO UPDATE SET b = excluded.b"},
+		{"spaced and lower case", "insert into t (a) values (1) on  duplicate\nkey update a = values( a )",
+			"insert into t (a) values (1) ON CONFLICT DO UPDATE SET a = excluded.a"},
+		{"select without where", "INSERT INTO t (a) SELECT a FROM u ON DUPLICATE KEY UPDATE a = a + 1",
+			"INSERT INTO t (a) SELECT a FROM u WHERE true ON CONFLICT DO UPDATE SET a = a + 1"},
+		{"select with where", "INSERT INTO t (a) SELECT a FROM u WHERE a > 1 ON DUPLICATE KEY UPDATE a = a + 1",
+			"INSERT INTO t (a) SELECT a FROM u WHERE a > 1 ON CONFLICT DO UPDATE SET a = a + 1"},
+		{"where only in a subquery", "INSERT INTO t (a) SELECT (SELECT MAX(b) FROM v WHERE b > 0) FROM u ON DUPLICATE KEY UPDATE a = 1",
+			"INSERT INTO t (a) SELECT (SELECT MAX(b) FROM v WHERE b > 0) FROM u WHERE true ON CONFLICT DO UPDATE SET a = 1"},
+		{"subquery without where", "INSERT INTO t (a) SELECT a FROM u WHERE a IN (SELECT b FROM v) ON DUPLICATE KEY UPDATE a = 1",
+			"INSERT INTO t (a) SELECT a FROM u WHERE a IN (SELECT b FROM v) ON CONFLICT DO UPDATE SET a = 1"},
+		{"values without upsert", "INSERT INTO t VALUES (1)", "INSERT INTO t VALUES (1)"},
+		{"ignore", "INSERT IGNORE INTO t (a) VALUES (1)", "INSERT OR IGNORE INTO t (a) VALUES (1)"},
+	});
+}
+
+TEST(SqliteTranslate, Functions)
+{
+	ExpectTranslations({
+		{"if", "SELECT IF(a > 1, 'x', 'y') FROM t", "SELECT IIF(a > 1, 'x', 'y') FROM t"},
+		{"if with space", "SELECT if (a, 1, 2) FROM t", "SELECT IIF (a, 1, 2) FROM t"},
+		{"if in a longer word", "SELECT IFNULL(a, 0), NotIF FROM t", "SELECT IFNULL(a, 0), NotIF FROM t"},
+		{"greatest", "UPDATE t SET a = GREATEST(a - 5, 0)", "UPDATE t SET a = MAX(a - 5, 0)"},
+		{"least", "UPDATE t SET a = least(a + 5, 100)", "UPDATE t SET a = MIN(a + 5, 100)"},
+		{"column named like a function", "SELECT Greatest, `LEAST` FROM t", "SELECT Greatest, `LEAST` FROM t"},
+		{"current timestamp", "UPDATE t SET d = CURRENT_TIMESTAMP()", "UPDATE t SET d = CURRENT_TIMESTAMP"},
+		{"inside a literal", "SELECT 'IF(GREATEST(1))' FROM t", "SELECT 'IF(GREATEST(1))' FROM t"},
+	});
+}
+
+TEST(SqliteTranslate, Literals)
+{
+	ExpectTranslations({
+		{"quoted int", "SELECT * FROM t WHERE ID = '42'", "SELECT * FROM t WHERE ID = 42"},
+		{"quoted negative int", "UPDATE t SET a = '-7'", "UPDATE t SET a = -7"},
+		{"quoted zero", "UPDATE t SET a = '0'", "UPDATE t SET a = 0"},
+		{"leading zero stays text", "UPDATE t SET a = '007'", "UPDATE t SET a = '007'"},
+		{"negative zero stays text", "UPDATE t SET a = '-0'", "UPDATE t SET a = '-0'"},
+		{"too long for int64 stays text", "UPDATE t SET a = '1234567890123456789'", "UPDATE t SET a = '1234567890123456789'"},
+		{"not a number", "UPDATE t SET a = '12a'", "UPDATE t SET a = '12a'"},
+		{"empty", "UPDATE t SET a = ''", "UPDATE t SET a = ''"},
+		{"escaped quote", "UPDATE t SET a = 'it\\'s'", "UPDATE t SET a = 'it''s'"},
+		{"doubled quote", "UPDATE t SET a = 'it''s'", "UPDATE t SET a = 'it''s'"},
+		{"escaped backslash", "UPDATE t SET a = 'a\\\\b'", "UPDATE t SET a = 'a\\b'"},
+		{"escaped newline", "UPDATE t SET a = 'a\\nb'", "UPDATE t SET a = 'a\nb'"},
+		{"double quotes", "UPDATE t SET a = \"say 'hi'\"", "UPDATE t SET a = 'say ''hi'''"},
+		{"backticks", "SELECT `Name` FROM `tw_accounts` WHERE `ID` = '1'", "SELECT `Name` FROM `tw_accounts` WHERE `ID` = 1"},
+	});
+}
+
+TEST_F(SqliteImport, Rows)
+{
+	EXPECT_EQ(Value("SELECT COUNT(*) AS Num FROM tw_accounts", "Num"), "3");
+	EXPECT_EQ(Value("SELECT Username FROM tw_accounts WHERE ID = 2", "Username"), "it's; me");
+	EXPECT_EQ(Value("SELECT Password FROM tw_accounts WHERE ID = 2", "Password"), "back\\slash");
+	EXPECT_EQ(Value("SELECT Username FROM tw_accounts WHERE ID = 3", "Username"), "double \"quoted\"");
+	EXPECT_EQ(Value("SELECT Password FROM tw_accounts WHERE ID = 3", "Password"), "-- not a comment");
+	EXPECT_EQ(Value("SELECT Class FROM tw_accounts WHERE ID = 3", "Class"), "Healer");
+	EXPECT_EQ(Value("SELECT COUNT(*) AS Num FROM tw_accounts_items", "Num"), "2");
+}
+
+TEST_F(SqliteImport, CollateNocase)
+{
+	// MySQL compares text case-insensitively unless the collation is binary
+	EXPECT_EQ(Value("SELECT ID FROM tw_accounts WHERE Username = 'KUROSIO'", "ID"), "1");
+	EXPECT_EQ(Value("SELECT ID FROM tw_accounts WHERE Password = 'secret'", "ID"), "");
+	EXPECT_EQ(Value("SELECT ID FROM tw_accounts WHERE Password = 'Secret'", "ID"), "1");
+
+	// and so does the unique key
+	EXPECT_EQ(m_Handler.Execute("INSERT INTO tw_accounts (Username, Password) VALUES ('KuroSio', 'x')"), -1);
+}
+
+TEST_F(SqliteImport, Keys)
+{
+	// the integer primary key counts up like AUTO_INCREMENT
+	ASSERT_EQ(m_Handler.Execute("INSERT INTO tw_accounts (Username, Password) VALUES ('new', 'x')"), 1);
+	EXPECT_EQ(Value("SELECT ID FROM tw_accounts WHERE Username = 'new'", "ID"), "4");
+	EXPECT_EQ(Value("SELECT Level FROM tw_accounts WHERE Username = 'new'", "Level"), "1");
+
+	// the upsert conflicts on the imported primary key
+	ASSERT_EQ(m_Handler.Execute("INSERT INTO tw_accounts (ID, Username, Password, Level) VALUES ('1', 'kurosio', 'x', '7') "
+		"ON DUPLICATE KEY UPDATE Level = GREATEST(Level, VALUES(Level))"), 1);
+	EXPECT_EQ(Value("SELECT Level FROM tw_accounts WHERE ID = 1", "Level"), "7");
+
+	// the foreign key added by ALTER TABLE cascades
+	ASSERT_EQ(m_Handler.Execute("DELETE FROM tw_accounts WHERE ID = 1"), 2);
+	EXPECT_EQ(Value("SELECT COUNT(*) AS Num FROM tw_accounts_items", "Num"), "1");
+}
+
+TEST(SqliteImportFailure, RollsBack)
+{
+	sqlitedb::Handler Handler(":memory:");
+	ASSERT_TRUE(Handler.IsOpen());
+	EXPECT_FALSE(Handler.ImportMySqlDump("CREATE TABLE `a` (`ID` int(11) NOT NULL);\nINSERT INTO `missing` (`ID`) VALUES (1);"));
+	EXPECT_FALSE(Handler.HasTables());
+}